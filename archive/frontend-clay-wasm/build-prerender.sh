@@ -0,0 +1,19 @@
+#!/bin/bash
+set -e
+
+cd "$(dirname "$0")"
+
+# Only the prerender.h API is exported; the UI's own symbols stay hidden.
+cc \
+  -O2 \
+  -std=c11 \
+  -fPIC \
+  -fvisibility=hidden \
+  -c prerender.c \
+  -o prerender.o
+
+ar rcs libtxxt_prerender.a prerender.o
+cc -shared -o libtxxt_prerender.so prerender.o -lm
+rm prerender.o
+
+echo "Built libtxxt_prerender.a and libtxxt_prerender.so ($(stat -c%s libtxxt_prerender.so) bytes)"
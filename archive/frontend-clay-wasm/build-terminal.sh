@@ -0,0 +1,13 @@
+#!/bin/bash
+set -e
+
+cd "$(dirname "$0")"
+
+cc \
+  -O2 \
+  -std=c11 \
+  -o txxt-term \
+  terminal.c \
+  -lm
+
+echo "Built txxt-term ($(stat -c%s txxt-term) bytes)"
@@ -7,13 +7,14 @@ clang \
   -Os \
   -DCLAY_WASM \
   -mbulk-memory \
+  -msimd128 \
   --target=wasm32 \
   -nostdlib \
   -Wl,--strip-all \
   -Wl,--export-dynamic \
   -Wl,--no-entry \
   -Wl,--export=__heap_base \
-  -Wl,--initial-memory=6553600 \
+  -Wl,--initial-memory=12320768 \
   -o dist/app.wasm \
   main.c
 
@@ -668,6 +668,52 @@ typedef struct Clay_ElementData {
     bool found;
 } Clay_ElementData;
 
+// The render commands generated for a specific UI element and all of its descendants.
+typedef struct Clay_ElementRenderRange {
+    // Index of the first render command belonging to the element.
+    int32_t start;
+    // One past the index of the last render command belonging to the element. Equal to start if nothing was rendered.
+    int32_t end;
+    // Indicates whether the element was declared in the most recent layout.
+    bool found;
+} Clay_ElementRenderRange;
+
+// What one UI element cost the most recent layout, recorded while element cost profiling is enabled.
+// Each metric comes as the element's own share and as the total for the element and its descendants.
+typedef struct Clay_ElementCost {
+    // The element's ID. Text elements have an ID derived from their parent's, with an empty stringId.
+    Clay_ElementId elementId;
+    // The element's final bounding box. Zero if the layout never positioned it.
+    Clay_BoundingBox boundingBox;
+    // Row of the parent element in the same table, or -1 for roots (floating elements are roots).
+    int32_t parentIndex;
+    // Number of elements below this one in the tree, not counting floating elements.
+    int32_t descendantCount;
+    // Render commands generated for the element.
+    int32_t renderCommandCount;
+    int32_t subtreeRenderCommandCount;
+    // Lines the element's text was wrapped into.
+    int32_t wrappedLineCount;
+    int32_t subtreeWrappedLineCount;
+    // Text measurements that missed the measure cache and called the measure text function.
+    int32_t measureCacheMisses;
+    int32_t subtreeMeasureCacheMisses;
+    // Milliseconds spent measuring and wrapping the element's text, and sizing its children.
+    // Always zero without a profiling clock, see Clay_SetProfilingClockFunction().
+    float sizingMs;
+    float subtreeSizingMs;
+} Clay_ElementCost;
+
+// A sized array of element costs.
+typedef struct Clay_ElementCostArray {
+    // The underlying max capacity of the array, not necessarily all initialized.
+    int32_t capacity;
+    // The number of initialized elements in this array. Used for loops and iteration.
+    int32_t length;
+    // A pointer to the first element in the internal array.
+    Clay_ElementCost* internalArray;
+} Clay_ElementCostArray;
+
 // Used by renderers to determine specific handling for each render command.
 typedef CLAY_PACKED_ENUM {
     // This command type should be skipped.
@@ -873,6 +919,18 @@ CLAY_DLL_EXPORT Clay_ElementId Clay_GetElementIdWithIndex(Clay_String idString,
 // The returned Clay_ElementData contains a `found` bool that will be true if an element with the provided ID was found.
 // This ID can be calculated either with CLAY_ID() for string literal IDs, or Clay_GetElementId for dynamic strings.
 CLAY_DLL_EXPORT Clay_ElementData Clay_GetElementData(Clay_ElementId id);
+// Returns the range of indexes into the render command array returned by the most recent Clay_EndLayout()
+// that were generated by the element with the given ID and its descendants, in order.
+// Commands for floating children attached to the element are not included, as they are generated with their own root.
+CLAY_DLL_EXPORT Clay_ElementRenderRange Clay_GetElementRenderRange(Clay_ElementId id);
+// Enables and disables per-element cost profiling. While enabled, Clay_EndLayout() attributes render commands, wrapped
+// text lines, measure cache misses and sizing time to the elements that caused them, see Clay_GetElementCosts().
+// This state is retained and does not need to be set each frame.
+CLAY_DLL_EXPORT void Clay_SetElementCostProfilingEnabled(bool enabled);
+// Returns the per-element cost table of the most recent Clay_EndLayout(), one row per layout element in declaration
+// order, so a parent's row always comes before its children's. Empty if profiling was disabled for that layout.
+// Valid until the next Clay_BeginLayout().
+CLAY_DLL_EXPORT Clay_ElementCostArray Clay_GetElementCosts(void);
 // Returns true if the pointer position provided by Clay_SetPointerState is within the current element's bounding box.
 // Works during element declaration, e.g. CLAY({ .backgroundColor = Clay_Hovered() ? BLUE : RED });
 CLAY_DLL_EXPORT bool Clay_Hovered(void);
@@ -897,6 +955,10 @@ CLAY_DLL_EXPORT void Clay_SetMeasureTextFunction(Clay_Dimensions (*measureTextFu
 // Experimental - Used in cases where Clay needs to integrate with a system that manages its own scrolling containers externally.
 // Please reach out if you plan to use this function, as it may be subject to change.
 CLAY_DLL_EXPORT void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)(uint32_t elementId, void *userData), void *userData);
+// Binds the clock used to time element sizing while element cost profiling is enabled.
+// - profilingClockFunction returns the current time in milliseconds, from any fixed origin.
+// - userData is a pointer that will be transparently passed through when the profilingClockFunction is called.
+CLAY_DLL_EXPORT void Clay_SetProfilingClockFunction(double (*profilingClockFunction)(void *userData), void *userData);
 // A bounds-checked "get" function for the Clay_RenderCommandArray returned from Clay_EndLayout().
 CLAY_DLL_EXPORT Clay_RenderCommand * Clay_RenderCommandArray_Get(Clay_RenderCommandArray* array, int32_t index);
 // Enables and disables Clay's internal debug tools.
@@ -1084,6 +1146,7 @@ CLAY__ARRAY_DEFINE(Clay_BorderElementConfig, Clay__BorderElementConfigArray)
 CLAY__ARRAY_DEFINE(Clay_String, Clay__StringArray)
 CLAY__ARRAY_DEFINE(Clay_SharedElementConfig, Clay__SharedElementConfigArray)
 CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_RenderCommand, Clay_RenderCommandArray)
+CLAY__ARRAY_DEFINE_FUNCTIONS(Clay_ElementCost, Clay_ElementCostArray)
 
 typedef CLAY_PACKED_ENUM {
     CLAY__ELEMENT_CONFIG_TYPE_NONE,
@@ -1127,6 +1190,9 @@ typedef struct {
     Clay_Dimensions preferredDimensions;
     int32_t elementIndex;
     Clay__WrappedTextLineArraySlice wrappedLines;
+    // Element cost profiling: measuring done when the element was declared.
+    int32_t measureCacheMisses;
+    float measureMs;
 } Clay__TextElementData;
 
 CLAY__ARRAY_DEFINE(Clay__TextElementData, Clay__TextElementDataArray)
@@ -1183,6 +1249,8 @@ typedef struct { // todo get this struct into a single cache line
     void *hoverFunctionUserData;
     int32_t nextIndex;
     uint32_t generation;
+    int32_t renderCommandStart;
+    int32_t renderCommandEnd;
     Clay__DebugElementData *debugData;
 } Clay_LayoutElementHashMapItem;
 
@@ -1248,6 +1316,13 @@ struct Clay_Context {
     uintptr_t arenaResetOffset;
     void *measureTextUserData;
     void *queryScrollOffsetUserData;
+    void *profilingClockUserData;
+    // Element cost profiling
+    bool elementCostProfilingEnabled;
+    int32_t measureTextCacheMisses;
+    int32_t profileSizingIndex;
+    double profileSizingStart;
+    int32_t profileRenderIndex;
     Clay_Arena internalArena;
     // Layout Elements / Render Commands
     Clay_LayoutElementArray layoutElements;
@@ -1288,6 +1363,7 @@ struct Clay_Context {
     Clay__boolArray treeNodeVisited;
     Clay__charArray dynamicStringData;
     Clay__DebugElementDataArray debugElementData;
+    Clay_ElementCostArray elementCosts;
 };
 
 Clay_Context* Clay__Context_Allocate_Arena(Clay_Arena *arena) {
@@ -1311,11 +1387,34 @@ Clay_String Clay__WriteStringToCharBuffer(Clay__charArray *buffer, Clay_String s
 #ifdef CLAY_WASM
     __attribute__((import_module("clay"), import_name("measureTextFunction"))) Clay_Dimensions Clay__MeasureText(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
     __attribute__((import_module("clay"), import_name("queryScrollOffsetFunction"))) Clay_Vector2 Clay__QueryScrollOffset(uint32_t elementId, void *userData);
+    __attribute__((import_module("clay"), import_name("profilingClockFunction"))) double Clay__ProfilingClock(void *userData);
 #else
     Clay_Dimensions (*Clay__MeasureText)(Clay_StringSlice text, Clay_TextElementConfig *config, void *userData);
     Clay_Vector2 (*Clay__QueryScrollOffset)(uint32_t elementId, void *userData);
+    double (*Clay__ProfilingClock)(void *userData);
 #endif
 
+double Clay__ProfilingNow(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    #ifndef CLAY_WASM
+    if (!Clay__ProfilingClock) {
+        return 0;
+    }
+    #endif
+    return Clay__ProfilingClock(context->profilingClockUserData);
+}
+
+// Charges the time since the last call to the element being sized, then starts timing elementIndex (-1 for none).
+void Clay__ProfileSizing(int32_t elementIndex) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    double now = Clay__ProfilingNow();
+    if (context->profileSizingIndex >= 0) {
+        context->elementCosts.internalArray[context->profileSizingIndex].sizingMs += (float)(now - context->profileSizingStart);
+    }
+    context->profileSizingIndex = elementIndex;
+    context->profileSizingStart = now;
+}
+
 Clay_LayoutElement* Clay__GetOpenLayoutElement(void) {
     Clay_Context* context = Clay_GetCurrentContext();
     return Clay_LayoutElementArray_Get(&context->layoutElements, Clay__int32_tArray_GetValue(&context->openLayoutElementStack, context->openLayoutElementStack.length - 1));
@@ -1621,6 +1720,7 @@ Clay__MeasureTextCacheItem *Clay__MeasureTextCached(Clay_String *text, Clay_Text
         }
     }
 
+    context->measureTextCacheMisses++;
     int32_t newItemIndex = 0;
     Clay__MeasureTextCacheItem newCacheItem = { .measuredWordsStartIndex = -1, .id = id, .generation = context->generation };
     Clay__MeasureTextCacheItem *measured = NULL;
@@ -2051,7 +2151,10 @@ void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig)
     }
 
     Clay__int32_tArray_Add(&context->layoutElementChildrenBuffer, context->layoutElements.length - 1);
+    int32_t missesBefore = context->measureTextCacheMisses;
+    double measureStart = context->elementCostProfilingEnabled ? Clay__ProfilingNow() : 0;
     Clay__MeasureTextCacheItem *textMeasured = Clay__MeasureTextCached(&text, textConfig);
+    float measureMs = context->elementCostProfilingEnabled ? (float)(Clay__ProfilingNow() - measureStart) : 0;
     Clay_ElementId elementId = Clay__HashNumber(parentElement->childrenOrTextContent.children.length + parentElement->floatingChildrenCount, parentElement->id);
     textElement->id = elementId.id;
     Clay__AddHashMapItem(elementId, textElement);
@@ -2059,7 +2162,7 @@ void Clay__OpenTextElement(Clay_String text, Clay_TextElementConfig *textConfig)
     Clay_Dimensions textDimensions = { .width = textMeasured->unwrappedDimensions.width, .height = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : textMeasured->unwrappedDimensions.height };
     textElement->dimensions = textDimensions;
     textElement->minDimensions = CLAY__INIT(Clay_Dimensions) { .width = textMeasured->minWidth, .height = textDimensions.height };
-    textElement->childrenOrTextContent.textElementData = Clay__TextElementDataArray_Add(&context->textElementData, CLAY__INIT(Clay__TextElementData) { .text = text, .preferredDimensions = textMeasured->unwrappedDimensions, .elementIndex = context->layoutElements.length - 1 });
+    textElement->childrenOrTextContent.textElementData = Clay__TextElementDataArray_Add(&context->textElementData, CLAY__INIT(Clay__TextElementData) { .text = text, .preferredDimensions = textMeasured->unwrappedDimensions, .elementIndex = context->layoutElements.length - 1, .measureCacheMisses = context->measureTextCacheMisses - missesBefore, .measureMs = measureMs });
     textElement->elementConfigs = CLAY__INIT(Clay__ElementConfigArraySlice) {
             .length = 1,
             .internalArray = Clay__ElementConfigArray_Add(&context->elementConfigs, CLAY__INIT(Clay_ElementConfig) { .type = CLAY__ELEMENT_CONFIG_TYPE_TEXT, .config = { .textElementConfig = textConfig }})
@@ -2217,6 +2320,9 @@ void Clay__InitializeEphemeralMemory(Clay_Context* context) {
     context->reusableElementIndexBuffer = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->layoutElementClipElementIds = Clay__int32_tArray_Allocate_Arena(maxElementCount, arena);
     context->dynamicStringData = Clay__charArray_Allocate_Arena(maxElementCount, arena);
+    context->elementCosts = Clay_ElementCostArray_Allocate_Arena(maxElementCount, arena);
+    context->profileSizingIndex = -1;
+    context->profileRenderIndex = -1;
 }
 
 void Clay__InitializePersistentMemory(Clay_Context* context) {
@@ -2295,6 +2401,9 @@ void Clay__SizeContainersAlongAxis(bool xAxis) {
 
         for (int32_t i = 0; i < bfsBuffer.length; ++i) {
             int32_t parentIndex = Clay__int32_tArray_GetValue(&bfsBuffer, i);
+            if (context->elementCosts.length > 0) {
+                Clay__ProfileSizing(parentIndex);
+            }
             Clay_LayoutElement *parent = Clay_LayoutElementArray_Get(&context->layoutElements, parentIndex);
             Clay_LayoutConfig *parentStyleConfig = parent->layoutConfig;
             int32_t growContainerCount = 0;
@@ -2468,6 +2577,9 @@ void Clay__SizeContainersAlongAxis(bool xAxis) {
             }
         }
     }
+    if (context->elementCosts.length > 0) {
+        Clay__ProfileSizing(-1);
+    }
 }
 
 Clay_String Clay__IntToString(int32_t integer) {
@@ -2505,6 +2617,9 @@ void Clay__AddRenderCommand(Clay_RenderCommand renderCommand) {
     Clay_Context* context = Clay_GetCurrentContext();
     if (context->renderCommands.length < context->renderCommands.capacity - 1) {
         Clay_RenderCommandArray_Add(&context->renderCommands, renderCommand);
+        if (context->profileRenderIndex >= 0) {
+            context->elementCosts.internalArray[context->profileRenderIndex].renderCommandCount++;
+        }
     } else {
         if (!context->booleanWarnings.maxRenderCommandsExceeded) {
             context->booleanWarnings.maxRenderCommandsExceeded = true;
@@ -2528,18 +2643,80 @@ bool Clay__ElementIsOffscreen(Clay_BoundingBox *boundingBox) {
            (boundingBox->y + boundingBox->height < 0);
 }
 
+// Starts an element cost table with a zeroed row per layout element, linked to its parent's row.
+void Clay__BeginElementCosts(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_ElementCostArray *costs = &context->elementCosts;
+    costs->length = context->layoutElements.length;
+    for (int32_t i = 0; i < costs->length; ++i) {
+        costs->internalArray[i] = CLAY__INIT(Clay_ElementCost) { .parentIndex = -1 };
+    }
+    for (int32_t i = 0; i < costs->length; ++i) {
+        Clay_LayoutElement *element = Clay_LayoutElementArray_Get(&context->layoutElements, i);
+        costs->internalArray[i].elementId = Clay__GetHashMapItem(element->id)->elementId;
+        if (Clay__ElementHasConfig(element, CLAY__ELEMENT_CONFIG_TYPE_TEXT)) {
+            continue;
+        }
+        for (int32_t childOffset = 0; childOffset < element->childrenOrTextContent.children.length; ++childOffset) {
+            costs->internalArray[element->childrenOrTextContent.children.elements[childOffset]].parentIndex = i;
+        }
+    }
+}
+
+// Adds what text elements cost at declaration time, then rolls every row up into its parent's subtree totals.
+// Children are always declared after their parent, so one backwards pass visits each subtree before its root.
+void Clay__FinishElementCosts(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_ElementCostArray *costs = &context->elementCosts;
+    for (int32_t i = 0; i < context->textElementData.length; ++i) {
+        Clay__TextElementData *textElementData = Clay__TextElementDataArray_Get(&context->textElementData, i);
+        Clay_ElementCost *cost = &costs->internalArray[textElementData->elementIndex];
+        cost->measureCacheMisses += textElementData->measureCacheMisses;
+        cost->sizingMs += textElementData->measureMs;
+        cost->wrappedLineCount = textElementData->wrappedLines.length;
+    }
+    for (int32_t i = 0; i < costs->length; ++i) {
+        Clay_ElementCost *cost = &costs->internalArray[i];
+        cost->subtreeRenderCommandCount += cost->renderCommandCount;
+        cost->subtreeWrappedLineCount += cost->wrappedLineCount;
+        cost->subtreeMeasureCacheMisses += cost->measureCacheMisses;
+        cost->subtreeSizingMs += cost->sizingMs;
+    }
+    for (int32_t i = costs->length - 1; i > 0; --i) {
+        Clay_ElementCost *cost = &costs->internalArray[i];
+        if (cost->parentIndex < 0) {
+            continue;
+        }
+        Clay_ElementCost *parent = &costs->internalArray[cost->parentIndex];
+        parent->descendantCount += cost->descendantCount + 1;
+        parent->subtreeRenderCommandCount += cost->subtreeRenderCommandCount;
+        parent->subtreeWrappedLineCount += cost->subtreeWrappedLineCount;
+        parent->subtreeMeasureCacheMisses += cost->subtreeMeasureCacheMisses;
+        parent->subtreeSizingMs += cost->subtreeSizingMs;
+    }
+}
+
 void Clay__CalculateFinalLayout(void) {
     Clay_Context* context = Clay_GetCurrentContext();
+    bool profiling = context->elementCostProfilingEnabled;
+    if (profiling) {
+        Clay__BeginElementCosts();
+    }
     // Calculate sizing along the X axis
     Clay__SizeContainersAlongAxis(true);
 
     // Wrap text
     for (int32_t textElementIndex = 0; textElementIndex < context->textElementData.length; ++textElementIndex) {
         Clay__TextElementData *textElementData = Clay__TextElementDataArray_Get(&context->textElementData, textElementIndex);
+        if (profiling) {
+            Clay__ProfileSizing(textElementData->elementIndex);
+        }
         textElementData->wrappedLines = CLAY__INIT(Clay__WrappedTextLineArraySlice) { .length = 0, .internalArray = &context->wrappedTextLines.internalArray[context->wrappedTextLines.length] };
         Clay_LayoutElement *containerElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)textElementData->elementIndex);
         Clay_TextElementConfig *textConfig = Clay__FindElementConfigWithType(containerElement, CLAY__ELEMENT_CONFIG_TYPE_TEXT).textElementConfig;
+        int32_t missesBefore = context->measureTextCacheMisses;
         Clay__MeasureTextCacheItem *measureTextCacheItem = Clay__MeasureTextCached(&textElementData->text, textConfig);
+        textElementData->measureCacheMisses += context->measureTextCacheMisses - missesBefore;
         float lineWidth = 0;
         float lineHeight = textConfig->lineHeight > 0 ? (float)textConfig->lineHeight : textElementData->preferredDimensions.height;
         int32_t lineLengthChars = 0;
@@ -2587,6 +2764,9 @@ void Clay__CalculateFinalLayout(void) {
         }
         containerElement->dimensions.height = lineHeight * (float)textElementData->wrappedLines.length;
     }
+    if (profiling) {
+        Clay__ProfileSizing(-1);
+    }
 
     // Scale vertical heights according to aspect ratio
     for (int32_t i = 0; i < context->aspectRatioElementIndexes.length; ++i) {
@@ -2675,6 +2855,9 @@ void Clay__CalculateFinalLayout(void) {
         dfsBuffer.length = 0;
         Clay__LayoutElementTreeRoot *root = Clay__LayoutElementTreeRootArray_Get(&context->layoutElementTreeRoots, rootIndex);
         Clay_LayoutElement *rootElement = Clay_LayoutElementArray_Get(&context->layoutElements, (int)root->layoutElementIndex);
+        if (profiling) {
+            context->profileRenderIndex = root->layoutElementIndex;
+        }
         Clay_Vector2 rootPosition = CLAY__DEFAULT_STRUCT;
         Clay_LayoutElementHashMapItem *parentHashMapItem = Clay__GetHashMapItem(root->parentId);
         // Position root floating containers
@@ -2762,6 +2945,9 @@ void Clay__CalculateFinalLayout(void) {
             Clay_LayoutElement *currentElement = currentElementTreeNode->layoutElement;
             Clay_LayoutConfig *layoutConfig = currentElement->layoutConfig;
             Clay_Vector2 scrollOffset = CLAY__DEFAULT_STRUCT;
+            if (profiling) {
+                context->profileRenderIndex = (int32_t)(currentElement - context->layoutElements.internalArray);
+            }
 
             // This will only be run a single time for each element in downwards DFS order
             if (!context->treeNodeVisited.internalArray[dfsBuffer.length - 1]) {
@@ -2801,6 +2987,13 @@ void Clay__CalculateFinalLayout(void) {
                 if (hashMapItem) {
                     hashMapItem->boundingBox = currentElementBoundingBox;
                 }
+                // Lookups that miss return the shared default item; never record a range on it.
+                if (hashMapItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+                    hashMapItem->renderCommandStart = context->renderCommands.length;
+                }
+                if (profiling) {
+                    context->elementCosts.internalArray[context->profileRenderIndex].boundingBox = currentElementBoundingBox;
+                }
 
                 int32_t sortedConfigIndexes[20];
                 for (int32_t elementConfigIndex = 0; elementConfigIndex < currentElement->elementConfigs.length; ++elementConfigIndex) {
@@ -3082,6 +3275,10 @@ void Clay__CalculateFinalLayout(void) {
                     });
                 }
 
+                Clay_LayoutElementHashMapItem *closedItem = Clay__GetHashMapItem(currentElement->id);
+                if (closedItem != &Clay_LayoutElementHashMapItem_DEFAULT) {
+                    closedItem->renderCommandEnd = context->renderCommands.length;
+                }
                 dfsBuffer.length--;
                 continue;
             }
@@ -3134,10 +3331,17 @@ void Clay__CalculateFinalLayout(void) {
             }
         }
 
+        if (profiling) {
+            context->profileRenderIndex = root->layoutElementIndex;
+        }
         if (root->clipElementId) {
             Clay__AddRenderCommand(CLAY__INIT(Clay_RenderCommand) { .id = Clay__HashNumber(rootElement->id, rootElement->childrenOrTextContent.children.length + 11).id, .commandType = CLAY_RENDER_COMMAND_TYPE_SCISSOR_END });
         }
     }
+    if (profiling) {
+        context->profileRenderIndex = -1;
+        Clay__FinishElementCosts();
+    }
 }
 
 CLAY_WASM_EXPORT("Clay_GetPointerOverIds")
@@ -3959,6 +4163,11 @@ void Clay_SetQueryScrollOffsetFunction(Clay_Vector2 (*queryScrollOffsetFunction)
     Clay__QueryScrollOffset = queryScrollOffsetFunction;
     context->queryScrollOffsetUserData = userData;
 }
+void Clay_SetProfilingClockFunction(double (*profilingClockFunction)(void *userData), void *userData) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay__ProfilingClock = profilingClockFunction;
+    context->profilingClockUserData = userData;
+}
 #endif
 
 CLAY_WASM_EXPORT("Clay_SetLayoutDimensions")
@@ -4353,6 +4562,21 @@ Clay_ElementData Clay_GetElementData(Clay_ElementId id){
     };
 }
 
+CLAY_WASM_EXPORT("Clay_GetElementRenderRange")
+Clay_ElementRenderRange Clay_GetElementRenderRange(Clay_ElementId id) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    Clay_LayoutElementHashMapItem * item = Clay__GetHashMapItem(id.id);
+    if (item == &Clay_LayoutElementHashMapItem_DEFAULT || item->generation != context->generation + 1) {
+        return CLAY__INIT(Clay_ElementRenderRange) CLAY__DEFAULT_STRUCT;
+    }
+
+    return CLAY__INIT(Clay_ElementRenderRange) {
+        .start = item->renderCommandStart,
+        .end = item->renderCommandEnd,
+        .found = true
+    };
+}
+
 CLAY_WASM_EXPORT("Clay_SetDebugModeEnabled")
 void Clay_SetDebugModeEnabled(bool enabled) {
     Clay_Context* context = Clay_GetCurrentContext();
@@ -4365,6 +4589,17 @@ bool Clay_IsDebugModeEnabled(void) {
     return context->debugModeEnabled;
 }
 
+CLAY_WASM_EXPORT("Clay_SetElementCostProfilingEnabled")
+void Clay_SetElementCostProfilingEnabled(bool enabled) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    context->elementCostProfilingEnabled = enabled;
+}
+
+CLAY_WASM_EXPORT("Clay_GetElementCosts")
+Clay_ElementCostArray Clay_GetElementCosts(void) {
+    return Clay_GetCurrentContext()->elementCosts;
+}
+
 CLAY_WASM_EXPORT("Clay_SetCullingEnabled")
 void Clay_SetCullingEnabled(bool enabled) {
     Clay_Context* context = Clay_GetCurrentContext();
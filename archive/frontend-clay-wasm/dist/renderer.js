@@ -0,0 +1,292 @@
+// Canvas2D interpreter for the packed render command stream. Shared by the
+// app (index.html) and the replay benchmark (replay.html), so both measure
+// the same code.
+
+// Clay render command types
+export const CLAY_RENDER_COMMAND_TYPE_NONE = 0;
+export const CLAY_RENDER_COMMAND_TYPE_RECTANGLE = 1;
+export const CLAY_RENDER_COMMAND_TYPE_BORDER = 2;
+export const CLAY_RENDER_COMMAND_TYPE_TEXT = 3;
+export const CLAY_RENDER_COMMAND_TYPE_IMAGE = 4;
+export const CLAY_RENDER_COMMAND_TYPE_SCISSOR_START = 5;
+export const CLAY_RENDER_COMMAND_TYPE_SCISSOR_END = 6;
+export const CLAY_RENDER_COMMAND_TYPE_CUSTOM = 7;
+
+// Mirrors CustomKind in main.c
+export const CUSTOM_KIND_SERIES_LINE = 1;
+export const CUSTOM_KIND_SERIES_AREA = 2;
+
+export const GLOBAL_FONT_SCALING_FACTOR = 1.0;
+
+// Packed render command stream (PackRenderCommandStream in main.c); JS never parses Clay structs.
+export const PACKED_HDR_SIZE = 32;
+export const PACKED_CMD_SIZE = 64;
+
+// Font configuration
+export const fontsById = [
+    'system-ui, -apple-system, sans-serif',  // FONT_ID_BODY_16
+    'system-ui, -apple-system, sans-serif',  // FONT_ID_BODY_20
+    'system-ui, -apple-system, sans-serif',  // FONT_ID_TITLE_24
+    'system-ui, -apple-system, sans-serif',  // FONT_ID_TITLE_32
+];
+
+const textDecoder = new TextDecoder('utf-8');
+
+// Draw one packed render command from the stream in `view`, whose vertex
+// offsets count from `base`. The caller's transform places it. Returns the
+// command type.
+export function drawPackedCommand(ctx, view, base, arrayOffset, scale) {
+    const commandType = view.getUint8(arrayOffset + 0);
+    const zIndex = view.getInt16(arrayOffset + 2, true);
+    const x = view.getFloat32(arrayOffset + 4, true);
+    const y = view.getFloat32(arrayOffset + 8, true);
+    const w = view.getFloat32(arrayOffset + 12, true);
+    const h = view.getFloat32(arrayOffset + 16, true);
+
+    switch (commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            const r = view.getFloat32(arrayOffset + 20, true);
+            const g = view.getFloat32(arrayOffset + 24, true);
+            const b = view.getFloat32(arrayOffset + 28, true);
+            const a = view.getFloat32(arrayOffset + 32, true);
+
+            const tl = view.getFloat32(arrayOffset + 36, true);
+            const tr = view.getFloat32(arrayOffset + 40, true);
+            const br = view.getFloat32(arrayOffset + 44, true);
+            const bl = view.getFloat32(arrayOffset + 48, true);
+
+            ctx.beginPath();
+            ctx.fillStyle = `rgba(${r}, ${g}, ${b}, ${a / 255})`;
+            ctx.roundRect(
+                x * scale,
+                y * scale,
+                w * scale,
+                h * scale,
+                [
+                    tl * scale,
+                    tr * scale,
+                    br * scale,
+                    bl * scale
+                ]
+            );
+            ctx.fill();
+            ctx.closePath();
+            break;
+        }
+
+        case CLAY_RENDER_COMMAND_TYPE_BORDER: {
+            const r = view.getFloat32(arrayOffset + 20, true);
+            const g = view.getFloat32(arrayOffset + 24, true);
+            const b = view.getFloat32(arrayOffset + 28, true);
+            const a = view.getFloat32(arrayOffset + 32, true);
+
+            const left = view.getUint16(arrayOffset + 52, true);
+            const right = view.getUint16(arrayOffset + 54, true);
+            const top = view.getUint16(arrayOffset + 56, true);
+            const bottom = view.getUint16(arrayOffset + 58, true);
+
+            ctx.strokeStyle = `rgba(${r}, ${g}, ${b}, ${a / 255})`;
+
+            // Top border
+            if (top > 0) {
+                ctx.lineWidth = top * scale;
+                ctx.beginPath();
+                ctx.moveTo(x * scale, (y + top / 2) * scale);
+                ctx.lineTo((x + w) * scale, (y + top / 2) * scale);
+                ctx.stroke();
+            }
+
+            // Bottom border
+            if (bottom > 0) {
+                ctx.lineWidth = bottom * scale;
+                ctx.beginPath();
+                ctx.moveTo(x * scale, (y + h - bottom / 2) * scale);
+                ctx.lineTo((x + w) * scale, (y + h - bottom / 2) * scale);
+                ctx.stroke();
+            }
+
+            // Left border
+            if (left > 0) {
+                ctx.lineWidth = left * scale;
+                ctx.beginPath();
+                ctx.moveTo((x + left / 2) * scale, y * scale);
+                ctx.lineTo((x + left / 2) * scale, (y + h) * scale);
+                ctx.stroke();
+            }
+
+            // Right border
+            if (right > 0) {
+                ctx.lineWidth = right * scale;
+                ctx.beginPath();
+                ctx.moveTo((x + w - right / 2) * scale, y * scale);
+                ctx.lineTo((x + w - right / 2) * scale, (y + h) * scale);
+                ctx.stroke();
+            }
+            break;
+        }
+
+        case CLAY_RENDER_COMMAND_TYPE_TEXT: {
+            const textPtr = view.getUint32(arrayOffset + 20, true);
+            const textLen = view.getUint32(arrayOffset + 24, true);
+            const fontId = view.getUint16(arrayOffset + 28, true);
+            const fontSizeRaw = view.getUint16(arrayOffset + 30, true);
+            const r = view.getFloat32(arrayOffset + 36, true);
+            const g = view.getFloat32(arrayOffset + 40, true);
+            const b = view.getFloat32(arrayOffset + 44, true);
+            const a = view.getFloat32(arrayOffset + 48, true);
+
+            const stringContents = new Uint8Array(view.buffer, view.byteOffset + textPtr, textLen);
+            const text = textDecoder.decode(stringContents);
+            const fontSize = fontSizeRaw * GLOBAL_FONT_SCALING_FACTOR * scale;
+
+            ctx.font = `${fontSize}px ${fontsById[fontId] || 'sans-serif'}`;
+            ctx.textBaseline = 'middle';
+            ctx.fillStyle = `rgba(${r}, ${g}, ${b}, ${a / 255})`;
+            ctx.fillText(
+                text,
+                x * scale,
+                (y + h / 2) * scale
+            );
+            break;
+        }
+
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
+            ctx.save();
+            ctx.beginPath();
+            ctx.rect(
+                x * scale,
+                y * scale,
+                w * scale,
+                h * scale
+            );
+            ctx.clip();
+            ctx.closePath();
+            break;
+        }
+
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
+            ctx.restore();
+            break;
+        }
+
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM: {
+            const bgA = view.getFloat32(arrayOffset + 32, true);
+            if (bgA > 0) {
+                ctx.beginPath();
+                ctx.fillStyle = `rgba(${view.getFloat32(arrayOffset + 20, true)}, ${view.getFloat32(arrayOffset + 24, true)}, ${view.getFloat32(arrayOffset + 28, true)}, ${bgA / 255})`;
+                ctx.roundRect(x * scale, y * scale, w * scale, h * scale, [
+                    view.getFloat32(arrayOffset + 36, true) * scale,
+                    view.getFloat32(arrayOffset + 40, true) * scale,
+                    view.getFloat32(arrayOffset + 44, true) * scale,
+                    view.getFloat32(arrayOffset + 48, true) * scale
+                ]);
+                ctx.fill();
+                ctx.closePath();
+            }
+            const kind = view.getUint8(arrayOffset + 62);
+            const vertexCount = view.getUint16(arrayOffset + 60, true);
+            if ((kind !== CUSTOM_KIND_SERIES_LINE && kind !== CUSTOM_KIND_SERIES_AREA) || vertexCount < 2) {
+                break;
+            }
+            const r = view.getUint8(arrayOffset + 52);
+            const g = view.getUint8(arrayOffset + 53);
+            const b = view.getUint8(arrayOffset + 54);
+            const a = view.getUint8(arrayOffset + 55);
+            // Vertices were downsampled in WASM to about one per pixel of width.
+            const vertices = new Float32Array(
+                view.buffer,
+                view.byteOffset + base + view.getUint32(arrayOffset + 56, true),
+                vertexCount * 2
+            );
+
+            ctx.beginPath();
+            ctx.moveTo((x + vertices[0]) * scale, (y + vertices[1]) * scale);
+            for (let v = 1; v < vertexCount; v++) {
+                ctx.lineTo((x + vertices[v * 2]) * scale, (y + vertices[v * 2 + 1]) * scale);
+            }
+            if (kind === CUSTOM_KIND_SERIES_AREA) {
+                ctx.save();
+                ctx.lineTo((x + vertices[(vertexCount - 1) * 2]) * scale, (y + h) * scale);
+                ctx.lineTo((x + vertices[0]) * scale, (y + h) * scale);
+                ctx.closePath();
+                ctx.fillStyle = `rgba(${r}, ${g}, ${b}, ${(a / 255) * 0.25})`;
+                ctx.fill();
+                ctx.restore();
+            }
+            ctx.strokeStyle = `rgba(${r}, ${g}, ${b}, ${a / 255})`;
+            ctx.lineWidth = 1.5 * scale;
+            ctx.lineJoin = 'round';
+            ctx.stroke();
+            break;
+        }
+    }
+    return commandType;
+}
+
+// Replay captures: frames recorded from the app for replay.html.
+// Header: "TXXTCAP1", u32 frame_count, u32 reserved. Per frame: u32
+// stream_bytes, f32 width, f32 height, f32 scale (CSS px and device pixel
+// ratio), f32 wasm_ms, f32 draw_ms (as recorded), then the self-contained
+// stream (CaptureLastFrame in main.c) padded to 4 bytes.
+export const CAPTURE_MAGIC = 'TXXTCAP1';
+const CAPTURE_HDR_SIZE = 16;
+const CAPTURE_FRAME_HDR_SIZE = 24;
+
+export function encodeCapture(frames) {
+    let size = CAPTURE_HDR_SIZE;
+    for (const frame of frames) {
+        size += CAPTURE_FRAME_HDR_SIZE + ((frame.stream.byteLength + 3) & ~3);
+    }
+    const bytes = new Uint8Array(size);
+    const view = new DataView(bytes.buffer);
+    for (let i = 0; i < CAPTURE_MAGIC.length; i++) {
+        bytes[i] = CAPTURE_MAGIC.charCodeAt(i);
+    }
+    view.setUint32(8, frames.length, true);
+    let at = CAPTURE_HDR_SIZE;
+    for (const frame of frames) {
+        view.setUint32(at + 0, frame.stream.byteLength, true);
+        view.setFloat32(at + 4, frame.width, true);
+        view.setFloat32(at + 8, frame.height, true);
+        view.setFloat32(at + 12, frame.scale, true);
+        view.setFloat32(at + 16, frame.wasmMs, true);
+        view.setFloat32(at + 20, frame.drawMs, true);
+        bytes.set(new Uint8Array(frame.stream), at + CAPTURE_FRAME_HDR_SIZE);
+        at += CAPTURE_FRAME_HDR_SIZE + ((frame.stream.byteLength + 3) & ~3);
+    }
+    return bytes.buffer;
+}
+
+// Frames of a capture, each with its stream in its own ArrayBuffer. Throws on
+// anything that isn't one.
+export function decodeCapture(buffer) {
+    const bytes = new Uint8Array(buffer);
+    const view = new DataView(buffer);
+    const magic = String.fromCharCode(...bytes.subarray(0, CAPTURE_MAGIC.length));
+    if (buffer.byteLength < CAPTURE_HDR_SIZE || magic !== CAPTURE_MAGIC) {
+        throw new Error('not a txxt capture');
+    }
+    const count = view.getUint32(8, true);
+    const frames = [];
+    let at = CAPTURE_HDR_SIZE;
+    for (let i = 0; i < count; i++) {
+        if (at + CAPTURE_FRAME_HDR_SIZE > buffer.byteLength) {
+            throw new Error(`capture truncated at frame ${i}`);
+        }
+        const length = view.getUint32(at + 0, true);
+        const start = at + CAPTURE_FRAME_HDR_SIZE;
+        if (start + length > buffer.byteLength) {
+            throw new Error(`capture truncated at frame ${i}`);
+        }
+        frames.push({
+            width: view.getFloat32(at + 4, true),
+            height: view.getFloat32(at + 8, true),
+            scale: view.getFloat32(at + 12, true),
+            wasmMs: view.getFloat32(at + 16, true),
+            drawMs: view.getFloat32(at + 20, true),
+            stream: buffer.slice(start, start + length),
+        });
+        at = start + ((length + 3) & ~3);
+    }
+    return frames;
+}
@@ -1,12 +1,21 @@
 #define CLAY_IMPLEMENTATION
 #include "clay.h"
 
+// Byte classification for the CSV importer (see csv_classify16).
+#if !defined(CLAY_DISABLE_SIMD) && defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif !defined(CLAY_DISABLE_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef CLAY_WASM
 // Provide strlen for -nostdlib builds
 unsigned long strlen(const char* str) {
     unsigned long len = 0;
     while (str && str[len]) len++;
     return len;
 }
+#endif
 
 // Helper to get string length
 static inline uint32_t str_len(const char* str) {
@@ -64,50 +73,116 @@ typedef enum {
     PRIORITY_URGENT = 3
 } Priority;
 
-// Task data structure
+// Task data structure (hot tier). Everything the list, filters and aggregates
+// need is hydrated up front; description, category and assignee name live in
+// TaskDetail and are fetched on demand.
 typedef struct {
     // UUID string from backend (36 chars + NUL).
     char id[37];
     // Legacy numeric id (kept only for unused JS interop exports).
     uint32_t legacy_id;
     char title[128];
-    char description[512];
+    // First line of the description, for list cards.
+    char preview[64];
     TaskStatus status;
     Priority priority;
-    char category[64];
     char service_name[64];
     char due_date[32];
-    char assigned_to[64];
+    // Interned handles for service_name / assignee (0 = empty).
+    uint16_t service_handle;
+    uint16_t assignee_handle;
+    // Parsed due_date in epoch days (TXXT_DUE_NONE = no due date).
+    uint16_t due_day;
+    // Day the task is scheduled on (the wire `date`; TXXT_DUE_NONE = staged).
+    // A plan, not a deadline: never counts as due or overdue.
+    uint16_t scheduled_day;
+    // Detail cache slot hint, validated against the slot's task id (-1 = none).
+    int16_t detail_slot;
     bool selected;
 } Task;
 
+// Detail tier: one LRU cache slot per recently viewed task.
+typedef struct {
+    char task_id[37];
+    char description[512];
+    char category[64];
+    char assigned_to[64];
+    uint32_t last_used;
+    // Still served, but refetched the next time it is requested: a REST
+    // reload may have brought edits this copy predates.
+    bool stale;
+} TaskDetail;
+
 typedef struct {
     char id[37];
     char name[64];
 } Service;
 
 #define TXXT_MAX_TASKS 100u
+#define TXXT_TASK_INDEX_SLOTS 256u  // open-addressed, power of two, > 2x the task cap
 #define TXXT_TASK_TITLE_MAX 128u
 #define TXXT_TASK_DESC_MAX 512u
 #define TXXT_TASK_CATEGORY_MAX 64u
 #define TXXT_TASK_DUE_DATE_MAX 32u
 #define TXXT_TASK_ASSIGNED_TO_MAX 64u
+#define TXXT_TASK_PREVIEW_MAX 64u
+
+// Detail tier: LRU cache, prefetch queue drained by the host, and the input
+// entry the host fills per fetched task (id @0, description @40, category @552,
+// assigned_to @616).
+#define TXXT_DETAIL_CACHE_SLOTS 32u
+#define TXXT_DETAIL_QUEUE_MAX 16u
+#define TXXT_DETAIL_INPUT_SIZE 680u
+#define TXXT_DETAIL_REQUEST_STRIDE 40u
+#define TXXT_DETAIL_RETRY_SECONDS 5.0
+#define TXXT_DETAIL_PREFETCH_MARGIN 400.0f
+
+// Compact wire snapshot (backend wire.rs, msg type 0x08): fixed-stride hot
+// records followed by a deduplicated table of varint-length strings. Frames
+// up to TXXT_SNAPSHOT_INPUT_MAX use the static input buffer; larger ones get
+// a region grown from linear memory (GetSnapshotInputBuffer).
+#define TXXT_SNAPSHOT_INPUT_MAX 65536u
+#define TXXT_COMPACT_MSG_SNAPSHOT 0x08u
+#define TXXT_COMPACT_HEADER_SIZE 21u
+#define TXXT_COMPACT_TASK_STRIDE 60u
+#define TXXT_COMPACT_SERVICE_STRIDE 20u
+#define TXXT_WIRE_DATE_NONE 0xFFFFu
+
+// Game-socket events (wire.rs msg), applied singly or as a 0x09 batch frame
+// (u16 count, then events back to back).
+#define TXXT_WIRE_TASK_CREATED 0x02u
+#define TXXT_WIRE_TASK_SCHEDULED 0x03u
+#define TXXT_WIRE_TASK_MOVED 0x04u
+#define TXXT_WIRE_TASK_UNSCHEDULED 0x05u
+#define TXXT_WIRE_TASK_COMPLETED 0x06u
+#define TXXT_WIRE_TASK_DELETED 0x07u
+#define TXXT_WIRE_BATCH 0x09u
+#define TXXT_WIRE_DURABLE 0x0Au
+#define TXXT_WIRE_BATCH_HEADER 3u
+#define TXXT_WIRE_EVENT_HEADER 25u
+#define TXXT_WIRE_TASK_STRIDE 192u
+#define TXXT_EVENT_INPUT_MAX 16384u
+
+// Client commands (wire.rs msg). Bulk import sends its CMD_CREATE_TASK
+// records in one 0x17 command batch (u16 count, then [u16 len][command]).
+#define TXXT_WIRE_CMD_CREATE_TASK 0x10u
+#define TXXT_WIRE_CMD_BATCH 0x17u
+#define TXXT_WIRE_CMD_BATCH_HEADER 3u
+#define TXXT_WIRE_CREATE_TASK_HEADER 40u  // then the title bytes
 
 #define TXXT_TASK_INPUT_HDR_SIZE 16u
 #define TXXT_TASK_ID_MAX 37u
-// Task input entry layout (bytes):
+// Task input entry layout (bytes), hot tier only: the preview and assignee
+// are taken from the detail tier when it arrives (ApplyTaskDetailInput).
 // 0..3   u32 reserved
 // 4..7   u32 status
 // 8..11  u32 priority
 // 12..48 char id[37]
 // 49..51 padding
 // 52..179 title[128]
-// 180..691 description[512]
-// 692..755 category[64]
-// 756..819 service_name[64]
-// 820..851 due_date[32]
-// 852..915 assigned_to[64]
-#define TXXT_TASK_INPUT_STRIDE 916u
+// 180..243 service_name[64]
+// 244..275 due_date[32]
+#define TXXT_TASK_INPUT_STRIDE 276u
 #define TXXT_TASK_SERVICE_NAME_MAX 64u
 
 #define TXXT_SERVICE_INPUT_HDR_SIZE 16u
@@ -115,8 +190,82 @@ typedef struct {
 #define TXXT_SERVICE_ID_MAX 37u
 #define TXXT_SERVICE_NAME_MAX 64u
 
+// Interned string table (service names, assignees). Handle 0 is the empty string.
+// Sized so the live set always fits: all 64 service names plus a service and
+// an assignee per task. Entries are never removed, so churn can still fill it;
+// later strings then map to 0 and are counted (GetInternOverflowCount).
+#define TXXT_INTERN_MAX (1u + 64u + 2u * TXXT_MAX_TASKS)
+#define TXXT_INTERN_SLOTS 512u
+#define TXXT_INTERN_STR_MAX 64u
+
+// Chart series slots. Throughput and burndown are sampled from the task store
+// every TXXT_SERIES_SAMPLE_SECONDS (series_sample); the host may fill the rest
+// (see GetSeriesInputBuffer).
+#define TXXT_MAX_SERIES 4u
+#define TXXT_SERIES_MAX_POINTS 16384u
+#define TXXT_SERIES_MAX_VERTICES 4096u
+#define TXXT_SERIES_THROUGHPUT 0u
+#define TXXT_SERIES_BURNDOWN 1u
+#define TXXT_SERIES_SAMPLE_SECONDS 10.0
+
+#define TXXT_DUE_NONE 0xFFFFu
+#define TXXT_STATUS_COUNT 3u
+#define TXXT_PRIORITY_COUNT 4u
+
+// In-canvas editing of the create form (see EditField)
+#define TXXT_EDIT_FIELD_TITLE 0u
+#define TXXT_EDIT_FIELD_DESC 1u
+#define TXXT_EDIT_FIELD_SERVICE 2u
+#define TXXT_EDIT_FIELD_DUE 3u
+#define TXXT_EDIT_FIELD_COUNT 4u
+#define TXXT_EDIT_FIELD_MAX 512u
+#define TXXT_EDIT_INPUT_MAX 1024u
+#define TXXT_EDIT_LINE_HEIGHT 20u
+
+// Editing keys forwarded by the host (EditKey)
+#define TXXT_KEY_BACKSPACE 1u
+#define TXXT_KEY_DELETE 2u
+#define TXXT_KEY_LEFT 3u
+#define TXXT_KEY_RIGHT 4u
+#define TXXT_KEY_UP 5u
+#define TXXT_KEY_DOWN 6u
+#define TXXT_KEY_HOME 7u
+#define TXXT_KEY_END 8u
+#define TXXT_KEY_TAB 9u
+#define TXXT_KEY_ENTER 10u
+#define TXXT_KEY_ESCAPE 11u
+#define TXXT_KEY_SELECT_ALL 12u
+
+#define TXXT_KEY_MOD_SHIFT 1u
+#define TXXT_KEY_MOD_WORD 2u
+
 static uint8_t task_input_buffer[TXXT_TASK_INPUT_HDR_SIZE + (TXXT_MAX_TASKS * TXXT_TASK_INPUT_STRIDE)] = {0};
 static uint8_t service_input_buffer[TXXT_SERVICE_INPUT_HDR_SIZE + (64u * TXXT_SERVICE_INPUT_STRIDE)] = {0};
+static char task_id_input[TXXT_TASK_ID_MAX] = {0};
+static uint8_t snapshot_input_buffer[TXXT_SNAPSHOT_INPUT_MAX] = {0};
+static uint8_t* snapshot_input = snapshot_input_buffer;
+static uint32_t snapshot_input_capacity = TXXT_SNAPSHOT_INPUT_MAX;
+static uint8_t event_input_buffer[TXXT_EVENT_INPUT_MAX] = {0};
+
+typedef struct {
+    char id[TXXT_TASK_ID_MAX];
+    double requested_at;
+    bool drained;
+} DetailRequest;
+
+// LRU-bounded detail tier plus the queue of ids the host should fetch.
+// Drained requests stay queued (in flight) until the detail arrives or the
+// retry interval passes.
+typedef struct {
+    TaskDetail slots[TXXT_DETAIL_CACHE_SLOTS];
+    uint32_t clock;
+    DetailRequest queue[TXXT_DETAIL_QUEUE_MAX];
+    uint32_t queue_count;
+} DetailCache;
+
+static DetailCache detail_cache = {0};
+static uint8_t detail_input_buffer[TXXT_DETAIL_INPUT_SIZE] = {0};
+static uint8_t detail_request_buffer[TXXT_DETAIL_QUEUE_MAX * TXXT_DETAIL_REQUEST_STRIDE] = {0};
 
 // Filter enum
 typedef enum {
@@ -137,9 +286,9 @@ typedef struct {
     int32_t selected_service_index;
     int32_t pending_create_service_index;
     FilterStatus filter_status;
-    bool show_create_modal;
     bool create_panel_visible;
     bool show_detail_panel;
+    bool show_dashboard;
     bool logged_in;
 } AppState;
 
@@ -152,6 +301,8 @@ typedef struct {
 
 // Global state
 AppState app_state = {0};
+// Task position by UUID (index + 1, 0 = empty), kept in step with app_state.tasks.
+static uint8_t task_index[TXXT_TASK_INDEX_SLOTS] = {0};
 double window_width = 1024;
 double window_height = 768;
 
@@ -172,6 +323,482 @@ typedef struct {
 
 Arena frame_arena = {0};
 
+// Interned strings: open-addressed FNV-1a table mapping names to stable u16
+// handles. Entries are never removed, so handles stay valid for the session.
+typedef struct {
+    char strings[TXXT_INTERN_MAX][TXXT_INTERN_STR_MAX];
+    uint32_t hashes[TXXT_INTERN_MAX];
+    uint16_t slots[TXXT_INTERN_SLOTS];
+    uint32_t count;
+    // Strings refused because the table was full.
+    uint32_t overflowed;
+} InternTable;
+
+static InternTable intern_table = { .count = 1 };
+
+// Workload aggregates, maintained incrementally on every task upsert/delete
+// (remove old contribution, add new one). The dashboard only reads these.
+typedef struct {
+    uint32_t assignee_status[TXXT_INTERN_MAX][TXXT_STATUS_COUNT];
+    uint32_t service_priority[TXXT_INTERN_MAX][TXXT_PRIORITY_COUNT];
+    uint32_t service_overdue[TXXT_INTERN_MAX];
+    uint32_t status_total[TXXT_STATUS_COUNT];
+    uint32_t overdue_total;
+    // Epoch day used for the overdue test; changing it rebuilds overdue counts.
+    uint16_t today;
+} Aggregates;
+
+static Aggregates aggregates = { .today = 0 };
+
+// Cycle-time analytics: lead time (staged -> completed) and cycle time
+// (scheduled -> completed) per service, streamed from the task events the
+// client already applies. Events carry no wall time, so stage entries are
+// stamped on arrival with the session clock and only transitions seen this
+// session are measured. Durations go into fixed-size KLL quantile sketches:
+// memory does not grow with history.
+#define TXXT_CYCLE_TRACK_SLOTS 256u       // open-addressed, power of two
+#define TXXT_CYCLE_SERVICES 32u
+#define TXXT_CYCLE_LEAD 0u
+#define TXXT_CYCLE_CYCLE 1u
+#define TXXT_CYCLE_KINDS 2u
+#define TXXT_KLL_LEVEL_CAPACITY 64u       // even: a full level halves exactly
+#define TXXT_KLL_LEVELS 16u               // ~4M durations before saturating
+
+// Items on level h stand for 2^h durations. Level 0 is an unsorted input
+// buffer; higher levels are kept sorted. A full level is compacted by
+// keeping every other item (random parity) and merging them one level up.
+typedef struct {
+    float items[TXXT_KLL_LEVELS][TXXT_KLL_LEVEL_CAPACITY];
+    uint8_t count[TXXT_KLL_LEVELS];
+    uint32_t n;
+    // Refreshed on every insert; the dashboard only reads these.
+    float p50;
+    float p90;
+} KllSketch;
+
+// Stage-entry times of a task in flight (seconds, < 0 = not seen).
+typedef struct {
+    uint8_t id[16];
+    bool used;
+    bool live; // scratch mark for cycle_track_prune
+    double staged_at;
+    double scheduled_at;
+} CycleTrack;
+
+typedef struct {
+    CycleTrack tracks[TXXT_CYCLE_TRACK_SLOTS];
+    uint32_t tracked;
+    // Service intern handle -> sketch slot + 1 (0 = none yet).
+    uint8_t service_slot[TXXT_INTERN_MAX];
+    uint16_t slot_service[TXXT_CYCLE_SERVICES];
+    uint32_t service_count;
+    KllSketch sketches[TXXT_CYCLE_SERVICES][TXXT_CYCLE_KINDS];
+    uint32_t rng;
+    // Revision the connection's hydration reaches (HELLO). Events at or
+    // below it are a `?since=` replay arriving in one burst: their arrival
+    // time is not when they happened, so they never stamp or measure.
+    uint64_t replay_horizon;
+} CycleStats;
+
+static CycleStats cycle_stats = { .rng = 0x9E3779B9u };
+
+// Task dependency graph ("blocked by" links), keyed by task UUID; an edge
+// u -> v means u blocks v. Edges are indexed by CSR successor/predecessor
+// arrays, rebuilt by counting sort once 256 inserts are pending; until
+// then new edges sit in a short unsorted tail that every walk also scans.
+// Removing an edge only marks it dead. A topological order is maintained
+// incrementally (Pearce-Kelly): an insert that contradicts it reorders only
+// the nodes between the two endpoints, and an insert that would close a
+// cycle is rejected. Earliest finish (longest path over durations) and depth
+// are repaired forward from the touched nodes in topological order.
+#define TXXT_DEP_NODES 16384u
+#define TXXT_DEP_EDGES 65536u
+#define TXXT_DEP_HASH_SLOTS 32768u        // power of two, at most half full
+#define TXXT_DEP_PENDING_MAX 256u
+#define TXXT_DEP_INPUT_MAX 256u
+#define TXXT_DEP_INPUT_STRIDE 32u         // [blocker uuid][blocked uuid], or [uuid][f32 duration]
+#define TXXT_DEP_DEFAULT_DURATION 1.0f
+#define TXXT_DEP_NONE 0xFFFFu
+
+// from == to marks a removed edge (self-links are never accepted).
+typedef struct {
+    uint16_t from;
+    uint16_t to;
+} DepEdge;
+
+typedef struct {
+    uint8_t node_id[TXXT_DEP_NODES][16];
+    uint16_t hash[TXXT_DEP_HASH_SLOTS];     // node + 1, 0 = empty
+    uint32_t node_count;
+    // Topological order: position of each node, and node at each position.
+    uint16_t ord[TXXT_DEP_NODES];
+    uint16_t at[TXXT_DEP_NODES];
+    float duration[TXXT_DEP_NODES];
+    // Earliest finish: own duration plus the latest finish among blockers.
+    float finish[TXXT_DEP_NODES];
+    uint16_t depth[TXXT_DEP_NODES];
+    uint16_t critical_pred[TXXT_DEP_NODES]; // blocker that sets finish
+    DepEdge edges[TXXT_DEP_EDGES];
+    uint32_t edge_count;
+    uint32_t live_edges;
+    // CSR over edges[0, csr_edges) for nodes [0, csr_nodes); the rest is the tail.
+    uint32_t csr_edges;
+    uint32_t csr_nodes;
+    uint32_t succ_start[TXXT_DEP_NODES + 1];
+    uint32_t succ[TXXT_DEP_EDGES];
+    uint32_t pred_start[TXXT_DEP_NODES + 1];
+    uint32_t pred[TXXT_DEP_EDGES];
+    // Search scratch: visit stamps, DFS stack, the two reorder regions, and
+    // the topological positions they share.
+    uint32_t mark[TXXT_DEP_NODES];
+    uint32_t stamp;
+    uint16_t stack[TXXT_DEP_NODES];
+    uint16_t forward[TXXT_DEP_NODES];
+    uint16_t backward[TXXT_DEP_NODES];
+    uint16_t pool[TXXT_DEP_NODES];
+    // Finish repair queue: a min-heap on topological position.
+    uint16_t heap[TXXT_DEP_NODES];
+    uint32_t heap_count;
+    uint8_t queued[TXXT_DEP_NODES];
+    // Critical path, recomputed lazily: nodes on it carry the current stamp.
+    uint32_t critical_mark[TXXT_DEP_NODES];
+    uint32_t critical_stamp;
+    float critical_length;
+    bool critical_dirty;
+    uint32_t rejected_cycles;
+} DepGraph;
+
+static DepGraph dep_graph = {0};
+static uint8_t dep_input_buffer[TXXT_DEP_INPUT_MAX * TXXT_DEP_INPUT_STRIDE] = {0};
+// Task list ordered by dependency, with the critical path highlighted.
+static bool dep_view_enabled = false;
+
+// Recurring tasks. A rule is stored once; its occurrences are generated
+// only for the date window on screen and cached per window (keyed by the
+// window and the store revision). Per-occurrence changes (completed,
+// skipped, moved) are overrides kept sorted by (rule, original day), so
+// expansion merges each rule's generated days with its overrides in one
+// sorted pass. Moved occurrences are also indexed by target day so a
+// window picks up those moved in from outside it.
+#define TXXT_RECUR_RULES_MAX 256u
+#define TXXT_RECUR_OVERRIDES_MAX 1024u
+#define TXXT_RECUR_WINDOW_DAYS_MAX 62u
+#define TXXT_RECUR_OCCURRENCES_MAX 2048u  // per window; the rest is dropped
+#define TXXT_RECUR_CACHE_WINDOWS 4u
+#define TXXT_RECUR_TITLE_MAX 64u
+// Rule input: id @0, start day @16, until day @18 (0xFFFF = open), interval
+// @20, kind @22, weekday mask @23 (bit 0 = Monday), priority @24, title @32.
+// Override input: rule id @0, original day @16, moved-to day @18, state @20.
+#define TXXT_RECUR_INPUT_SIZE 96u
+#define TXXT_SCHEDULE_DAYS 14u
+#define TXXT_SCHEDULE_ITEMS_PER_DAY 5u
+
+typedef enum {
+    RECUR_DAILY = 0,   // every `interval` days
+    RECUR_WEEKLY = 1   // on the weekdays in the mask, every `interval` weeks
+} RecurKind;
+
+typedef enum {
+    RECUR_OCC_PENDING = 0,
+    RECUR_OCC_COMPLETED = 1,
+    RECUR_OCC_SKIPPED = 2
+} RecurState;
+
+typedef struct {
+    uint8_t id[16];
+    char title[TXXT_RECUR_TITLE_MAX];
+    uint16_t start_day;
+    uint16_t until_day;
+    uint16_t interval;
+    uint8_t kind;
+    uint8_t weekdays;
+    uint8_t priority;
+    bool used;
+} RecurRule;
+
+typedef struct {
+    uint16_t rule;
+    uint16_t day;        // original day
+    uint16_t moved_to;   // TXXT_DUE_NONE = not moved
+    uint8_t state;
+} RecurOverride;
+
+// Moved occurrences by target day (mirrors the overrides with moved_to set).
+typedef struct {
+    uint16_t moved_to;
+    uint16_t rule;
+    uint16_t day;
+} RecurMoved;
+
+typedef struct {
+    uint16_t day;        // effective day
+    uint16_t original_day;
+    uint16_t rule;
+    uint8_t state;
+    bool moved;
+} RecurOccurrence;
+
+// One expanded window: occurrences bucketed by day offset.
+typedef struct {
+    uint16_t first_day;
+    uint16_t day_count;
+    uint32_t revision;   // 0 = empty slot
+    uint32_t last_used;
+    uint32_t count;
+    bool truncated;
+    uint16_t day_start[TXXT_RECUR_WINDOW_DAYS_MAX + 1];
+    RecurOccurrence items[TXXT_RECUR_OCCURRENCES_MAX];
+} RecurWindow;
+
+typedef struct {
+    RecurRule rules[TXXT_RECUR_RULES_MAX];
+    uint32_t rule_count;  // slots ever used; freed slots are reused
+    RecurOverride overrides[TXXT_RECUR_OVERRIDES_MAX];
+    uint32_t override_count;
+    RecurMoved moved[TXXT_RECUR_OVERRIDES_MAX];
+    uint32_t moved_count;
+    uint32_t revision;
+    uint32_t clock;
+    uint32_t expansions;  // windows generated (cache misses)
+    RecurWindow windows[TXXT_RECUR_CACHE_WINDOWS];
+    RecurOccurrence scratch[TXXT_RECUR_OCCURRENCES_MAX];
+} RecurStore;
+
+static RecurStore recur_store = { .revision = 1 };
+static uint8_t recur_input_buffer[TXXT_RECUR_INPUT_SIZE] = {0};
+// Schedule strip: first visible day (TXXT_DUE_NONE = this week).
+static bool schedule_visible = false;
+static uint16_t schedule_first_day = TXXT_DUE_NONE;
+
+// CSV/TSV bulk import. The host streams text through the import input buffer
+// in chunks; the parser carries its quote and field state across chunk ends,
+// so a chunk may split anywhere. The first row is the header (columns are
+// matched by name; title and service are required). Every valid row becomes a
+// CMD_CREATE_TASK record in one command batch the host sends as one frame.
+#define TXXT_IMPORT_CHUNK_MAX 65536u
+#define TXXT_IMPORT_BATCH_MAX (1024u * 1024u)
+#define TXXT_IMPORT_ROWS_MAX 0xFFFFu   // u16 batch count
+#define TXXT_IMPORT_COLUMNS_MAX 16u    // later columns are ignored
+#define TXXT_IMPORT_FIELD_MAX 128u     // bytes kept per field (wire TITLE_MAX)
+#define TXXT_IMPORT_DEFAULT_START 540u // 09:00, for dated rows without a start
+#define TXXT_IMPORT_DEFAULT_DURATION 60u
+#define TXXT_IMPORT_SLOT_MINUTES 15u     // start and duration grid (world.rs validate_scheduling)
+#define TXXT_IMPORT_DAY_MINUTES 1440u
+
+typedef enum {
+    IMPORT_COL_IGNORED = 0,
+    IMPORT_COL_TITLE = 1,
+    IMPORT_COL_SERVICE = 2,
+    IMPORT_COL_PRIORITY = 3,
+    IMPORT_COL_DATE = 4,
+    IMPORT_COL_START = 5,
+    IMPORT_COL_DURATION = 6,
+    IMPORT_COL_KINDS = 7
+} ImportColumn;
+
+typedef enum {
+    IMPORT_REJECT_SERVICE = 0,  // not in the service list
+    IMPORT_REJECT_TITLE = 1,    // empty title
+    IMPORT_REJECT_FIELD = 2,    // unreadable priority, date, start or duration
+    IMPORT_REJECT_FULL = 3,     // batch out of room
+    IMPORT_REJECT_KINDS = 4
+} ImportReject;
+
+typedef struct {
+    uint8_t delimiter;      // 0 = detect from the first line (tab or comma)
+    bool started;
+    bool header_done;
+    bool header_valid;
+    bool in_quotes;
+    bool quote_closed;      // last byte closed a quote, so '"' next is a literal quote
+    uint8_t columns[TXXT_IMPORT_COLUMNS_MAX];
+    // Current row: one NUL-terminated slot per column.
+    char fields[TXXT_IMPORT_COLUMNS_MAX][TXXT_IMPORT_FIELD_MAX + 1u];
+    uint16_t field_length[TXXT_IMPORT_COLUMNS_MAX];
+    uint32_t truncated;     // bit per column that lost bytes
+    uint32_t field;         // column being read
+    uint32_t records;       // rows ended so far, header included
+    uint32_t accepted;
+    uint32_t rejected[IMPORT_REJECT_KINDS];
+    uint32_t first_rejected_row;  // 1-based, header = row 1; 0 = none
+    uint32_t batch_length;
+    uint8_t batch[TXXT_IMPORT_BATCH_MAX];
+} ImportState;
+
+static ImportState import_state = {0};
+static uint8_t import_input_buffer[TXXT_IMPORT_CHUNK_MAX] = {0};
+// Services by intern handle (index + 1, 0 = none) and their wire ids, rebuilt
+// with the service list so an import row resolves its service in one probe.
+static uint8_t service_by_handle[TXXT_INTERN_MAX] = {0};
+static uint8_t service_wire_ids[64][16] = {0};
+
+// Streaming export of the task list as shown (filter, service, order). The
+// view's task ids are snapshotted when an export starts; rows are then
+// formatted into a fixed ring within a per-frame time budget, and the host
+// drains the ring into Blob parts after each frame, so neither side holds the
+// file as one buffer.
+#define TXXT_EXPORT_RING_BYTES 65536u   // power of two
+#define TXXT_EXPORT_ROW_MAX 1024u       // room a row needs (worst case ~600 bytes)
+#define TXXT_EXPORT_FRAME_BUDGET_MS 2.0
+#define TXXT_EXPORT_CLOCK_EVERY 16u     // rows between clock reads
+
+typedef enum {
+    EXPORT_IDLE = 0,
+    EXPORT_RUNNING = 1,   // rows left to format
+    EXPORT_DRAINING = 2   // all rows formatted; the ring may still hold bytes
+} ExportPhase;
+
+typedef struct {
+    uint8_t phase;
+    uint8_t delimiter;    // ',' (CSV, CRLF rows) or '\t' (TSV, LF rows)
+    uint32_t row_count;
+    uint32_t cursor;      // next snapshot row to format
+    uint32_t rows_written;
+    uint32_t head;        // bytes written; ring offset = head & (size - 1)
+    uint32_t tail;        // bytes drained
+    char ids[TXXT_MAX_TASKS][TXXT_TASK_ID_MAX];
+    uint8_t ring[TXXT_EXPORT_RING_BYTES];
+} ExportState;
+
+static ExportState export_state = {0};
+
+// Custom render command kinds. customData always points at a struct starting
+// with a CustomHeader; one without TXXT_CUSTOM_MAGIC is not ours to draw.
+typedef enum {
+    CUSTOM_KIND_NONE = 0,
+    CUSTOM_KIND_SERIES_LINE = 1,
+    CUSTOM_KIND_SERIES_AREA = 2
+} CustomKind;
+
+#define TXXT_CUSTOM_MAGIC 0x54435854u  // "TXCT"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t kind;
+} CustomHeader;
+
+// One chart series: evenly spaced samples plus a downsampled vertex cache.
+// The cache is rebuilt only when the data revision or the element size changes,
+// so steady-state frames copy O(width) vertices regardless of sample count.
+typedef struct {
+    CustomHeader header;
+    Clay_Color color;
+    float values[TXXT_SERIES_MAX_POINTS];
+    uint32_t count;
+    float min_value;
+    float max_value;
+    uint32_t revision;
+
+    uint32_t cached_revision;
+    float cached_width;
+    float cached_height;
+    uint32_t vertex_count;
+    float vertices[TXXT_SERIES_MAX_VERTICES * 2];
+} ChartSeries;
+
+static ChartSeries chart_series[TXXT_MAX_SERIES] = {0};
+
+// The chart series a custom render command draws, or 0 if it is not one.
+static ChartSeries* custom_chart_series(const Clay_CustomRenderData* custom) {
+    const CustomHeader* header = (const CustomHeader*)custom->customData;
+    if (!header || header->magic != TXXT_CUSTOM_MAGIC ||
+        (header->kind != CUSTOM_KIND_SERIES_LINE && header->kind != CUSTOM_KIND_SERIES_AREA)) {
+        return 0;
+    }
+    return (ChartSeries*)custom->customData;
+}
+
+// Throughput is completions per sample interval: the completed total is
+// diffed against the previous sample.
+static struct {
+    double next_at;
+    uint32_t last_completed;
+    bool primed;
+} series_sampler = {0};
+
+// Measured token: a run of non-space bytes plus its trailing spaces, or a lone
+// '\n'. Widths come from Clay's measure cache, so layout reuses them as-is.
+typedef struct {
+    uint16_t start;
+    uint16_t length;
+    float width;
+} EditToken;
+
+typedef struct {
+    uint16_t first_token;
+    uint16_t token_count;
+    uint16_t start;
+    uint16_t end;
+} EditLine;
+
+// Gap-buffer text field. Edits only move the gap; the contiguous copy, tokens
+// and line breaks are refreshed at most once per frame (edit_field_sync), and
+// only tokens overlapping the bytes touched since the last sync are re-measured.
+typedef struct {
+    char buffer[TXXT_EDIT_FIELD_MAX];
+    uint32_t gap_start; // caret
+    uint32_t gap_end;
+    uint32_t limit;
+    uint32_t anchor;
+    bool multiline;
+
+    uint32_t revision;
+    uint32_t dirty_lo;   // first byte touched since the last sync
+    uint32_t dirty_tail; // bytes at the end untouched since the last sync
+
+    char text[TXXT_EDIT_FIELD_MAX + 1];
+    uint32_t length;
+    EditToken tokens[TXXT_EDIT_FIELD_MAX];
+    uint32_t token_count;
+    EditLine lines[TXXT_EDIT_FIELD_MAX + 1];
+    uint32_t line_count;
+    uint32_t synced_revision;
+    float synced_width;
+    float space_width;
+
+    // Caret/selection geometry, recomputed only when the caret, anchor or text move
+    bool geometry_valid;
+    uint32_t geometry_caret;
+    uint32_t geometry_anchor;
+    uint32_t caret_line;
+    float caret_x;
+    uint32_t anchor_line;
+    float anchor_x;
+    float scroll_x;
+    float scroll_y;
+} EditField;
+
+typedef struct {
+    EditField fields[TXXT_EDIT_FIELD_COUNT];
+    int32_t focus;
+    TaskStatus status;
+    Priority priority;
+    // Service the form names, set by validation (-1 = none).
+    int32_t service_index;
+    // Why the last submit was refused (0 = it wasn't), shown under the form.
+    const char* error;
+    bool submit_pending;
+    int32_t last_click_field;
+    double last_click_time;
+} EditForm;
+
+static EditForm edit_form = { .focus = -1, .last_click_field = -1 };
+static uint8_t edit_input_buffer[TXXT_EDIT_INPUT_MAX] = {0};
+static EditToken edit_token_scratch[TXXT_EDIT_FIELD_MAX] = {0};
+
+static const char* EDIT_PLACEHOLDERS[] = {"Title", "Description", "Service", "Due (YYYY-MM-DD)"};
+
+// Shared by rendering and measuring so both hit the same Clay cache entries.
+static inline Clay_TextElementConfig edit_text_config(Clay_Color color) {
+    return (Clay_TextElementConfig){
+        .fontSize = 14,
+        .fontId = FONT_ID_BODY_16,
+        .lineHeight = TXXT_EDIT_LINE_HEIGHT,
+        .wrapMode = CLAY_TEXT_WRAP_NONE,
+        .textColor = color
+    };
+}
+
 // Static strings for status/priority
 static const char* STATUS_STRINGS[] = {"Pending", "In Progress", "Completed"};
 static const char* PRIORITY_STRINGS[] = {"Low", "Medium", "High", "Urgent"};
@@ -190,6 +817,26 @@ Clay_Color GetPriorityColor(Priority p) {
 static inline uint8_t pulse_alpha(void);
 static inline bool string_equals(const char* a, const char* b);
 static int32_t find_first_task_for_service(int32_t service_index);
+static inline const char* intern_lookup(uint16_t handle);
+static Clay_String frame_u32_string(uint32_t value);
+static Clay_String frame_duration_string(float seconds);
+static int32_t dep_node_for_task(const Task* task);
+static bool dep_is_critical(int32_t node);
+static void dep_drop_task(const char* id);
+static const RecurWindow* recur_window(uint16_t first_day, uint16_t day_count);
+static bool recur_has_rules(void);
+static void recur_toggle_completed(uint16_t rule, uint16_t day);
+static Clay_String frame_day_string(uint16_t day);
+static void format_due_date(char* out, uint16_t day);
+static uint32_t task_list_view(uint32_t* out);
+static void export_begin(uint8_t delimiter);
+static inline uint32_t epoch_weekday(uint32_t day);
+static void edit_form_open(int32_t service_index);
+static void edit_form_click(int32_t field_index, Clay_Vector2 position);
+static bool edit_form_validate(void);
+static void edit_field_sync(EditField* field, float width, float height);
+static TaskDetail* task_detail_get(Task* task);
+static void task_detail_request(Task* task, bool urgent);
 
 // Helper to get status color
 Clay_Color GetStatusColor(TaskStatus s) {
@@ -224,14 +871,42 @@ void HandleClick(Clay_ElementId elementId, Clay_PointerData pointerInfo, void *u
             app_state.show_detail_panel = true;
             app_state.create_panel_visible = false;
         } else if (data->action_type == 1) {
-            app_state.show_create_modal = true;
             app_state.create_panel_visible = true;
             app_state.show_detail_panel = false;
+            edit_form_open(-1);
         } else if (data->action_type == 2) {
             app_state.show_detail_panel = false;
             app_state.selected_task_index = -1;
         } else if (data->action_type == 3) {
             app_state.filter_status = (FilterStatus)data->action_data;
+        } else if (data->action_type == 5) {
+            app_state.show_dashboard = !app_state.show_dashboard;
+        } else if (data->action_type == 11) {
+            dep_view_enabled = !dep_view_enabled;
+        } else if (data->action_type == 12) {
+            schedule_visible = !schedule_visible;
+        } else if (data->action_type == 13) {
+            int32_t first = (int32_t)schedule_first_day + data->action_data;
+            if (first >= 0 && first < (int32_t)(TXXT_DUE_NONE - TXXT_SCHEDULE_DAYS)) {
+                schedule_first_day = (uint16_t)first;
+            }
+        } else if (data->action_type == 14) {
+            recur_toggle_completed((uint16_t)data->task_index, (uint16_t)data->action_data);
+        } else if (data->action_type == 15) {
+            if (export_state.phase == EXPORT_IDLE) {
+                export_begin(',');
+            }
+        } else if (data->action_type == 6) {
+            edit_form_click(data->action_data, pointerInfo.position);
+        } else if (data->action_type == 7) {
+            edit_form.status = (TaskStatus)(((uint32_t)edit_form.status + 1u) % TXXT_STATUS_COUNT);
+        } else if (data->action_type == 8) {
+            edit_form.priority = (Priority)(((uint32_t)edit_form.priority + 1u) % TXXT_PRIORITY_COUNT);
+        } else if (data->action_type == 9) {
+            edit_form.submit_pending = edit_form_validate();
+        } else if (data->action_type == 10) {
+            app_state.create_panel_visible = false;
+            edit_form.focus = -1;
         } else if (data->action_type == 4) {
             int32_t service_index = data->action_data;
             app_state.selected_service_index = service_index;
@@ -248,10 +923,10 @@ void HandleClick(Clay_ElementId elementId, Clay_PointerData pointerInfo, void *u
 
             double dt = app_time_seconds - last_service_click_time;
             if (last_service_click_index == service_index && dt <= 0.35) {
-                app_state.show_create_modal = true;
                 app_state.create_panel_visible = true;
                 app_state.show_detail_panel = false;
                 app_state.pending_create_service_index = service_index;
+                edit_form_open(service_index);
             }
             last_service_click_index = service_index;
             last_service_click_time = app_time_seconds;
@@ -404,9 +1079,11 @@ void Sidebar(void) {
 // Task card component
 void TaskCard(Task* task, int index) {
     bool is_selected = (app_state.selected_task_index == index);
+    int32_t dep_node = dep_view_enabled ? dep_node_for_task(task) : -1;
+    bool is_critical = dep_is_critical(dep_node);
     Clay_Color card_bg = is_selected ? (Clay_Color){235, 245, 255, 255} :
                          (Clay_Hovered() ? (Clay_Color){250, 250, 252, 255} : COLOR_WHITE);
-    Clay_Color border_color = is_selected ? COLOR_PRIMARY : COLOR_BORDER;
+    Clay_Color border_color = is_selected ? COLOR_PRIMARY : (is_critical ? COLOR_PRIORITY_URGENT : COLOR_BORDER);
 
     CLAY(CLAY_IDI("TaskCard", index), {
         .layout = {
@@ -445,8 +1122,8 @@ void TaskCard(Task* task, int index) {
         }
 
         // Description preview
-        if (task->description[0] != '\0') {
-            CLAY_TEXT(make_string(task->description), CLAY_TEXT_CONFIG({
+        if (task->preview[0] != '\0') {
+            CLAY_TEXT(make_string(task->preview), CLAY_TEXT_CONFIG({
                 .fontSize = 14,
                 .fontId = FONT_ID_BODY_16,
                 .textColor = COLOR_TEXT_LIGHT
@@ -477,18 +1154,54 @@ void TaskCard(Task* task, int index) {
                 }));
             }
 
+            // Dependency depth, and whether the task is on the critical path
+            if (dep_node >= 0) {
+                CLAY_TEXT(CLAY_STRING("Depth"), CLAY_TEXT_CONFIG({
+                    .fontSize = 12,
+                    .fontId = FONT_ID_BODY_16,
+                    .textColor = COLOR_TEXT_LIGHT
+                }));
+                CLAY_TEXT(frame_u32_string(dep_graph.depth[dep_node]), CLAY_TEXT_CONFIG({
+                    .fontSize = 12,
+                    .fontId = FONT_ID_BODY_16,
+                    .textColor = COLOR_TEXT
+                }));
+                if (is_critical) {
+                    CLAY(CLAY_IDI("CriticalBadge", index), {
+                        .layout = {
+                            .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) },
+                            .padding = { 8, 8, 4, 4 }
+                        },
+                        .backgroundColor = COLOR_PRIORITY_URGENT,
+                        .cornerRadius = CLAY_CORNER_RADIUS(4)
+                    }) {
+                        CLAY_TEXT(CLAY_STRING("Critical path"), CLAY_TEXT_CONFIG({
+                            .fontSize = 12,
+                            .fontId = FONT_ID_BODY_16,
+                            .textColor = COLOR_TEXT_WHITE
+                        }));
+                    }
+                }
+            }
+
             // Spacer
             CLAY(CLAY_IDI("TaskCardSpacer", index), {
                 .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(1) } }
             }) {}
 
-            // Due date
+            // Due date, else the day it is scheduled on
             if (task->due_date[0] != '\0') {
                 CLAY_TEXT(make_string(task->due_date), CLAY_TEXT_CONFIG({
                     .fontSize = 12,
                     .fontId = FONT_ID_BODY_16,
                     .textColor = COLOR_TEXT_LIGHT
                 }));
+            } else if (task->scheduled_day != TXXT_DUE_NONE) {
+                CLAY_TEXT(frame_day_string(task->scheduled_day), CLAY_TEXT_CONFIG({
+                    .fontSize = 12,
+                    .fontId = FONT_ID_BODY_16,
+                    .textColor = COLOR_TEXT_LIGHT
+                }));
             }
         }
     }
@@ -545,6 +1258,89 @@ void TaskList(void) {
                 .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(1) } }
             }) {}
 
+            // Workload dashboard toggle
+            CLAY(CLAY_ID("DashboardBtn"), {
+                .layout = {
+                    .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIXED(40) },
+                    .padding = { 16, 16, 8, 8 },
+                    .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+                },
+                .backgroundColor = app_state.show_dashboard ? COLOR_PRIMARY : (Clay_Hovered() ? (Clay_Color){240, 240, 245, 255} : COLOR_WHITE),
+                .cornerRadius = CLAY_CORNER_RADIUS(6),
+                .border = { .width = { 1, 1, 1, 1 }, .color = COLOR_BORDER }
+            }) {
+                Clay_OnHover(HandleClick, AllocateClickData((ClickData){0, 5, 0}));
+                CLAY_TEXT(CLAY_STRING("Workload"), CLAY_TEXT_CONFIG({
+                    .fontSize = 14,
+                    .fontId = FONT_ID_BODY_16,
+                    .textColor = app_state.show_dashboard ? COLOR_TEXT_WHITE : COLOR_TEXT
+                }));
+            }
+
+            // Recurring schedule toggle; rules are console-fed until the server
+            // stores them, so the button only appears once some exist
+            if (recur_has_rules()) {
+                CLAY(CLAY_ID("ScheduleBtn"), {
+                    .layout = {
+                        .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIXED(40) },
+                        .padding = { 16, 16, 8, 8 },
+                        .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+                    },
+                    .backgroundColor = schedule_visible ? COLOR_PRIMARY : (Clay_Hovered() ? (Clay_Color){240, 240, 245, 255} : COLOR_WHITE),
+                    .cornerRadius = CLAY_CORNER_RADIUS(6),
+                    .border = { .width = { 1, 1, 1, 1 }, .color = COLOR_BORDER }
+                }) {
+                    Clay_OnHover(HandleClick, AllocateClickData((ClickData){0, 12, 0}));
+                    CLAY_TEXT(CLAY_STRING("Schedule"), CLAY_TEXT_CONFIG({
+                        .fontSize = 14,
+                        .fontId = FONT_ID_BODY_16,
+                        .textColor = schedule_visible ? COLOR_TEXT_WHITE : COLOR_TEXT
+                    }));
+                }
+            }
+
+            // Dependency order toggle; links are console-fed until the server
+            // stores them, so the button only appears once some exist
+            if (dep_graph.live_edges > 0) {
+                CLAY(CLAY_ID("DependencyBtn"), {
+                    .layout = {
+                        .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIXED(40) },
+                        .padding = { 16, 16, 8, 8 },
+                        .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+                    },
+                    .backgroundColor = dep_view_enabled ? COLOR_PRIMARY : (Clay_Hovered() ? (Clay_Color){240, 240, 245, 255} : COLOR_WHITE),
+                    .cornerRadius = CLAY_CORNER_RADIUS(6),
+                    .border = { .width = { 1, 1, 1, 1 }, .color = COLOR_BORDER }
+                }) {
+                    Clay_OnHover(HandleClick, AllocateClickData((ClickData){0, 11, 0}));
+                    CLAY_TEXT(CLAY_STRING("Dependencies"), CLAY_TEXT_CONFIG({
+                        .fontSize = 14,
+                        .fontId = FONT_ID_BODY_16,
+                        .textColor = dep_view_enabled ? COLOR_TEXT_WHITE : COLOR_TEXT
+                    }));
+                }
+            }
+
+            // Export the list as shown (CSV), drained by the host into a download
+            bool exporting = export_state.phase != EXPORT_IDLE;
+            CLAY(CLAY_ID("ExportBtn"), {
+                .layout = {
+                    .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIXED(40) },
+                    .padding = { 16, 16, 8, 8 },
+                    .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+                },
+                .backgroundColor = exporting ? COLOR_PRIMARY : (Clay_Hovered() ? (Clay_Color){240, 240, 245, 255} : COLOR_WHITE),
+                .cornerRadius = CLAY_CORNER_RADIUS(6),
+                .border = { .width = { 1, 1, 1, 1 }, .color = COLOR_BORDER }
+            }) {
+                Clay_OnHover(HandleClick, AllocateClickData((ClickData){0, 15, 0}));
+                CLAY_TEXT(exporting ? CLAY_STRING("Exporting") : CLAY_STRING("Export"), CLAY_TEXT_CONFIG({
+                    .fontSize = 14,
+                    .fontId = FONT_ID_BODY_16,
+                    .textColor = exporting ? COLOR_TEXT_WHITE : COLOR_TEXT
+                }));
+            }
+
             // Create button
             CLAY(CLAY_ID("CreateBtn"), {
                 .layout = {
@@ -603,33 +1399,28 @@ void TaskList(void) {
             },
             .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
         }) {
-            int shown = 0;
-            for (uint32_t i = 0; i < app_state.task_count; i++) {
+            // Cards within a margin of the viewport (last frame's layout) get
+            // their detail tier prefetched.
+            Clay_ElementData scroll = Clay_GetElementData(CLAY_ID("TaskScroll"));
+            float prefetch_top = scroll.boundingBox.y - TXXT_DETAIL_PREFETCH_MARGIN;
+            float prefetch_bottom = scroll.boundingBox.y + scroll.boundingBox.height + TXXT_DETAIL_PREFETCH_MARGIN;
+
+            uint32_t view[TXXT_MAX_TASKS];
+            uint32_t view_count = task_list_view(view);
+            for (uint32_t k = 0; k < view_count; k++) {
+                uint32_t i = view[k];
                 Task* task = &app_state.tasks[i];
+                TaskCard(task, i);
 
-                // Apply filter
-                bool show = false;
-                switch (app_state.filter_status) {
-                    case FILTER_ALL: show = true; break;
-                    case FILTER_PENDING: show = (task->status == STATUS_PENDING); break;
-                    case FILTER_IN_PROGRESS: show = (task->status == STATUS_IN_PROGRESS); break;
-                    case FILTER_COMPLETED: show = (task->status == STATUS_COMPLETED); break;
-                }
-
-                if (show && app_state.selected_service_index >= 0 &&
-                    app_state.selected_service_index < (int32_t)app_state.service_count) {
-                    const char* selected_name = app_state.services[app_state.selected_service_index].name;
-                    show = string_equals(task->service_name, selected_name);
-                }
-
-                if (show) {
-                    TaskCard(task, i);
-                    shown++;
+                Clay_ElementData card = Clay_GetElementData(CLAY_IDI("TaskCard", i));
+                if (scroll.found && card.found && card.boundingBox.y + card.boundingBox.height >= prefetch_top &&
+                    card.boundingBox.y <= prefetch_bottom) {
+                    task_detail_request(task, false);
                 }
             }
 
             // Empty state
-            if (shown == 0) {
+            if (view_count == 0) {
                 CLAY(CLAY_ID("EmptyState"), {
                     .layout = {
                         .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(200) },
@@ -647,6 +1438,119 @@ void TaskList(void) {
     }
 }
 
+// Canvas text field. Each token is its own text element so Clay's measure cache
+// hits for every word except the one being edited.
+static void EditFieldBox(uint32_t index, float height) {
+    EditField* field = &edit_form.fields[index];
+    bool focused = edit_form.focus == (int32_t)index;
+    Clay_ElementId box_id = CLAY_IDI("EditField", index);
+    Clay_ElementData box = Clay_GetElementData(box_id);
+    float inner_width = box.found ? box.boundingBox.width - 16.0f : 0.0f;
+    float inner_height = height - 12.0f;
+    edit_field_sync(field, inner_width, inner_height);
+
+    CLAY(box_id, {
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(height) },
+            .padding = { 8, 8, 6, 6 }
+        },
+        .backgroundColor = COLOR_WHITE,
+        .cornerRadius = CLAY_CORNER_RADIUS(4),
+        .border = { .width = CLAY_BORDER_OUTSIDE(1), .color = focused ? COLOR_PRIMARY : COLOR_BORDER },
+        .clip = { .horizontal = true, .vertical = true, .childOffset = { -field->scroll_x, -field->scroll_y } }
+    }) {
+        Clay_OnHover(HandleClick, AllocateClickData((ClickData){-1, 6, (int32_t)index}));
+
+        CLAY(CLAY_IDI("EditLines", index), {
+            .layout = {
+                .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) },
+                .layoutDirection = CLAY_TOP_TO_BOTTOM
+            }
+        }) {
+            if (field->length == 0 && !focused) {
+                CLAY_TEXT(make_string(EDIT_PLACEHOLDERS[index]), Clay__StoreTextElementConfig(edit_text_config(COLOR_TEXT_LIGHT)));
+            }
+            for (uint32_t l = 0; l < field->line_count; l++) {
+                EditLine* line = &field->lines[l];
+                CLAY(CLAY_IDI_LOCAL("EditLine", l), {
+                    .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIXED(TXXT_EDIT_LINE_HEIGHT) } }
+                }) {
+                    for (uint32_t t = 0; t < line->token_count; t++) {
+                        EditToken* token = &field->tokens[line->first_token + t];
+                        Clay_String text = { .length = token->length, .chars = &field->text[token->start] };
+                        CLAY_TEXT(text, Clay__StoreTextElementConfig(edit_text_config(COLOR_TEXT)));
+                    }
+                }
+            }
+
+            if (focused) {
+                // Selection: one highlight per covered line
+                uint32_t caret = field->gap_start;
+                if (field->anchor != caret) {
+                    bool forward = field->anchor < caret;
+                    uint32_t first = forward ? field->anchor_line : field->caret_line;
+                    uint32_t last = forward ? field->caret_line : field->anchor_line;
+                    float first_x = forward ? field->anchor_x : field->caret_x;
+                    float last_x = forward ? field->caret_x : field->anchor_x;
+                    for (uint32_t l = first; l <= last; l++) {
+                        float x0 = l == first ? first_x : 0.0f;
+                        float x1 = last_x;
+                        if (l != last) {
+                            // Whole rest of the line, plus a space so empty lines show
+                            const EditLine* line = &field->lines[l];
+                            x1 = field->space_width;
+                            for (uint32_t t = 0; t < line->token_count; t++) {
+                                x1 += field->tokens[line->first_token + t].width;
+                            }
+                        }
+                        CLAY(CLAY_IDI_LOCAL("EditSelection", l), {
+                            .layout = { .sizing = { CLAY_SIZING_FIXED(x1 - x0), CLAY_SIZING_FIXED(TXXT_EDIT_LINE_HEIGHT) } },
+                            .backgroundColor = (Clay_Color){59, 130, 246, 60},
+                            .floating = {
+                                .attachTo = CLAY_ATTACH_TO_PARENT,
+                                .offset = { x0, (float)(l * TXXT_EDIT_LINE_HEIGHT) },
+                                .pointerCaptureMode = CLAY_POINTER_CAPTURE_MODE_PASSTHROUGH,
+                                .clipTo = CLAY_CLIP_TO_ATTACHED_PARENT
+                            }
+                        }) {}
+                    }
+                }
+
+                CLAY(CLAY_IDI("EditCaret", index), {
+                    .layout = { .sizing = { CLAY_SIZING_FIXED(2), CLAY_SIZING_FIXED(TXXT_EDIT_LINE_HEIGHT) } },
+                    .backgroundColor = COLOR_PRIMARY,
+                    .floating = {
+                        .attachTo = CLAY_ATTACH_TO_PARENT,
+                        .offset = { field->caret_x, (float)(field->caret_line * TXXT_EDIT_LINE_HEIGHT) },
+                        .pointerCaptureMode = CLAY_POINTER_CAPTURE_MODE_PASSTHROUGH,
+                        .clipTo = CLAY_CLIP_TO_ATTACHED_PARENT
+                    }
+                }) {}
+            }
+        }
+    }
+}
+
+// Small clickable pill used by the create form (status/priority cycling, actions).
+static void FormChip(Clay_ElementId id, const char* label, Clay_Color color, Clay_Color hover_color, Clay_Color text_color, int32_t action_type) {
+    CLAY(id, {
+        .layout = {
+            .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIXED(32) },
+            .padding = { 12, 12, 0, 0 },
+            .childAlignment = { CLAY_ALIGN_X_CENTER, CLAY_ALIGN_Y_CENTER }
+        },
+        .backgroundColor = Clay_Hovered() ? hover_color : color,
+        .cornerRadius = CLAY_CORNER_RADIUS(4)
+    }) {
+        Clay_OnHover(HandleClick, AllocateClickData((ClickData){-1, action_type, 0}));
+        CLAY_TEXT(make_string(label), CLAY_TEXT_CONFIG({
+            .fontSize = 14,
+            .fontId = FONT_ID_BODY_16,
+            .textColor = text_color
+        }));
+    }
+}
+
 // Docked panel (details or create)
 void DockPanel(float height) {
     bool show_create = app_state.create_panel_visible;
@@ -658,6 +1562,11 @@ void DockPanel(float height) {
     }
 
     Task* task = show_detail ? &app_state.tasks[app_state.selected_task_index] : 0;
+    TaskDetail* detail = task ? task_detail_get(task) : 0;
+    if (task && !detail) {
+        task_detail_request(task, true);
+    }
+    const char* assigned_to = detail ? detail->assigned_to : (task ? intern_lookup(task->assignee_handle) : "");
 
     CLAY(CLAY_ID("DockPanel"), {
         .layout = {
@@ -686,6 +1595,15 @@ void DockPanel(float height) {
                 .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(1) } }
             }) {}
 
+            if (show_create) {
+                CLAY(CLAY_ID("DockFormActions"), {
+                    .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) }, .childGap = 8 }
+                }) {
+                    FormChip(CLAY_ID("DockCancelBtn"), "Cancel", COLOR_BG, (Clay_Color){235, 235, 242, 255}, COLOR_TEXT, 10);
+                    FormChip(CLAY_ID("DockCreateBtn"), "Create", COLOR_PRIMARY, COLOR_PRIMARY_HOVER, COLOR_TEXT_WHITE, 9);
+                }
+            }
+
             if (!show_create) {
                 CLAY(CLAY_ID("DockCloseBtn"), {
                     .layout = {
@@ -706,11 +1624,30 @@ void DockPanel(float height) {
         }
 
         if (show_create) {
-            CLAY_TEXT(CLAY_STRING("Fill in the form below. This panel stays docked so you can keep referencing the list."), CLAY_TEXT_CONFIG({
-                .fontSize = 13,
-                .fontId = FONT_ID_BODY_16,
-                .textColor = COLOR_TEXT_LIGHT
-            }));
+            EditFieldBox(TXXT_EDIT_FIELD_TITLE, 32);
+            EditFieldBox(TXXT_EDIT_FIELD_DESC, 12 + 3 * TXXT_EDIT_LINE_HEIGHT);
+            CLAY(CLAY_ID("DockFormRow"), {
+                .layout = {
+                    .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) },
+                    .childGap = 8
+                }
+            }) {
+                Clay_Color status_color = GetStatusColor(edit_form.status);
+                Clay_Color priority_color = GetPriorityColor(edit_form.priority);
+                FormChip(CLAY_ID("DockFormStatus"), STATUS_STRINGS[edit_form.status],
+                    status_color, status_color, COLOR_TEXT_WHITE, 7);
+                FormChip(CLAY_ID("DockFormPriority"), PRIORITY_STRINGS[edit_form.priority],
+                    priority_color, priority_color, COLOR_TEXT_WHITE, 8);
+                EditFieldBox(TXXT_EDIT_FIELD_SERVICE, 32);
+                EditFieldBox(TXXT_EDIT_FIELD_DUE, 32);
+            }
+            if (edit_form.error) {
+                CLAY_TEXT(make_string(edit_form.error), CLAY_TEXT_CONFIG({
+                    .fontSize = 12,
+                    .fontId = FONT_ID_BODY_16,
+                    .textColor = COLOR_PRIORITY_URGENT
+                }));
+            }
         }
 
         if (show_detail && task) {
@@ -747,7 +1684,8 @@ void DockPanel(float height) {
                     .fontId = FONT_ID_BODY_16,
                     .textColor = COLOR_TEXT_LIGHT
                 }));
-                CLAY_TEXT(make_string(task->description[0] ? task->description : "No description"), CLAY_TEXT_CONFIG({
+                const char* description = !detail ? "Loading..." : (detail->description[0] ? detail->description : "No description");
+                CLAY_TEXT(make_string(description), CLAY_TEXT_CONFIG({
                     .fontSize = 14,
                     .fontId = FONT_ID_BODY_16,
                     .textColor = COLOR_TEXT
@@ -858,7 +1796,7 @@ void DockPanel(float height) {
                 }
             }
 
-            if (task->assigned_to[0] != '\0') {
+            if (assigned_to[0] != '\0') {
                 CLAY(CLAY_ID("DockAssigned"), {
                     .layout = {
                         .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) },
@@ -871,7 +1809,7 @@ void DockPanel(float height) {
                         .fontId = FONT_ID_BODY_16,
                         .textColor = COLOR_TEXT_LIGHT
                     }));
-                    CLAY_TEXT(make_string(task->assigned_to), CLAY_TEXT_CONFIG({
+                    CLAY_TEXT(make_string(assigned_to), CLAY_TEXT_CONFIG({
                         .fontSize = 14,
                         .fontId = FONT_ID_BODY_16,
                         .textColor = COLOR_TEXT
@@ -882,43 +1820,349 @@ void DockPanel(float height) {
     }
 }
 
-// Login screen
-void LoginScreen(void) {
-    CLAY(CLAY_ID("LoginOuter"), {
+// Dashboard cell: fixed-width label or counter.
+static void DashboardCell(Clay_ElementId id, Clay_String text, float width, Clay_Color color) {
+    CLAY(id, {
         .layout = {
-            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
-            .childAlignment = { CLAY_ALIGN_X_CENTER, CLAY_ALIGN_Y_CENTER }
+            .sizing = { CLAY_SIZING_FIXED(width), CLAY_SIZING_FIXED(20) },
+            .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+        }
+    }) {
+        CLAY_TEXT(text, CLAY_TEXT_CONFIG({
+            .fontSize = 12,
+            .fontId = FONT_ID_BODY_16,
+            .textColor = color
+        }));
+    }
+}
+
+// Chart element: a single custom render command, whatever the sample count.
+static void ChartElement(Clay_ElementId id, uint32_t slot, float width, float height) {
+    ChartSeries* series = &chart_series[slot];
+    CLAY(id, {
+        .layout = { .sizing = { CLAY_SIZING_FIXED(width), CLAY_SIZING_FIXED(height) } },
+        .backgroundColor = (Clay_Color){248, 248, 252, 255},
+        .cornerRadius = CLAY_CORNER_RADIUS(4),
+        .custom = { .customData = series }
+    }) {}
+}
+
+// Workload dashboard. Every cell reads a precomputed counter (see Aggregates),
+// so cost scales with the number of assignees/services, never with task count.
+void WorkloadDashboard(void) {
+    CLAY(CLAY_ID("Dashboard"), {
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(220) },
+            .layoutDirection = CLAY_LEFT_TO_RIGHT,
+            .padding = { 24, 24, 16, 16 },
+            .childGap = 32
         },
-        .backgroundColor = COLOR_BG
+        .backgroundColor = COLOR_WHITE,
+        .border = { .width = { 0, 0, 0, 1 }, .color = COLOR_BORDER }
     }) {
-        CLAY(CLAY_ID("LoginBox"), {
+        // Assignee x status
+        CLAY(CLAY_ID("DashAssignees"), {
             .layout = {
-                .sizing = { CLAY_SIZING_FIXED(400), CLAY_SIZING_FIT(0) },
+                .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_GROW(0) },
                 .layoutDirection = CLAY_TOP_TO_BOTTOM,
-                .padding = { 32, 32, 32, 32 },
-                .childGap = 24,
-                .childAlignment = { .x = CLAY_ALIGN_X_CENTER }
+                .childGap = 2
             },
-            .backgroundColor = COLOR_WHITE,
-            .cornerRadius = CLAY_CORNER_RADIUS(12),
-            .border = { .width = { 1, 1, 1, 1 }, .color = COLOR_BORDER }
+            .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
         }) {
-            CLAY_TEXT(CLAY_STRING("Task Tracker"), CLAY_TEXT_CONFIG({
-                .fontSize = 32,
-                .fontId = FONT_ID_TITLE_32,
-                .textColor = COLOR_TEXT
-            }));
+            CLAY(CLAY_ID("DashAssigneeHeader"), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                DashboardCell(CLAY_IDI("DashAssigneeHead", 0), CLAY_STRING("Assignee"), 140, COLOR_TEXT_LIGHT);
+                for (uint32_t s = 0; s < TXXT_STATUS_COUNT; s++) {
+                    DashboardCell(CLAY_IDI("DashAssigneeHead", (int)(s + 1)), make_string(STATUS_STRINGS[s]), 80, GetStatusColor((TaskStatus)s));
+                }
+            }
+            for (uint32_t h = 0; h < intern_table.count; h++) {
+                const uint32_t* counts = aggregates.assignee_status[h];
+                if (counts[0] + counts[1] + counts[2] == 0) {
+                    continue;
+                }
+                CLAY(CLAY_IDI("DashAssigneeRow", (int)h), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                    const char* name = h == 0 ? "Unassigned" : intern_lookup((uint16_t)h);
+                    DashboardCell(CLAY_IDI("DashAssigneeName", (int)h), make_string(name), 140, COLOR_TEXT);
+                    for (uint32_t s = 0; s < TXXT_STATUS_COUNT; s++) {
+                        DashboardCell(CLAY_IDI("DashAssigneeCount", (int)(h * TXXT_STATUS_COUNT + s)), frame_u32_string(counts[s]), 80, COLOR_TEXT);
+                    }
+                }
+            }
+        }
 
-            CLAY_TEXT(CLAY_STRING("Sign in to continue"), CLAY_TEXT_CONFIG({
-                .fontSize = 14,
-                .fontId = FONT_ID_BODY_16,
-                .textColor = COLOR_TEXT_LIGHT
-            }));
+        // Service x priority, plus overdue
+        CLAY(CLAY_ID("DashServices"), {
+            .layout = {
+                .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_GROW(0) },
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .childGap = 2
+            },
+            .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
+        }) {
+            CLAY(CLAY_ID("DashServiceHeader"), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                DashboardCell(CLAY_IDI("DashServiceHead", 0), CLAY_STRING("Service"), 140, COLOR_TEXT_LIGHT);
+                for (uint32_t p = 0; p < TXXT_PRIORITY_COUNT; p++) {
+                    DashboardCell(CLAY_IDI("DashServiceHead", (int)(p + 1)), make_string(PRIORITY_STRINGS[p]), 56, GetPriorityColor((Priority)p));
+                }
+                DashboardCell(CLAY_IDI("DashServiceHead", (int)(TXXT_PRIORITY_COUNT + 1)), CLAY_STRING("Overdue"), 64, COLOR_PRIORITY_URGENT);
+            }
+            for (uint32_t h = 0; h < intern_table.count; h++) {
+                const uint32_t* counts = aggregates.service_priority[h];
+                if (counts[0] + counts[1] + counts[2] + counts[3] == 0) {
+                    continue;
+                }
+                CLAY(CLAY_IDI("DashServiceRow", (int)h), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                    const char* name = h == 0 ? "No service" : intern_lookup((uint16_t)h);
+                    DashboardCell(CLAY_IDI("DashServiceName", (int)h), make_string(name), 140, COLOR_TEXT);
+                    for (uint32_t p = 0; p < TXXT_PRIORITY_COUNT; p++) {
+                        DashboardCell(CLAY_IDI("DashServiceCount", (int)(h * TXXT_PRIORITY_COUNT + p)), frame_u32_string(counts[p]), 56, COLOR_TEXT);
+                    }
+                    DashboardCell(CLAY_IDI("DashServiceOverdue", (int)h), frame_u32_string(aggregates.service_overdue[h]), 64,
+                        aggregates.service_overdue[h] ? COLOR_PRIORITY_URGENT : COLOR_TEXT_LIGHT);
+                }
+            }
+        }
 
-            // Username input placeholder
-            CLAY(CLAY_ID("UsernameInput"), {
+        // Service lead/cycle time quantiles, streamed from task events (see CycleStats)
+        if (cycle_stats.service_count > 0) {
+            CLAY(CLAY_ID("DashCycle"), {
                 .layout = {
-                    .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(44) },
+                    .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_GROW(0) },
+                    .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                    .childGap = 2
+                },
+                .clip = { .vertical = true, .childOffset = Clay_GetScrollOffset() }
+            }) {
+                static const char* CYCLE_HEADINGS[] = { "Lead p50", "Lead p90", "Cycle p50", "Cycle p90" };
+                CLAY(CLAY_ID("DashCycleHeader"), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                    DashboardCell(CLAY_IDI("DashCycleHead", 0), CLAY_STRING("Service"), 140, COLOR_TEXT_LIGHT);
+                    DashboardCell(CLAY_IDI("DashCycleHead", 1), CLAY_STRING("Done"), 48, COLOR_TEXT_LIGHT);
+                    for (uint32_t c = 0; c < 4u; c++) {
+                        DashboardCell(CLAY_IDI("DashCycleHead", (int)(c + 2)), make_string(CYCLE_HEADINGS[c]), 64, COLOR_TEXT_LIGHT);
+                    }
+                }
+                for (uint32_t slot = 0; slot < cycle_stats.service_count; slot++) {
+                    const KllSketch* lead = &cycle_stats.sketches[slot][TXXT_CYCLE_LEAD];
+                    const KllSketch* cycle = &cycle_stats.sketches[slot][TXXT_CYCLE_CYCLE];
+                    uint16_t h = cycle_stats.slot_service[slot];
+                    CLAY(CLAY_IDI("DashCycleRow", (int)slot), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                        const char* name = h == 0 ? "No service" : intern_lookup(h);
+                        DashboardCell(CLAY_IDI("DashCycleName", (int)slot), make_string(name), 140, COLOR_TEXT);
+                        DashboardCell(CLAY_IDI("DashCycleDone", (int)slot), frame_u32_string(lead->n > cycle->n ? lead->n : cycle->n), 48, COLOR_TEXT);
+                        const KllSketch* columns[] = { lead, lead, cycle, cycle };
+                        for (uint32_t c = 0; c < 4u; c++) {
+                            Clay_ElementId id = CLAY_IDI("DashCycleValue", (int)(slot * 4u + c));
+                            if (columns[c]->n == 0) {
+                                DashboardCell(id, CLAY_STRING("-"), 64, COLOR_TEXT_LIGHT);
+                            } else {
+                                DashboardCell(id, frame_duration_string(c % 2u ? columns[c]->p90 : columns[c]->p50), 64, COLOR_TEXT);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Throughput / burndown series pushed by the host
+        if (chart_series[TXXT_SERIES_THROUGHPUT].count > 1 || chart_series[TXXT_SERIES_BURNDOWN].count > 1) {
+            CLAY(CLAY_ID("DashCharts"), {
+                .layout = {
+                    .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) },
+                    .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                    .childGap = 4
+                }
+            }) {
+                if (chart_series[TXXT_SERIES_THROUGHPUT].count > 1) {
+                    DashboardCell(CLAY_ID("DashThroughputLabel"), CLAY_STRING("Throughput"), 200, COLOR_TEXT_LIGHT);
+                    ChartElement(CLAY_ID("DashThroughputChart"), TXXT_SERIES_THROUGHPUT, 200, 60);
+                }
+                if (chart_series[TXXT_SERIES_BURNDOWN].count > 1) {
+                    DashboardCell(CLAY_ID("DashBurndownLabel"), CLAY_STRING("Burndown"), 200, COLOR_TEXT_LIGHT);
+                    ChartElement(CLAY_ID("DashBurndownChart"), TXXT_SERIES_BURNDOWN, 200, 60);
+                }
+            }
+        }
+
+        // Totals
+        CLAY(CLAY_ID("DashTotals"), {
+            .layout = {
+                .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) },
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .childGap = 2
+            }
+        }) {
+            for (uint32_t s = 0; s < TXXT_STATUS_COUNT; s++) {
+                CLAY(CLAY_IDI("DashTotalRow", (int)s), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                    DashboardCell(CLAY_IDI("DashTotalLabel", (int)s), make_string(STATUS_STRINGS[s]), 90, COLOR_TEXT_LIGHT);
+                    DashboardCell(CLAY_IDI("DashTotalCount", (int)s), frame_u32_string(aggregates.status_total[s]), 56, COLOR_TEXT);
+                }
+            }
+            CLAY(CLAY_IDI("DashTotalRow", (int)TXXT_STATUS_COUNT), { .layout = { .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIT(0) } } }) {
+                DashboardCell(CLAY_IDI("DashTotalLabel", (int)TXXT_STATUS_COUNT), CLAY_STRING("Overdue"), 90, COLOR_PRIORITY_URGENT);
+                DashboardCell(CLAY_IDI("DashTotalCount", (int)TXXT_STATUS_COUNT), frame_u32_string(aggregates.overdue_total), 56, COLOR_PRIORITY_URGENT);
+            }
+        }
+    }
+}
+
+// Login screen
+static void ScheduleNavButton(Clay_ElementId id, Clay_String label, int32_t days) {
+    CLAY(id, {
+        .layout = {
+            .sizing = { CLAY_SIZING_FIT(0), CLAY_SIZING_FIXED(24) },
+            .padding = { 10, 10, 4, 4 },
+            .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+        },
+        .backgroundColor = Clay_Hovered() ? (Clay_Color){240, 240, 245, 255} : COLOR_WHITE,
+        .cornerRadius = CLAY_CORNER_RADIUS(4),
+        .border = { .width = { 1, 1, 1, 1 }, .color = COLOR_BORDER }
+    }) {
+        Clay_OnHover(HandleClick, AllocateClickData((ClickData){0, 13, days}));
+        CLAY_TEXT(label, CLAY_TEXT_CONFIG({
+            .fontSize = 12,
+            .fontId = FONT_ID_BODY_16,
+            .textColor = COLOR_TEXT
+        }));
+    }
+}
+
+// Recurring-task strip: one column per visible day. Only this window's
+// occurrences are generated (see RecurStore), and only when it or the
+// rules change.
+void RecurringSchedule(void) {
+    if (schedule_first_day == TXXT_DUE_NONE) {
+        schedule_first_day = (uint16_t)(aggregates.today - epoch_weekday(aggregates.today));
+    }
+    const RecurWindow* window = recur_window(schedule_first_day, TXXT_SCHEDULE_DAYS);
+
+    CLAY(CLAY_ID("Schedule"), {
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) },
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .padding = { 24, 24, 12, 12 },
+            .childGap = 8
+        },
+        .backgroundColor = COLOR_WHITE,
+        .border = { .width = { 0, 0, 0, 1 }, .color = COLOR_BORDER }
+    }) {
+        CLAY(CLAY_ID("ScheduleHeader"), {
+            .layout = {
+                .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) },
+                .childGap = 8,
+                .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+            }
+        }) {
+            CLAY_TEXT(CLAY_STRING("Recurring"), CLAY_TEXT_CONFIG({
+                .fontSize = 14,
+                .fontId = FONT_ID_BODY_16,
+                .textColor = COLOR_TEXT
+            }));
+            ScheduleNavButton(CLAY_ID("SchedulePrev"), CLAY_STRING("< Week"), -7);
+            ScheduleNavButton(CLAY_ID("ScheduleNext"), CLAY_STRING("Week >"), 7);
+        }
+
+        CLAY(CLAY_ID("ScheduleDays"), {
+            .layout = {
+                .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) },
+                .childGap = 4
+            }
+        }) {
+            for (uint32_t d = 0; d < window->day_count; d++) {
+                uint16_t day = (uint16_t)(window->first_day + d);
+                bool is_today = day == aggregates.today;
+                CLAY(CLAY_IDI("ScheduleDay", (int)d), {
+                    .layout = {
+                        .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) },
+                        .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                        .padding = { 4, 4, 4, 4 },
+                        .childGap = 2
+                    },
+                    .backgroundColor = is_today ? (Clay_Color){235, 245, 255, 255} : (Clay_Color){248, 248, 252, 255},
+                    .cornerRadius = CLAY_CORNER_RADIUS(4),
+                    .clip = { .horizontal = true }
+                }) {
+                    CLAY_TEXT(frame_day_string(day), CLAY_TEXT_CONFIG({
+                        .fontSize = 12,
+                        .fontId = FONT_ID_BODY_16,
+                        .textColor = is_today ? COLOR_PRIMARY : COLOR_TEXT_LIGHT
+                    }));
+                    uint32_t begin = window->day_start[d];
+                    uint32_t end = window->day_start[d + 1u];
+                    for (uint32_t i = begin; i < end && i < begin + TXXT_SCHEDULE_ITEMS_PER_DAY; i++) {
+                        const RecurOccurrence* occurrence = &window->items[i];
+                        const RecurRule* rule = &recur_store.rules[occurrence->rule];
+                        bool done = occurrence->state == RECUR_OCC_COMPLETED;
+                        CLAY(CLAY_IDI("ScheduleItem", (int)(d * TXXT_SCHEDULE_ITEMS_PER_DAY + (i - begin))), {
+                            .layout = {
+                                .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(20) },
+                                .padding = { 4, 4, 0, 0 },
+                                .childAlignment = { .y = CLAY_ALIGN_Y_CENTER }
+                            },
+                            .backgroundColor = Clay_Hovered() ? (Clay_Color){235, 235, 242, 255} : COLOR_WHITE,
+                            .cornerRadius = CLAY_CORNER_RADIUS(3),
+                            .border = { .width = { 2, 0, 0, 0 }, .color = done ? COLOR_STATUS_COMPLETED : GetPriorityColor((Priority)rule->priority) }
+                        }) {
+                            Clay_OnHover(HandleClick, AllocateClickData((ClickData){occurrence->rule, 14, occurrence->original_day}));
+                            CLAY_TEXT(make_string(rule->title), CLAY_TEXT_CONFIG({
+                                .fontSize = 12,
+                                .fontId = FONT_ID_BODY_16,
+                                .textColor = done ? COLOR_TEXT_LIGHT : (occurrence->moved ? COLOR_PRIMARY : COLOR_TEXT),
+                                .wrapMode = CLAY_TEXT_WRAP_NONE
+                            }));
+                        }
+                    }
+                    if (end - begin > TXXT_SCHEDULE_ITEMS_PER_DAY) {
+                        CLAY(CLAY_IDI("ScheduleMore", (int)d), { .layout = { .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIT(0) }, .childGap = 4 } }) {
+                            CLAY_TEXT(CLAY_STRING("+"), CLAY_TEXT_CONFIG({ .fontSize = 12, .fontId = FONT_ID_BODY_16, .textColor = COLOR_TEXT_LIGHT }));
+                            CLAY_TEXT(frame_u32_string(end - begin - TXXT_SCHEDULE_ITEMS_PER_DAY), CLAY_TEXT_CONFIG({
+                                .fontSize = 12,
+                                .fontId = FONT_ID_BODY_16,
+                                .textColor = COLOR_TEXT_LIGHT
+                            }));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void LoginScreen(void) {
+    CLAY(CLAY_ID("LoginOuter"), {
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+            .childAlignment = { CLAY_ALIGN_X_CENTER, CLAY_ALIGN_Y_CENTER }
+        },
+        .backgroundColor = COLOR_BG
+    }) {
+        CLAY(CLAY_ID("LoginBox"), {
+            .layout = {
+                .sizing = { CLAY_SIZING_FIXED(400), CLAY_SIZING_FIT(0) },
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+                .padding = { 32, 32, 32, 32 },
+                .childGap = 24,
+                .childAlignment = { .x = CLAY_ALIGN_X_CENTER }
+            },
+            .backgroundColor = COLOR_WHITE,
+            .cornerRadius = CLAY_CORNER_RADIUS(12),
+            .border = { .width = { 1, 1, 1, 1 }, .color = COLOR_BORDER }
+        }) {
+            CLAY_TEXT(CLAY_STRING("Task Tracker"), CLAY_TEXT_CONFIG({
+                .fontSize = 32,
+                .fontId = FONT_ID_TITLE_32,
+                .textColor = COLOR_TEXT
+            }));
+
+            CLAY_TEXT(CLAY_STRING("Sign in to continue"), CLAY_TEXT_CONFIG({
+                .fontSize = 14,
+                .fontId = FONT_ID_BODY_16,
+                .textColor = COLOR_TEXT_LIGHT
+            }));
+
+            // Username input placeholder
+            CLAY(CLAY_ID("UsernameInput"), {
+                .layout = {
+                    .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(44) },
                     .padding = { 12, 12, 10, 10 }
                 },
                 .backgroundColor = (Clay_Color){250, 250, 252, 255},
@@ -971,6 +2215,10 @@ void LoginScreen(void) {
 // Main app layout
 void MainLayout(void) {
     float dock_height = (app_state.create_panel_visible || app_state.show_detail_panel) ? (float)(window_height * 0.33f) : 0.0f;
+    if (app_state.create_panel_visible && dock_height < 260.0f) {
+        // Room for the in-canvas create form
+        dock_height = 260.0f;
+    }
 
     CLAY(CLAY_ID("MainContainer"), {
         .layout = {
@@ -985,6 +2233,12 @@ void MainLayout(void) {
                 .layoutDirection = CLAY_TOP_TO_BOTTOM
             }
         }) {
+            if (app_state.show_dashboard) {
+                WorkloadDashboard();
+            }
+            if (schedule_visible && recur_has_rules()) {
+                RecurringSchedule();
+            }
             TaskList();
             DockPanel(dock_height);
         }
@@ -1083,107 +2337,3431 @@ static int32_t find_first_task_for_service(int32_t service_index) {
         return -1;
     }
 
-    const char* name = app_state.services[service_index].name;
-    for (uint32_t i = 0; i < app_state.task_count; i++) {
-        if (string_equals(app_state.tasks[i].service_name, name)) {
-            return (int32_t)i;
-        }
+    const char* name = app_state.services[service_index].name;
+    for (uint32_t i = 0; i < app_state.task_count; i++) {
+        if (string_equals(app_state.tasks[i].service_name, name)) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+static inline uint8_t pulse_alpha(void) {
+    if (data_pulse_remaining <= 0.0f || data_pulse_duration <= 0.0f) {
+        return 0;
+    }
+    float t = data_pulse_remaining / data_pulse_duration;
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    float a = 30.0f + (1.0f - t) * 140.0f;
+    if (a < 0.0f) a = 0.0f;
+    if (a > 255.0f) a = 255.0f;
+    return (uint8_t)a;
+}
+
+static Clay_String frame_u32_string(uint32_t value) {
+    char digits[10];
+    uint32_t n = 0;
+    do {
+        digits[n++] = (char)('0' + (value % 10u));
+        value /= 10u;
+    } while (value != 0 && n < sizeof(digits));
+
+    char* out = (char*)((uint8_t*)frame_arena.memory + frame_arena.offset);
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = digits[n - 1 - i];
+    }
+    // Keep the arena 4-byte aligned for the ClickData allocations that follow.
+    frame_arena.offset += (n + 3u) & ~3u;
+    return (Clay_String){ .length = (int32_t)n, .chars = out };
+}
+
+// "Mon 03-16" for an epoch day.
+static Clay_String frame_day_string(uint16_t day) {
+    static const char WEEKDAYS[] = "MonTueWedThuFriSatSun";
+    char date[11];
+    format_due_date(date, day);
+    char* out = (char*)((uint8_t*)frame_arena.memory + frame_arena.offset);
+    const char* weekday = WEEKDAYS + epoch_weekday(day) * 3u;
+    out[0] = weekday[0];
+    out[1] = weekday[1];
+    out[2] = weekday[2];
+    out[3] = ' ';
+    for (uint32_t i = 0; i < 5u; i++) {
+        out[4 + i] = date[5 + i];
+    }
+    frame_arena.offset += 12u;
+    return (Clay_String){ .length = 9, .chars = out };
+}
+
+// Duration in the largest unit that keeps it readable: "42s", "3.5m", "2.0h", "1.5d".
+static Clay_String frame_duration_string(float seconds) {
+    static const float UNIT_SECONDS[] = { 1.0f, 60.0f, 3600.0f, 86400.0f };
+    static const char UNIT_SUFFIX[] = { 's', 'm', 'h', 'd' };
+    uint32_t unit = 0;
+    while (unit < 3u && seconds >= UNIT_SECONDS[unit + 1u]) {
+        unit++;
+    }
+    uint32_t tenths = (uint32_t)(seconds / UNIT_SECONDS[unit] * 10.0f + 0.5f);
+
+    char* out = (char*)((uint8_t*)frame_arena.memory + frame_arena.offset);
+    char digits[10];
+    uint32_t n = 0;
+    uint32_t whole = unit == 0 ? (tenths + 5u) / 10u : tenths / 10u;
+    do {
+        digits[n++] = (char)('0' + (whole % 10u));
+        whole /= 10u;
+    } while (whole != 0 && n < sizeof(digits));
+    uint32_t length = 0;
+    while (n > 0) {
+        out[length++] = digits[--n];
+    }
+    if (unit > 0) {
+        out[length++] = '.';
+        out[length++] = (char)('0' + tenths % 10u);
+    }
+    out[length++] = UNIT_SUFFIX[unit];
+    frame_arena.offset += (length + 3u) & ~3u;
+    return (Clay_String){ .length = (int32_t)length, .chars = out };
+}
+
+static uint32_t hash_fnv1a(const char* str) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; str && str[i]; i++) {
+        hash ^= (uint8_t)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns the handle for str, inserting it on first sight.
+// Empty strings map to handle 0; so does anything arriving once the table is
+// full, which is counted in intern_table.overflowed.
+static uint16_t intern_string(const char* str) {
+    if (!str || str[0] == '\0') {
+        return 0;
+    }
+
+    uint32_t hash = hash_fnv1a(str);
+    uint32_t slot = hash & (TXXT_INTERN_SLOTS - 1u);
+    for (uint32_t probe = 0; probe < TXXT_INTERN_SLOTS; probe++) {
+        uint16_t handle = intern_table.slots[slot];
+        if (handle == 0) {
+            if (intern_table.count >= TXXT_INTERN_MAX) {
+                intern_table.overflowed++;
+                return 0;
+            }
+            handle = (uint16_t)intern_table.count++;
+            intern_table.hashes[handle] = hash;
+            copy_fixed_string(intern_table.strings[handle], TXXT_INTERN_STR_MAX, (const uint8_t*)str, TXXT_INTERN_STR_MAX);
+            intern_table.slots[slot] = handle;
+            return handle;
+        }
+        if (intern_table.hashes[handle] == hash && string_equals(intern_table.strings[handle], str)) {
+            return handle;
+        }
+        slot = (slot + 1u) & (TXXT_INTERN_SLOTS - 1u);
+    }
+    return 0;
+}
+
+// Handle for str if it is already interned, else 0. Never inserts.
+static uint16_t intern_find(const char* str) {
+    if (!str || str[0] == '\0') {
+        return 0;
+    }
+    uint32_t hash = hash_fnv1a(str);
+    uint32_t slot = hash & (TXXT_INTERN_SLOTS - 1u);
+    for (uint32_t probe = 0; probe < TXXT_INTERN_SLOTS; probe++) {
+        uint16_t handle = intern_table.slots[slot];
+        if (handle == 0) {
+            return 0;
+        }
+        if (intern_table.hashes[handle] == hash && string_equals(intern_table.strings[handle], str)) {
+            return handle;
+        }
+        slot = (slot + 1u) & (TXXT_INTERN_SLOTS - 1u);
+    }
+    return 0;
+}
+
+static inline const char* intern_lookup(uint16_t handle) {
+    if (handle == 0 || handle >= intern_table.count) {
+        return "";
+    }
+    return intern_table.strings[handle];
+}
+
+// Parse "YYYY-MM-DD" into epoch days. Anything else is TXXT_DUE_NONE.
+static uint16_t parse_due_day(const char* s) {
+    if (!s) {
+        return TXXT_DUE_NONE;
+    }
+    for (uint32_t i = 0; i < 10; i++) {
+        bool dash = (i == 4 || i == 7);
+        if (dash ? s[i] != '-' : (s[i] < '0' || s[i] > '9')) {
+            return TXXT_DUE_NONE;
+        }
+    }
+
+    int32_t y = (s[0] - '0') * 1000 + (s[1] - '0') * 100 + (s[2] - '0') * 10 + (s[3] - '0');
+    int32_t m = (s[5] - '0') * 10 + (s[6] - '0');
+    int32_t d = (s[8] - '0') * 10 + (s[9] - '0');
+    if (m < 1 || m > 12 || d < 1 || d > 31) {
+        return TXXT_DUE_NONE;
+    }
+
+    // Days from civil (proleptic Gregorian), shifted so 1970-01-01 = 0.
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    int32_t yoe = y - era * 400;
+    int32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int32_t days = era * 146097 + doe - 719468;
+    if (days < 0 || days >= (int32_t)TXXT_DUE_NONE) {
+        return TXXT_DUE_NONE;
+    }
+    return (uint16_t)days;
+}
+
+static inline uint32_t task_status_slot(const Task* task) {
+    return (uint32_t)task->status < TXXT_STATUS_COUNT ? (uint32_t)task->status : 0u;
+}
+
+static inline uint32_t task_priority_slot(const Task* task) {
+    return (uint32_t)task->priority < TXXT_PRIORITY_COUNT ? (uint32_t)task->priority : 0u;
+}
+
+static inline bool task_is_overdue(const Task* task) {
+    return task->due_day != TXXT_DUE_NONE && task->due_day < aggregates.today &&
+        task->status != STATUS_COMPLETED;
+}
+
+// Add (delta = 1) or remove (delta = -1) one task's contribution to every counter.
+static void aggregates_apply(const Task* task, int32_t delta) {
+    uint32_t d = (uint32_t)delta;
+    uint32_t status = task_status_slot(task);
+
+    aggregates.assignee_status[task->assignee_handle][status] += d;
+    aggregates.service_priority[task->service_handle][task_priority_slot(task)] += d;
+    aggregates.status_total[status] += d;
+
+    if (task_is_overdue(task)) {
+        aggregates.service_overdue[task->service_handle] += d;
+        aggregates.overdue_total += d;
+    }
+}
+
+// Full recount. Only used on bulk reload and when the day rolls over.
+static void aggregates_rebuild(void) {
+    uint16_t today = aggregates.today;
+    aggregates = (Aggregates){ .today = today };
+    for (uint32_t i = 0; i < app_state.task_count; i++) {
+        aggregates_apply(&app_state.tasks[i], 1);
+    }
+}
+
+// ── Cycle-time analytics (see CycleStats) ──────────────────────
+
+static uint32_t cycle_random_bit(void) {
+    uint32_t x = cycle_stats.rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    cycle_stats.rng = x;
+    return x & 1u;
+}
+
+static void sort_floats(float* values, uint32_t count) {
+    for (uint32_t i = 1; i < count; i++) {
+        float value = values[i];
+        uint32_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+// Halve a full level: every other item (random parity) survives, with
+// double weight, merged into the sorted level above. Cascades upwards.
+static void kll_compact(KllSketch* sketch, uint32_t level) {
+    float* items = sketch->items[level];
+    uint32_t count = sketch->count[level];
+    if (level == 0) {
+        sort_floats(items, count);
+    }
+    sketch->count[level] = 0;
+    if (level + 1u >= TXXT_KLL_LEVELS) {
+        return; // saturated: the top level's mass is dropped
+    }
+
+    float* above = sketch->items[level + 1u];
+    uint32_t above_count = sketch->count[level + 1u];
+    float merged[TXXT_KLL_LEVEL_CAPACITY];
+    uint32_t n = 0;
+    uint32_t a = 0;
+    uint32_t b = cycle_random_bit();
+    while (a < above_count || b < count) {
+        if (b >= count || (a < above_count && above[a] <= items[b])) {
+            merged[n++] = above[a++];
+        } else {
+            merged[n++] = items[b];
+            b += 2u;
+        }
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        above[i] = merged[i];
+    }
+    sketch->count[level + 1u] = (uint8_t)n;
+    if (n == TXXT_KLL_LEVEL_CAPACITY) {
+        kll_compact(sketch, level + 1u);
+    }
+}
+
+// Walk all levels in value order (a merge over the sorted levels) and pick
+// the values at 50% and 90% of the total weight.
+static void kll_refresh_quantiles(KllSketch* sketch) {
+    float level0[TXXT_KLL_LEVEL_CAPACITY];
+    uint32_t total = 0;
+    uint32_t head[TXXT_KLL_LEVELS] = {0};
+    for (uint32_t i = 0; i < sketch->count[0]; i++) {
+        level0[i] = sketch->items[0][i];
+    }
+    sort_floats(level0, sketch->count[0]);
+    for (uint32_t h = 0; h < TXXT_KLL_LEVELS; h++) {
+        total += (uint32_t)sketch->count[h] << h;
+    }
+
+    bool have_p50 = false;
+    uint32_t seen = 0;
+    while (total > 0) {
+        int32_t best = -1;
+        float best_value = 0.0f;
+        for (uint32_t h = 0; h < TXXT_KLL_LEVELS; h++) {
+            if (head[h] >= sketch->count[h]) {
+                continue;
+            }
+            float value = h == 0 ? level0[head[0]] : sketch->items[h][head[h]];
+            if (best < 0 || value < best_value) {
+                best = (int32_t)h;
+                best_value = value;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        head[best]++;
+        seen += 1u << best;
+        if (!have_p50 && seen * 2u >= total) {
+            sketch->p50 = best_value;
+            have_p50 = true;
+        }
+        if (seen * 10u >= total * 9u) {
+            sketch->p90 = best_value;
+            break;
+        }
+    }
+}
+
+static void kll_insert(KllSketch* sketch, float value) {
+    sketch->items[0][sketch->count[0]++] = value;
+    sketch->n++;
+    if (sketch->count[0] == TXXT_KLL_LEVEL_CAPACITY) {
+        kll_compact(sketch, 0);
+    }
+    kll_refresh_quantiles(sketch);
+}
+
+// Task UUIDs are v4 (random), so their first bytes hash well enough as they are.
+static inline uint32_t uuid_prefix32(const uint8_t* id) {
+    return (uint32_t)id[0] | ((uint32_t)id[1] << 8) | ((uint32_t)id[2] << 16) | ((uint32_t)id[3] << 24);
+}
+
+static inline uint32_t cycle_track_home(const uint8_t* id) {
+    return uuid_prefix32(id) & (TXXT_CYCLE_TRACK_SLOTS - 1u);
+}
+
+// Find the task's entry, inserting a blank one if asked and there is room
+// (the table stays at most 3/4 full so probes stay short).
+static CycleTrack* cycle_track_find(const uint8_t* id, bool insert) {
+    uint32_t slot = cycle_track_home(id);
+    while (cycle_stats.tracks[slot].used) {
+        uint32_t same = 0;
+        while (same < 16u && cycle_stats.tracks[slot].id[same] == id[same]) {
+            same++;
+        }
+        if (same == 16u) {
+            return &cycle_stats.tracks[slot];
+        }
+        slot = (slot + 1u) & (TXXT_CYCLE_TRACK_SLOTS - 1u);
+    }
+    if (!insert || cycle_stats.tracked >= TXXT_CYCLE_TRACK_SLOTS * 3u / 4u) {
+        return 0;
+    }
+    CycleTrack* track = &cycle_stats.tracks[slot];
+    *track = (CycleTrack){ .used = true, .staged_at = -1.0, .scheduled_at = -1.0 };
+    for (uint32_t i = 0; i < 16u; i++) {
+        track->id[i] = id[i];
+    }
+    cycle_stats.tracked++;
+    return track;
+}
+
+// Remove with backward shift, so the table never needs tombstones.
+static void cycle_track_remove(CycleTrack* track) {
+    const uint32_t mask = TXXT_CYCLE_TRACK_SLOTS - 1u;
+    uint32_t hole = (uint32_t)(track - cycle_stats.tracks);
+    cycle_stats.tracks[hole].used = false;
+    cycle_stats.tracked--;
+    for (uint32_t i = (hole + 1u) & mask; cycle_stats.tracks[i].used; i = (i + 1u) & mask) {
+        uint32_t home = cycle_track_home(cycle_stats.tracks[i].id);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            cycle_stats.tracks[hole] = cycle_stats.tracks[i];
+            cycle_stats.tracks[i].used = false;
+            hole = i;
+        }
+    }
+}
+
+// Sketch slot for a service, assigned on its first completion (NULL once
+// every slot is taken).
+static int32_t cycle_service_slot(uint16_t service_handle) {
+    uint32_t slot = cycle_stats.service_slot[service_handle];
+    if (slot == 0) {
+        if (cycle_stats.service_count >= TXXT_CYCLE_SERVICES) {
+            return -1;
+        }
+        slot = ++cycle_stats.service_count;
+        cycle_stats.service_slot[service_handle] = (uint8_t)slot;
+        cycle_stats.slot_service[slot - 1u] = service_handle;
+    }
+    return (int32_t)slot - 1;
+}
+
+// Feed one applied wire event: stamp stage entries, and turn a completion
+// into lead/cycle durations for the task's service. Replayed events only
+// unstamp or drop tracks.
+static void cycle_stats_apply(const uint8_t* event, const Task* task) {
+    const uint8_t* id = event + 9;
+    double now = app_time_seconds;
+    CycleTrack* track;
+    uint64_t revision = 0;
+    for (uint32_t i = 0; i < 8u; i++) {
+        revision |= (uint64_t)event[1 + i] << (8u * i);
+    }
+    bool replayed = cycle_stats.replay_horizon > 0 && revision <= cycle_stats.replay_horizon;
+    switch (event[0]) {
+        case TXXT_WIRE_TASK_CREATED: {
+            if (replayed) {
+                break;
+            }
+            uint8_t wire_status = event[9 + 16]; // 0 staged, 1 scheduled, 2 active, 3 completed
+            // A repeated CREATED (resync) keeps the stamps already taken.
+            if (wire_status < 3u && (track = cycle_track_find(id, true))) {
+                if (track->staged_at < 0.0) {
+                    track->staged_at = now;
+                }
+                if (wire_status >= 1u && track->scheduled_at < 0.0) {
+                    track->scheduled_at = now;
+                }
+            }
+            break;
+        }
+        case TXXT_WIRE_TASK_SCHEDULED:
+            if (!replayed && (track = cycle_track_find(id, true)) && track->scheduled_at < 0.0) {
+                track->scheduled_at = now;
+            }
+            break;
+        case TXXT_WIRE_TASK_UNSCHEDULED:
+            if ((track = cycle_track_find(id, false))) {
+                track->scheduled_at = -1.0;
+            }
+            break;
+        case TXXT_WIRE_TASK_COMPLETED: {
+            if (!(track = cycle_track_find(id, false))) {
+                break;
+            }
+            int32_t slot = replayed ? -1 : cycle_service_slot(task->service_handle);
+            if (slot >= 0) {
+                KllSketch* sketches = cycle_stats.sketches[slot];
+                if (track->staged_at >= 0.0) {
+                    kll_insert(&sketches[TXXT_CYCLE_LEAD], (float)(now - track->staged_at));
+                }
+                if (track->scheduled_at >= 0.0) {
+                    kll_insert(&sketches[TXXT_CYCLE_CYCLE], (float)(now - track->scheduled_at));
+                }
+            }
+            cycle_track_remove(track);
+            break;
+        }
+        case TXXT_WIRE_TASK_DELETED:
+            if ((track = cycle_track_find(id, false))) {
+                cycle_track_remove(track);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// ── Dependency graph (see DepGraph) ────────────────────────────
+
+// 16 wire bytes from a canonical UUID string (inverse of format_uuid).
+static bool parse_uuid(const char* text, uint8_t* out) {
+    uint32_t at = 0;
+    for (uint32_t i = 0; i < 16u; i++) {
+        if ((i == 4 || i == 6 || i == 8 || i == 10) && text[at++] != '-') {
+            return false;
+        }
+        uint8_t byte = 0;
+        for (uint32_t k = 0; k < 2u; k++) {
+            char c = text[at++];
+            uint8_t nibble;
+            if (c >= '0' && c <= '9') {
+                nibble = (uint8_t)(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                nibble = (uint8_t)(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                nibble = (uint8_t)(c - 'A' + 10);
+            } else {
+                return false;
+            }
+            byte = (uint8_t)((byte << 4) | nibble);
+        }
+        out[i] = byte;
+    }
+    return text[at] == '\0';
+}
+
+// Node for a task UUID, optionally created. New nodes have no links, so
+// they simply go last in the topological order.
+static int32_t dep_node_find(const uint8_t* id, bool insert) {
+    DepGraph* g = &dep_graph;
+    uint32_t slot = uuid_prefix32(id) & (TXXT_DEP_HASH_SLOTS - 1u);
+    while (g->hash[slot] != 0) {
+        uint32_t node = g->hash[slot] - 1u;
+        uint32_t same = 0;
+        while (same < 16u && g->node_id[node][same] == id[same]) {
+            same++;
+        }
+        if (same == 16u) {
+            return (int32_t)node;
+        }
+        slot = (slot + 1u) & (TXXT_DEP_HASH_SLOTS - 1u);
+    }
+    if (!insert || g->node_count >= TXXT_DEP_NODES) {
+        return -1;
+    }
+    uint32_t node = g->node_count++;
+    for (uint32_t i = 0; i < 16u; i++) {
+        g->node_id[node][i] = id[i];
+    }
+    g->hash[slot] = (uint16_t)(node + 1u);
+    g->ord[node] = (uint16_t)node;
+    g->at[node] = (uint16_t)node;
+    g->duration[node] = TXXT_DEP_DEFAULT_DURATION;
+    g->finish[node] = TXXT_DEP_DEFAULT_DURATION;
+    g->depth[node] = 0;
+    g->critical_pred[node] = TXXT_DEP_NONE;
+    g->critical_dirty = true;
+    return (int32_t)node;
+}
+
+// Walks the live neighbours of a node: its CSR range, then the unindexed tail.
+typedef struct {
+    uint32_t next;
+    uint32_t end;
+    uint32_t tail;
+    uint16_t node;
+    bool forward;
+} DepCursor;
+
+static DepCursor dep_cursor(uint16_t node, bool forward) {
+    const DepGraph* g = &dep_graph;
+    DepCursor cursor = { .tail = g->csr_edges, .node = node, .forward = forward };
+    if (node < g->csr_nodes) {
+        const uint32_t* start = forward ? g->succ_start : g->pred_start;
+        cursor.next = start[node];
+        cursor.end = start[node + 1u];
+    }
+    return cursor;
+}
+
+static int32_t dep_next(DepCursor* cursor) {
+    const DepGraph* g = &dep_graph;
+    const uint32_t* index = cursor->forward ? g->succ : g->pred;
+    while (cursor->next < cursor->end) {
+        const DepEdge* edge = &g->edges[index[cursor->next++]];
+        if (edge->from != edge->to) {
+            return cursor->forward ? edge->to : edge->from;
+        }
+    }
+    while (cursor->tail < g->edge_count) {
+        const DepEdge* edge = &g->edges[cursor->tail++];
+        if (edge->from == edge->to) {
+            continue;
+        }
+        if (cursor->forward && edge->from == cursor->node) {
+            return edge->to;
+        }
+        if (!cursor->forward && edge->to == cursor->node) {
+            return edge->from;
+        }
+    }
+    return -1;
+}
+
+static int32_t dep_find_edge(uint16_t from, uint16_t to) {
+    const DepGraph* g = &dep_graph;
+    if (from < g->csr_nodes) {
+        for (uint32_t i = g->succ_start[from]; i < g->succ_start[from + 1u]; i++) {
+            const DepEdge* edge = &g->edges[g->succ[i]];
+            if (edge->from == from && edge->to == to) {
+                return (int32_t)g->succ[i];
+            }
+        }
+    }
+    for (uint32_t i = g->csr_edges; i < g->edge_count; i++) {
+        if (g->edges[i].from == from && g->edges[i].to == to) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+// Drop removed edges and index everything by counting sort: O(nodes + edges).
+static void dep_rebuild_csr(void) {
+    DepGraph* g = &dep_graph;
+    uint32_t live = 0;
+    for (uint32_t i = 0; i < g->edge_count; i++) {
+        if (g->edges[i].from != g->edges[i].to) {
+            g->edges[live++] = g->edges[i];
+        }
+    }
+    g->edge_count = live;
+
+    uint32_t nodes = g->node_count;
+    for (uint32_t n = 0; n <= nodes; n++) {
+        g->succ_start[n] = 0;
+        g->pred_start[n] = 0;
+    }
+    for (uint32_t i = 0; i < live; i++) {
+        g->succ_start[g->edges[i].from + 1u]++;
+        g->pred_start[g->edges[i].to + 1u]++;
+    }
+    for (uint32_t n = 1; n <= nodes; n++) {
+        g->succ_start[n] += g->succ_start[n - 1u];
+        g->pred_start[n] += g->pred_start[n - 1u];
+    }
+    // Fill by advancing each node's start, then shift the starts back.
+    for (uint32_t i = 0; i < live; i++) {
+        g->succ[g->succ_start[g->edges[i].from]++] = i;
+        g->pred[g->pred_start[g->edges[i].to]++] = i;
+    }
+    for (uint32_t n = nodes; n > 0; n--) {
+        g->succ_start[n] = g->succ_start[n - 1u];
+        g->pred_start[n] = g->pred_start[n - 1u];
+    }
+    g->succ_start[0] = 0;
+    g->pred_start[0] = 0;
+    g->csr_edges = live;
+    g->csr_nodes = nodes;
+}
+
+static void dep_next_stamp(void) {
+    DepGraph* g = &dep_graph;
+    if (++g->stamp == 0) {
+        for (uint32_t n = 0; n < TXXT_DEP_NODES; n++) {
+            g->mark[n] = 0;
+        }
+        g->stamp = 1;
+    }
+}
+
+static void dep_sift_by_ord(uint16_t* nodes, uint32_t root, uint32_t count) {
+    const uint16_t* ord = dep_graph.ord;
+    for (;;) {
+        uint32_t child = root * 2u + 1u;
+        if (child >= count) {
+            return;
+        }
+        if (child + 1u < count && ord[nodes[child + 1u]] > ord[nodes[child]]) {
+            child++;
+        }
+        if (ord[nodes[root]] >= ord[nodes[child]]) {
+            return;
+        }
+        uint16_t swap = nodes[root];
+        nodes[root] = nodes[child];
+        nodes[child] = swap;
+        root = child;
+    }
+}
+
+// Heapsort: the reorder regions can be large, and there is no qsort here.
+static void dep_sort_by_ord(uint16_t* nodes, uint32_t count) {
+    for (uint32_t i = count / 2u; i-- > 0;) {
+        dep_sift_by_ord(nodes, i, count);
+    }
+    for (uint32_t end = count; end-- > 1u;) {
+        uint16_t swap = nodes[0];
+        nodes[0] = nodes[end];
+        nodes[end] = swap;
+        dep_sift_by_ord(nodes, 0, end);
+    }
+}
+
+// Nodes reachable from `start` (successors when forward, else blockers)
+// whose position lies strictly between the start and `bound`, plus `start`
+// itself. A forward search that reaches `bound` would close a cycle: -1.
+static int32_t dep_collect(uint16_t start, bool forward, uint16_t bound, uint16_t* out) {
+    DepGraph* g = &dep_graph;
+    uint32_t count = 0;
+    uint32_t top = 0;
+    g->mark[start] = g->stamp;
+    g->stack[top++] = start;
+    while (top > 0) {
+        uint16_t node = g->stack[--top];
+        out[count++] = node;
+        DepCursor cursor = dep_cursor(node, forward);
+        for (int32_t next; (next = dep_next(&cursor)) >= 0;) {
+            uint16_t position = g->ord[next];
+            if (forward && position == bound) {
+                return -1;
+            }
+            bool inside = forward ? position < bound : position > bound;
+            if (inside && g->mark[next] != g->stamp) {
+                g->mark[next] = g->stamp;
+                g->stack[top++] = (uint16_t)next;
+            }
+        }
+    }
+    return (int32_t)count;
+}
+
+static void dep_queue(uint16_t node) {
+    DepGraph* g = &dep_graph;
+    if (g->queued[node]) {
+        return;
+    }
+    g->queued[node] = 1;
+    uint32_t i = g->heap_count++;
+    while (i > 0) {
+        uint32_t parent = (i - 1u) / 2u;
+        if (g->ord[g->heap[parent]] <= g->ord[node]) {
+            break;
+        }
+        g->heap[i] = g->heap[parent];
+        i = parent;
+    }
+    g->heap[i] = node;
+}
+
+static uint16_t dep_dequeue(void) {
+    DepGraph* g = &dep_graph;
+    uint16_t first = g->heap[0];
+    uint16_t last = g->heap[--g->heap_count];
+    uint32_t i = 0;
+    for (;;) {
+        uint32_t child = i * 2u + 1u;
+        if (child >= g->heap_count) {
+            break;
+        }
+        if (child + 1u < g->heap_count && g->ord[g->heap[child + 1u]] < g->ord[g->heap[child]]) {
+            child++;
+        }
+        if (g->ord[last] <= g->ord[g->heap[child]]) {
+            break;
+        }
+        g->heap[i] = g->heap[child];
+        i = child;
+    }
+    g->heap[i] = last;
+    g->queued[first] = 0;
+    return first;
+}
+
+// Recompute finish/depth for queued nodes in topological order. A node is
+// only reached after all its queued blockers, and only a node whose values
+// changed queues its successors, so the work is bounded by what changed.
+static void dep_repair(void) {
+    DepGraph* g = &dep_graph;
+    while (g->heap_count > 0) {
+        uint16_t node = dep_dequeue();
+        float start = 0.0f;
+        uint16_t depth = 0;
+        uint16_t critical = TXXT_DEP_NONE;
+        DepCursor blockers = dep_cursor(node, false);
+        for (int32_t pred; (pred = dep_next(&blockers)) >= 0;) {
+            if (critical == TXXT_DEP_NONE || g->finish[pred] > start) {
+                start = g->finish[pred];
+                critical = (uint16_t)pred;
+            }
+            if (g->depth[pred] + 1u > depth) {
+                depth = (uint16_t)(g->depth[pred] + 1u);
+            }
+        }
+        float finish = start + g->duration[node];
+        if (critical != g->critical_pred[node]) {
+            g->critical_pred[node] = critical;
+            g->critical_dirty = true;
+        }
+        if (finish == g->finish[node] && depth == g->depth[node]) {
+            continue;
+        }
+        g->finish[node] = finish;
+        g->depth[node] = depth;
+        g->critical_dirty = true;
+        DepCursor blocked = dep_cursor(node, true);
+        for (int32_t next; (next = dep_next(&blocked)) >= 0;) {
+            dep_queue((uint16_t)next);
+        }
+    }
+}
+
+// Link `from` blocks `to`. Returns false if that would close a cycle (or the
+// edge table is full of live edges).
+static bool dep_add_edge(uint16_t from, uint16_t to) {
+    DepGraph* g = &dep_graph;
+    if (from == to) {
+        g->rejected_cycles++;
+        return false;
+    }
+    if (dep_find_edge(from, to) >= 0) {
+        return true;
+    }
+    if (g->edge_count >= TXXT_DEP_EDGES) {
+        dep_rebuild_csr();
+        if (g->edge_count >= TXXT_DEP_EDGES) {
+            return false;
+        }
+    }
+
+    uint16_t lower = g->ord[to];
+    uint16_t upper = g->ord[from];
+    if (lower < upper) {
+        // Pearce-Kelly: what `to` reaches below `upper` must move after what
+        // reaches `from` above `lower`; both keep their relative order and
+        // reuse the same set of positions.
+        dep_next_stamp();
+        int32_t forward_count = dep_collect(to, true, upper, g->forward);
+        if (forward_count < 0) {
+            g->rejected_cycles++;
+            return false;
+        }
+        int32_t backward_count = dep_collect(from, false, lower, g->backward);
+        dep_sort_by_ord(g->forward, (uint32_t)forward_count);
+        dep_sort_by_ord(g->backward, (uint32_t)backward_count);
+
+        uint32_t b = 0;
+        uint32_t f = 0;
+        uint32_t k = 0;
+        while (b < (uint32_t)backward_count || f < (uint32_t)forward_count) {
+            if (f >= (uint32_t)forward_count ||
+                (b < (uint32_t)backward_count && g->ord[g->backward[b]] < g->ord[g->forward[f]])) {
+                g->pool[k++] = g->ord[g->backward[b++]];
+            } else {
+                g->pool[k++] = g->ord[g->forward[f++]];
+            }
+        }
+        k = 0;
+        for (b = 0; b < (uint32_t)backward_count; b++, k++) {
+            g->ord[g->backward[b]] = g->pool[k];
+            g->at[g->pool[k]] = g->backward[b];
+        }
+        for (f = 0; f < (uint32_t)forward_count; f++, k++) {
+            g->ord[g->forward[f]] = g->pool[k];
+            g->at[g->pool[k]] = g->forward[f];
+        }
+    }
+
+    g->edges[g->edge_count++] = (DepEdge){ .from = from, .to = to };
+    g->live_edges++;
+    if (g->edge_count - g->csr_edges >= TXXT_DEP_PENDING_MAX) {
+        dep_rebuild_csr();
+    }
+    dep_queue(to);
+    dep_repair();
+    return true;
+}
+
+// Removing a link never invalidates the order; only finish times downstream move.
+static bool dep_remove_edge(uint16_t from, uint16_t to) {
+    DepGraph* g = &dep_graph;
+    if (from == to) {
+        return false; // never a live link: from == to is how removed edges are marked
+    }
+    int32_t edge = dep_find_edge(from, to);
+    if (edge < 0) {
+        return false;
+    }
+    g->edges[edge].from = to;
+    g->live_edges--;
+    dep_queue(to);
+    dep_repair();
+    return true;
+}
+
+// A deleted task keeps its node (ids are never reused) but loses its links.
+static void dep_drop_task(const char* id) {
+    DepGraph* g = &dep_graph;
+    uint8_t bytes[16];
+    int32_t node = parse_uuid(id, bytes) ? dep_node_find(bytes, false) : -1;
+    if (node < 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < g->edge_count; i++) {
+        DepEdge* edge = &g->edges[i];
+        if (edge->from == edge->to || (edge->from != node && edge->to != node)) {
+            continue;
+        }
+        dep_queue(edge->to);
+        edge->from = edge->to;
+        g->live_edges--;
+    }
+    dep_repair();
+}
+
+// Longest finish and the blocker chain leading to it, once per change.
+static void dep_refresh_critical(void) {
+    DepGraph* g = &dep_graph;
+    if (!g->critical_dirty) {
+        return;
+    }
+    g->critical_dirty = false;
+    if (++g->critical_stamp == 0) {
+        for (uint32_t n = 0; n < TXXT_DEP_NODES; n++) {
+            g->critical_mark[n] = 0;
+        }
+        g->critical_stamp = 1;
+    }
+    g->critical_length = 0.0f;
+    if (g->live_edges == 0) {
+        return;
+    }
+    uint32_t end = 0;
+    for (uint32_t n = 1; n < g->node_count; n++) {
+        if (g->finish[n] > g->finish[end]) {
+            end = n;
+        }
+    }
+    g->critical_length = g->finish[end];
+    for (uint32_t node = end; node != TXXT_DEP_NONE; node = g->critical_pred[node]) {
+        g->critical_mark[node] = g->critical_stamp;
+    }
+}
+
+static int32_t dep_node_for_task(const Task* task) {
+    uint8_t bytes[16];
+    return parse_uuid(task->id, bytes) ? dep_node_find(bytes, false) : -1;
+}
+
+static bool dep_is_critical(int32_t node) {
+    if (node < 0 || dep_graph.live_edges == 0) {
+        return false;
+    }
+    dep_refresh_critical();
+    return dep_graph.critical_mark[node] == dep_graph.critical_stamp;
+}
+
+// ── Recurring tasks (see RecurStore) ───────────────────────────
+
+// Monday = 0 (1970-01-01 was a Thursday).
+static inline uint32_t epoch_weekday(uint32_t day) {
+    return (day + 3u) % 7u;
+}
+
+static int32_t recur_rule_find(const uint8_t* id) {
+    for (uint32_t i = 0; i < recur_store.rule_count; i++) {
+        const RecurRule* rule = &recur_store.rules[i];
+        uint32_t same = 0;
+        while (rule->used && same < 16u && rule->id[same] == id[same]) {
+            same++;
+        }
+        if (same == 16u) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+static bool recur_has_rules(void) {
+    for (uint32_t i = 0; i < recur_store.rule_count; i++) {
+        if (recur_store.rules[i].used) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// First override at or after (rule, day).
+static uint32_t recur_override_lower_bound(uint32_t rule, uint32_t day) {
+    uint32_t lo = 0;
+    uint32_t hi = recur_store.override_count;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2u;
+        const RecurOverride* o = &recur_store.overrides[mid];
+        if (o->rule < rule || (o->rule == rule && o->day < day)) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// First moved entry at or after (moved_to, rule, day).
+static uint32_t recur_moved_lower_bound(uint32_t moved_to, uint32_t rule, uint32_t day) {
+    uint32_t lo = 0;
+    uint32_t hi = recur_store.moved_count;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2u;
+        const RecurMoved* m = &recur_store.moved[mid];
+        if (m->moved_to < moved_to || (m->moved_to == moved_to &&
+            (m->rule < rule || (m->rule == rule && m->day < day)))) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void recur_moved_remove(uint16_t moved_to, uint16_t rule, uint16_t day) {
+    RecurStore* store = &recur_store;
+    uint32_t at = recur_moved_lower_bound(moved_to, rule, day);
+    if (at >= store->moved_count || store->moved[at].moved_to != moved_to ||
+        store->moved[at].rule != rule || store->moved[at].day != day) {
+        return;
+    }
+    for (uint32_t i = at + 1u; i < store->moved_count; i++) {
+        store->moved[i - 1u] = store->moved[i];
+    }
+    store->moved_count--;
+}
+
+static void recur_moved_insert(uint16_t moved_to, uint16_t rule, uint16_t day) {
+    RecurStore* store = &recur_store;
+    uint32_t at = recur_moved_lower_bound(moved_to, rule, day);
+    for (uint32_t i = store->moved_count; i > at; i--) {
+        store->moved[i] = store->moved[i - 1u];
+    }
+    store->moved[at] = (RecurMoved){ .moved_to = moved_to, .rule = rule, .day = day };
+    store->moved_count++;
+}
+
+// Set the override for one occurrence; pending and not moved clears it.
+static bool recur_set_override(uint16_t rule, uint16_t day, uint16_t moved_to, uint8_t state) {
+    RecurStore* store = &recur_store;
+    if (moved_to == day) {
+        moved_to = TXXT_DUE_NONE;
+    }
+    uint32_t at = recur_override_lower_bound(rule, day);
+    bool exists = at < store->override_count && store->overrides[at].rule == rule && store->overrides[at].day == day;
+    bool keep = state != RECUR_OCC_PENDING || moved_to != TXXT_DUE_NONE;
+    if (!exists && !keep) {
+        return true;
+    }
+    if (!exists && store->override_count >= TXXT_RECUR_OVERRIDES_MAX) {
+        return false;
+    }
+
+    if (exists && store->overrides[at].moved_to != TXXT_DUE_NONE) {
+        recur_moved_remove(store->overrides[at].moved_to, rule, day);
+    }
+    if (!keep) {
+        for (uint32_t i = at + 1u; i < store->override_count; i++) {
+            store->overrides[i - 1u] = store->overrides[i];
+        }
+        store->override_count--;
+    } else {
+        if (!exists) {
+            for (uint32_t i = store->override_count; i > at; i--) {
+                store->overrides[i] = store->overrides[i - 1u];
+            }
+            store->override_count++;
+        }
+        store->overrides[at] = (RecurOverride){ .rule = rule, .day = day, .moved_to = moved_to, .state = state };
+        if (moved_to != TXXT_DUE_NONE) {
+            recur_moved_insert(moved_to, rule, day);
+        }
+    }
+    store->revision++;
+    return true;
+}
+
+static void recur_toggle_completed(uint16_t rule, uint16_t day) {
+    RecurStore* store = &recur_store;
+    uint32_t at = recur_override_lower_bound(rule, day);
+    uint16_t moved_to = TXXT_DUE_NONE;
+    uint8_t state = RECUR_OCC_PENDING;
+    if (at < store->override_count && store->overrides[at].rule == rule && store->overrides[at].day == day) {
+        moved_to = store->overrides[at].moved_to;
+        state = store->overrides[at].state;
+    }
+    recur_set_override(rule, day, moved_to, state == RECUR_OCC_COMPLETED ? RECUR_OCC_PENDING : RECUR_OCC_COMPLETED);
+}
+
+// A rule's generated days within [lo, hi], ascending. Jumps straight to the
+// first period inside the window, so the cost is the occurrences produced.
+static uint32_t recur_rule_days(const RecurRule* rule, uint32_t lo, uint32_t hi, uint16_t* out) {
+    if (rule->start_day > lo) {
+        lo = rule->start_day;
+    }
+    if (rule->until_day < hi) {
+        hi = rule->until_day;
+    }
+    if (lo > hi) {
+        return 0;
+    }
+    uint32_t interval = rule->interval ? rule->interval : 1u;
+    uint32_t count = 0;
+    if (rule->kind == RECUR_WEEKLY) {
+        int32_t first_week = (int32_t)rule->start_day - (int32_t)epoch_weekday(rule->start_day);
+        int32_t week = (int32_t)lo - (int32_t)epoch_weekday(lo);
+        int32_t period = 7 * (int32_t)interval;
+        week += (period - (week - first_week) % period) % period;
+        for (; week <= (int32_t)hi; week += period) {
+            for (int32_t d = 0; d < 7; d++) {
+                int32_t day = week + d;
+                if ((rule->weekdays & (1u << d)) && day >= (int32_t)lo && day <= (int32_t)hi) {
+                    out[count++] = (uint16_t)day;
+                }
+            }
+        }
+    } else {
+        uint32_t day = rule->start_day + (lo - rule->start_day + interval - 1u) / interval * interval;
+        for (; day <= hi; day += interval) {
+            out[count++] = (uint16_t)day;
+        }
+    }
+    return count;
+}
+
+static void recur_expand(RecurWindow* window) {
+    RecurStore* store = &recur_store;
+    uint32_t lo = window->first_day;
+    uint32_t hi = lo + window->day_count - 1u;
+    uint32_t count = 0;
+    bool truncated = false;
+    uint16_t days[TXXT_RECUR_WINDOW_DAYS_MAX];
+
+    for (uint32_t r = 0; r < store->rule_count && !truncated; r++) {
+        if (!store->rules[r].used) {
+            continue;
+        }
+        uint32_t day_count = recur_rule_days(&store->rules[r], lo, hi, days);
+        uint32_t o = recur_override_lower_bound(r, lo);
+        for (uint32_t i = 0; i < day_count; i++) {
+            // Sorted merge: the rule's overrides advance alongside its days.
+            while (o < store->override_count && store->overrides[o].rule == r && store->overrides[o].day < days[i]) {
+                o++;
+            }
+            RecurOccurrence occurrence = { .day = days[i], .original_day = days[i], .rule = (uint16_t)r };
+            if (o < store->override_count && store->overrides[o].rule == r && store->overrides[o].day == days[i]) {
+                const RecurOverride* override = &store->overrides[o];
+                if (override->state == RECUR_OCC_SKIPPED ||
+                    (override->moved_to != TXXT_DUE_NONE && (override->moved_to < lo || override->moved_to > hi))) {
+                    continue;
+                }
+                occurrence.state = override->state;
+                if (override->moved_to != TXXT_DUE_NONE) {
+                    occurrence.day = override->moved_to;
+                    occurrence.moved = true;
+                }
+            }
+            if (count == TXXT_RECUR_OCCURRENCES_MAX) {
+                truncated = true;
+                break;
+            }
+            store->scratch[count++] = occurrence;
+        }
+    }
+
+    // Occurrences moved here from days outside the window.
+    for (uint32_t m = recur_moved_lower_bound(lo, 0, 0); m < store->moved_count && store->moved[m].moved_to <= hi; m++) {
+        const RecurMoved* moved = &store->moved[m];
+        if ((moved->day >= lo && moved->day <= hi) || !store->rules[moved->rule].used) {
+            continue;
+        }
+        const RecurOverride* override = &store->overrides[recur_override_lower_bound(moved->rule, moved->day)];
+        if (override->state == RECUR_OCC_SKIPPED) {
+            continue;
+        }
+        if (count == TXXT_RECUR_OCCURRENCES_MAX) {
+            truncated = true;
+            break;
+        }
+        store->scratch[count++] = (RecurOccurrence){
+            .day = moved->moved_to, .original_day = moved->day, .rule = moved->rule,
+            .state = override->state, .moved = true
+        };
+    }
+
+    // Bucket by day (stable counting sort).
+    uint16_t next[TXXT_RECUR_WINDOW_DAYS_MAX + 1];
+    for (uint32_t d = 0; d <= window->day_count; d++) {
+        window->day_start[d] = 0;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        window->day_start[store->scratch[i].day - lo + 1u]++;
+    }
+    for (uint32_t d = 1; d <= window->day_count; d++) {
+        window->day_start[d] += window->day_start[d - 1u];
+    }
+    for (uint32_t d = 0; d < window->day_count; d++) {
+        next[d] = window->day_start[d];
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        window->items[next[store->scratch[i].day - lo]++] = store->scratch[i];
+    }
+    window->count = count;
+    window->truncated = truncated;
+    window->revision = store->revision;
+    store->expansions++;
+}
+
+// Expanded occurrences for a window, from the cache when nothing changed.
+static const RecurWindow* recur_window(uint16_t first_day, uint16_t day_count) {
+    RecurStore* store = &recur_store;
+    if (day_count == 0) {
+        day_count = 1;
+    }
+    if (day_count > TXXT_RECUR_WINDOW_DAYS_MAX) {
+        day_count = TXXT_RECUR_WINDOW_DAYS_MAX;
+    }
+    if (first_day > TXXT_DUE_NONE - day_count) {
+        first_day = (uint16_t)(TXXT_DUE_NONE - day_count);
+    }
+
+    // Reuse a matching window; otherwise evict a stale or the least recent one.
+    RecurWindow* victim = &store->windows[0];
+    for (uint32_t i = 0; i < TXXT_RECUR_CACHE_WINDOWS; i++) {
+        RecurWindow* window = &store->windows[i];
+        bool current = window->revision == store->revision;
+        if (current && window->first_day == first_day && window->day_count == day_count) {
+            window->last_used = ++store->clock;
+            return window;
+        }
+        bool victim_current = victim->revision == store->revision;
+        if ((victim_current && !current) || (victim_current == current && window->last_used < victim->last_used)) {
+            victim = window;
+        }
+    }
+    victim->first_day = first_day;
+    victim->day_count = day_count;
+    recur_expand(victim);
+    victim->last_used = ++store->clock;
+    return victim;
+}
+
+static void recur_remove_rule(uint32_t rule) {
+    RecurStore* store = &recur_store;
+    uint32_t begin = recur_override_lower_bound(rule, 0);
+    uint32_t end = recur_override_lower_bound(rule + 1u, 0);
+    for (uint32_t i = begin; i < end; i++) {
+        if (store->overrides[i].moved_to != TXXT_DUE_NONE) {
+            recur_moved_remove(store->overrides[i].moved_to, (uint16_t)rule, store->overrides[i].day);
+        }
+    }
+    for (uint32_t i = end; i < store->override_count; i++) {
+        store->overrides[i - (end - begin)] = store->overrides[i];
+    }
+    store->override_count -= end - begin;
+    store->rules[rule].used = false;
+    store->revision++;
+}
+
+// ── Bulk import (see ImportState) ──────────────────────────────
+
+static void service_index_rebuild(void) {
+    for (uint32_t h = 0; h < TXXT_INTERN_MAX; h++) {
+        service_by_handle[h] = 0;
+    }
+    // Backwards, so the first of two same-named services wins.
+    for (uint32_t i = app_state.service_count; i-- > 0;) {
+        const Service* service = &app_state.services[i];
+        uint16_t handle = intern_string(service->name);
+        if (handle != 0 && parse_uuid(service->id, service_wire_ids[i])) {
+            service_by_handle[handle] = (uint8_t)(i + 1u);
+        }
+    }
+}
+
+// Bitmasks (bit i = byte i) of quotes, delimiters and line feeds.
+typedef struct {
+    uint32_t quote;
+    uint32_t delimiter;
+    uint32_t newline;
+} CsvMasks;
+
+static CsvMasks csv_classify_scalar(const uint8_t* p, uint32_t count, uint8_t delimiter) {
+    CsvMasks masks = {0};
+    for (uint32_t i = 0; i < count; i++) {
+        masks.quote |= (uint32_t)(p[i] == '"') << i;
+        masks.delimiter |= (uint32_t)(p[i] == delimiter) << i;
+        masks.newline |= (uint32_t)(p[i] == '\n') << i;
+    }
+    return masks;
+}
+
+// 16 bytes in three compares: simd128 in the browser, SSE2 natively.
+static inline CsvMasks csv_classify16(const uint8_t* p, uint8_t delimiter) {
+    CsvMasks masks;
+#if !defined(CLAY_DISABLE_SIMD) && defined(__wasm_simd128__)
+    v128_t bytes = wasm_v128_load(p);
+    masks.quote = wasm_i8x16_bitmask(wasm_i8x16_eq(bytes, wasm_i8x16_splat('"')));
+    masks.delimiter = wasm_i8x16_bitmask(wasm_i8x16_eq(bytes, wasm_i8x16_splat((int8_t)delimiter)));
+    masks.newline = wasm_i8x16_bitmask(wasm_i8x16_eq(bytes, wasm_i8x16_splat('\n')));
+#elif !defined(CLAY_DISABLE_SIMD) && defined(__SSE2__)
+    __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+    masks.quote = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')));
+    masks.delimiter = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((char)delimiter)));
+    masks.newline = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+#else
+    masks = csv_classify_scalar(p, 16u, delimiter);
+#endif
+    return masks;
+}
+
+static void import_append(ImportState* s, const uint8_t* bytes, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+    s->quote_closed = false;
+    if (s->field >= TXXT_IMPORT_COLUMNS_MAX) {
+        return;
+    }
+    char* field = s->fields[s->field];
+    uint32_t length = s->field_length[s->field];
+    uint32_t keep = TXXT_IMPORT_FIELD_MAX - length;
+    if (count > keep) {
+        s->truncated |= 1u << s->field;
+        count = keep;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        field[length + i] = (char)bytes[i];
+    }
+    s->field_length[s->field] = (uint16_t)(length + count);
+}
+
+static void import_end_field(ImportState* s, bool row_end) {
+    if (s->field < TXXT_IMPORT_COLUMNS_MAX) {
+        char* field = s->fields[s->field];
+        uint32_t length = s->field_length[s->field];
+        if (s->truncated & (1u << s->field)) {
+            // Drop a UTF-8 sequence the cap cut in half.
+            uint32_t lead = length;
+            while (lead > 0 && ((uint8_t)field[lead - 1u] & 0xC0u) == 0x80u) {
+                lead--;
+            }
+            if (lead > 0) {
+                uint8_t c = (uint8_t)field[lead - 1u];
+                uint32_t need = c >= 0xF0u ? 4u : c >= 0xE0u ? 3u : c >= 0xC0u ? 2u : 1u;
+                if (lead - 1u + need > length) {
+                    length = lead - 1u;
+                }
+            }
+        } else if (row_end && length > 0 && field[length - 1u] == '\r') {
+            length--;
+        }
+        field[length] = '\0';
+        s->field_length[s->field] = (uint16_t)length;
+    }
+    s->field++;
+}
+
+static bool ascii_equals_ignore_case(const char* a, const char* b) {
+    uint32_t i = 0;
+    for (; a[i] && b[i]; i++) {
+        char x = (a[i] >= 'A' && a[i] <= 'Z') ? (char)(a[i] + 32) : a[i];
+        if (x != b[i]) {
+            return false;
+        }
+    }
+    return a[i] == b[i];
+}
+
+// Field `column` of the current row with surrounding blanks cut off.
+static const char* import_field(ImportState* s, uint32_t column) {
+    if (column >= s->field || column >= TXXT_IMPORT_COLUMNS_MAX) {
+        return "";
+    }
+    char* text = s->fields[column];
+    uint32_t end = s->field_length[column];
+    while (end > 0 && (text[end - 1u] == ' ' || text[end - 1u] == '\t')) {
+        end--;
+    }
+    text[end] = '\0';
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+    return text;
+}
+
+// Decimal digits only; false on anything else or more than 5 digits.
+static bool import_number(const char* text, uint32_t* out) {
+    uint32_t value = 0;
+    uint32_t digits = 0;
+    for (; text[digits]; digits++) {
+        if (text[digits] < '0' || text[digits] > '9' || digits == 5u) {
+            return false;
+        }
+        value = value * 10u + (uint32_t)(text[digits] - '0');
+    }
+    *out = value;
+    return digits > 0;
+}
+
+static void import_header(ImportState* s) {
+    static const struct { const char* name; uint8_t column; } NAMES[] = {
+        { "title", IMPORT_COL_TITLE }, { "task", IMPORT_COL_TITLE }, { "summary", IMPORT_COL_TITLE },
+        { "service", IMPORT_COL_SERVICE }, { "application", IMPORT_COL_SERVICE }, { "app", IMPORT_COL_SERVICE },
+        { "priority", IMPORT_COL_PRIORITY },
+        { "date", IMPORT_COL_DATE }, { "day", IMPORT_COL_DATE }, { "scheduled", IMPORT_COL_DATE },
+        { "start", IMPORT_COL_START }, { "start time", IMPORT_COL_START }, { "time", IMPORT_COL_START },
+        { "duration", IMPORT_COL_DURATION }, { "minutes", IMPORT_COL_DURATION },
+    };
+    bool seen[IMPORT_COL_KINDS] = {0};
+    for (uint32_t c = 0; c < TXXT_IMPORT_COLUMNS_MAX; c++) {
+        s->columns[c] = IMPORT_COL_IGNORED;
+        const char* name = import_field(s, c);
+        for (uint32_t n = 0; n < sizeof(NAMES) / sizeof(NAMES[0]); n++) {
+            if (!seen[NAMES[n].column] && ascii_equals_ignore_case(name, NAMES[n].name)) {
+                s->columns[c] = NAMES[n].column;
+                seen[NAMES[n].column] = true;
+                break;
+            }
+        }
+    }
+    s->header_done = true;
+    s->header_valid = seen[IMPORT_COL_TITLE] && seen[IMPORT_COL_SERVICE];
+}
+
+static void import_reject(ImportState* s, ImportReject reason) {
+    s->rejected[reason]++;
+    if (s->first_rejected_row == 0) {
+        s->first_rejected_row = s->records;
+    }
+}
+
+// Validate one data row and append its CMD_CREATE_TASK to the batch.
+static void import_row(ImportState* s) {
+    const char* text[IMPORT_COL_KINDS] = { "", "", "", "", "", "", "" };
+    for (uint32_t c = 0; c < s->field && c < TXXT_IMPORT_COLUMNS_MAX; c++) {
+        if (s->columns[c] != IMPORT_COL_IGNORED) {
+            text[s->columns[c]] = import_field(s, c);
+        }
+    }
+
+    const char* title = text[IMPORT_COL_TITLE];
+    if (title[0] == '\0') {
+        import_reject(s, IMPORT_REJECT_TITLE);
+        return;
+    }
+    uint16_t handle = intern_find(text[IMPORT_COL_SERVICE]);
+    if (handle == 0 || service_by_handle[handle] == 0) {
+        import_reject(s, IMPORT_REJECT_SERVICE);
+        return;
+    }
+    const uint8_t* service_id = service_wire_ids[service_by_handle[handle] - 1u];
+
+    static const char* const PRIORITIES[TXXT_PRIORITY_COUNT] = { "low", "medium", "high", "urgent" };
+    const char* priority_text = text[IMPORT_COL_PRIORITY];
+    uint32_t priority = PRIORITY_MEDIUM;
+    if (priority_text[0] != '\0' && !(import_number(priority_text, &priority) && priority < TXXT_PRIORITY_COUNT)) {
+        priority = TXXT_PRIORITY_COUNT;
+        for (uint32_t p = 0; p < TXXT_PRIORITY_COUNT; p++) {
+            if (ascii_equals_ignore_case(priority_text, PRIORITIES[p])) {
+                priority = p;
+            }
+        }
+    }
+
+    const char* date_text = text[IMPORT_COL_DATE];
+    uint16_t date = TXXT_WIRE_DATE_NONE;
+    bool date_bad = false;
+    if (date_text[0] != '\0') {
+        date = parse_due_day(date_text);
+        date_bad = date == TXXT_DUE_NONE || date_text[10] != '\0';
+    }
+    // H:MM or HH:MM
+    uint32_t start = TXXT_IMPORT_DEFAULT_START;
+    const char* start_text = text[IMPORT_COL_START];
+    uint32_t start_length = 0;
+    while (start_text[start_length]) {
+        start_length++;
+    }
+    if (start_length > 0) {
+        uint32_t colon = start_length - 3u;
+        bool ok = (start_length == 4u || start_length == 5u) && start_text[colon] == ':';
+        uint32_t hours = 0;
+        for (uint32_t i = 0; ok && i < start_length; i++) {
+            ok = i == colon || (start_text[i] >= '0' && start_text[i] <= '9');
+            hours = i < colon ? hours * 10u + (uint32_t)(start_text[i] - '0') : hours;
+        }
+        uint32_t minutes = ok ? (uint32_t)(start_text[colon + 1u] - '0') * 10u + (uint32_t)(start_text[colon + 2u] - '0') : 60u;
+        start = ok && hours < 24u && minutes < 60u ? hours * 60u + minutes : 0xFFFFu;
+    }
+    uint32_t duration = TXXT_IMPORT_DEFAULT_DURATION;
+    if (text[IMPORT_COL_DURATION][0] != '\0' && !import_number(text[IMPORT_COL_DURATION], &duration)) {
+        duration = 0;
+    }
+    // The server's scheduling rules, so no accepted row is dropped by the
+    // apply loop: a slot on the 15-minute grid that ends by midnight.
+    if (priority >= TXXT_PRIORITY_COUNT || date_bad || start >= TXXT_IMPORT_DAY_MINUTES ||
+        start % TXXT_IMPORT_SLOT_MINUTES != 0 || duration == 0 || duration % TXXT_IMPORT_SLOT_MINUTES != 0 ||
+        duration > TXXT_IMPORT_DAY_MINUTES - start) {
+        import_reject(s, IMPORT_REJECT_FIELD);
+        return;
+    }
+
+    uint32_t title_length = 0;
+    while (title[title_length]) {
+        title_length++;
+    }
+    uint32_t size = TXXT_WIRE_CREATE_TASK_HEADER + title_length;
+    if (s->accepted >= TXXT_IMPORT_ROWS_MAX || s->batch_length + 2u + size > TXXT_IMPORT_BATCH_MAX) {
+        import_reject(s, IMPORT_REJECT_FULL);
+        return;
+    }
+
+    uint8_t* out = s->batch + s->batch_length;
+    out[0] = (uint8_t)size;
+    out[1] = (uint8_t)(size >> 8);
+    uint8_t* cmd = out + 2;
+    cmd[0] = TXXT_WIRE_CMD_CREATE_TASK;
+    cmd[1] = (uint8_t)priority;
+    for (uint32_t i = 0; i < 16u; i++) {
+        cmd[2 + i] = service_id[i];
+        cmd[18 + i] = 0; // unassigned
+    }
+    if (date == TXXT_WIRE_DATE_NONE) {
+        start = 0;
+        duration = 0;
+    }
+    cmd[34] = (uint8_t)date;
+    cmd[35] = (uint8_t)(date >> 8);
+    cmd[36] = (uint8_t)start;
+    cmd[37] = (uint8_t)(start >> 8);
+    cmd[38] = (uint8_t)duration;
+    cmd[39] = (uint8_t)(duration >> 8);
+    for (uint32_t i = 0; i < title_length; i++) {
+        cmd[TXXT_WIRE_CREATE_TASK_HEADER + i] = (uint8_t)title[i];
+    }
+    s->batch_length += 2u + size;
+    s->accepted++;
+    s->batch[1] = (uint8_t)s->accepted;
+    s->batch[2] = (uint8_t)(s->accepted >> 8);
+}
+
+static void import_end_row(ImportState* s) {
+    import_end_field(s, true);
+    bool blank = s->field == 1u && s->field_length[0] == 0;
+    if (!blank) {
+        s->records++;
+        if (!s->header_done) {
+            import_header(s);
+        } else if (s->header_valid) {
+            import_row(s);
+        }
+    }
+    for (uint32_t c = 0; c < s->field && c < TXXT_IMPORT_COLUMNS_MAX; c++) {
+        s->field_length[c] = 0;
+    }
+    s->field = 0;
+    s->truncated = 0;
+    s->quote_closed = false;
+}
+
+// Feed `length` bytes. Between structural bytes (quote, delimiter, line feed;
+// inside quotes only the quote) text is copied in runs, and the structural
+// bytes of each 16-byte block come from one vector classification.
+static void import_scan(ImportState* s, const uint8_t* data, uint32_t length) {
+    for (uint32_t pos = 0; pos < length; pos += 16u) {
+        uint32_t width = length - pos < 16u ? length - pos : 16u;
+        CsvMasks masks = width == 16u ? csv_classify16(data + pos, s->delimiter)
+                                      : csv_classify_scalar(data + pos, width, s->delimiter);
+        uint32_t cursor = 0;
+        for (;;) {
+            uint32_t live = s->in_quotes ? masks.quote : (masks.quote | masks.delimiter | masks.newline);
+            live &= ~0u << cursor;
+            if (live == 0) {
+                import_append(s, data + pos + cursor, width - cursor);
+                break;
+            }
+            uint32_t at = (uint32_t)__builtin_ctz(live);
+            import_append(s, data + pos + cursor, at - cursor);
+            uint8_t c = data[pos + at];
+            if (s->in_quotes) {
+                s->in_quotes = false;
+                s->quote_closed = true;
+            } else if (c == '"') {
+                // Opens a field that has nothing yet; right after a closing
+                // quote it is an escaped quote (""); anywhere else, literal.
+                bool at_start = s->field >= TXXT_IMPORT_COLUMNS_MAX || s->field_length[s->field] == 0;
+                bool escaped = s->quote_closed;
+                if (escaped || !at_start) {
+                    import_append(s, &c, 1u);
+                }
+                s->in_quotes = escaped || at_start;
+            } else if (c == '\n') {
+                import_end_row(s);
+            } else {
+                import_end_field(s, false);
+                s->quote_closed = false;
+            }
+            cursor = at + 1u;
+        }
+    }
+}
+
+static inline uint32_t task_index_home(const char* id) {
+    return hash_fnv1a(id) & (TXXT_TASK_INDEX_SLOTS - 1u);
+}
+
+static void task_index_insert(uint32_t index) {
+    const char* id = app_state.tasks[index].id;
+    if (id[0] == '\0') {
+        return;
+    }
+    uint32_t slot = task_index_home(id);
+    while (task_index[slot] != 0) {
+        slot = (slot + 1u) & (TXXT_TASK_INDEX_SLOTS - 1u);
+    }
+    task_index[slot] = (uint8_t)(index + 1u);
+}
+
+static void task_index_rebuild(void) {
+    for (uint32_t i = 0; i < TXXT_TASK_INDEX_SLOTS; i++) {
+        task_index[i] = 0;
+    }
+    for (uint32_t i = 0; i < app_state.task_count; i++) {
+        task_index_insert(i);
+    }
+}
+
+// Drop task `index` ahead of remove_task_at shifting the later tasks down:
+// backward-shift its entry out, then renumber the later ones.
+static void task_index_remove(uint32_t index) {
+    const uint32_t mask = TXXT_TASK_INDEX_SLOTS - 1u;
+    const char* id = app_state.tasks[index].id;
+    if (id[0] != '\0') {
+        uint32_t hole = task_index_home(id);
+        while (task_index[hole] != 0 && task_index[hole] != index + 1u) {
+            hole = (hole + 1u) & mask;
+        }
+        if (task_index[hole] != 0) {
+            task_index[hole] = 0;
+            for (uint32_t i = (hole + 1u) & mask; task_index[i] != 0; i = (i + 1u) & mask) {
+                uint32_t home = task_index_home(app_state.tasks[task_index[i] - 1u].id);
+                if (((i - home) & mask) >= ((i - hole) & mask)) {
+                    task_index[hole] = task_index[i];
+                    task_index[i] = 0;
+                    hole = i;
+                }
+            }
+        }
+    }
+    for (uint32_t i = 0; i < TXXT_TASK_INDEX_SLOTS; i++) {
+        if (task_index[i] > index + 1u) {
+            task_index[i]--;
+        }
+    }
+}
+
+static int32_t find_task_by_id(const char* id) {
+    if (!id || id[0] == '\0') {
+        return -1;
+    }
+    for (uint32_t slot = task_index_home(id); task_index[slot] != 0; slot = (slot + 1u) & (TXXT_TASK_INDEX_SLOTS - 1u)) {
+        uint32_t index = task_index[slot] - 1u;
+        if (string_equals(app_state.tasks[index].id, id)) {
+            return (int32_t)index;
+        }
+    }
+    return -1;
+}
+
+// Copy the first line of `src` into a preview buffer, cut at a UTF-8 boundary.
+static void copy_preview(char* dst, uint32_t dst_cap, const uint8_t* src, uint32_t src_cap) {
+    uint32_t n = 0;
+    while (n + 1 < dst_cap && n < src_cap && src[n] != '\0' && src[n] != '\n') {
+        n++;
+    }
+    if (n < src_cap && n + 1 >= dst_cap) {
+        while (n > 0 && (src[n] & 0xC0) == 0x80) {
+            n--;
+        }
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = (char)src[i];
+    }
+    dst[n] = '\0';
+}
+
+// ── Streaming export (see ExportState) ─────────────────────────
+
+// The task list as shown: store indices passing the status and service
+// filters, in display order. Dependency view: blockers before what they block
+// (topological position); tasks the graph has never seen keep their order
+// after them. Returns the count.
+static uint32_t task_list_view(uint32_t* out) {
+    const char* service = NULL;
+    if (app_state.selected_service_index >= 0 &&
+        app_state.selected_service_index < (int32_t)app_state.service_count) {
+        service = app_state.services[app_state.selected_service_index].name;
+    }
+    uint32_t key[TXXT_MAX_TASKS];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < app_state.task_count; i++) {
+        const Task* task = &app_state.tasks[i];
+        bool show = false;
+        switch (app_state.filter_status) {
+            case FILTER_ALL: show = true; break;
+            case FILTER_PENDING: show = (task->status == STATUS_PENDING); break;
+            case FILTER_IN_PROGRESS: show = (task->status == STATUS_IN_PROGRESS); break;
+            case FILTER_COMPLETED: show = (task->status == STATUS_COMPLETED); break;
+        }
+        if (!show || (service && !string_equals(task->service_name, service))) {
+            continue;
+        }
+        int32_t node = dep_view_enabled ? dep_node_for_task(task) : -1;
+        uint32_t k = node >= 0 ? dep_graph.ord[node] : TXXT_DEP_NODES + i;
+        uint32_t j = count++;
+        while (j > 0 && key[j - 1] > k) {
+            out[j] = out[j - 1];
+            key[j] = key[j - 1];
+            j--;
+        }
+        out[j] = i;
+        key[j] = k;
+    }
+    return count;
+}
+
+static inline void export_put(ExportState* e, uint8_t byte) {
+    e->ring[e->head++ & (TXXT_EXPORT_RING_BYTES - 1u)] = byte;
+}
+
+// CSV fields are quoted when they hold a delimiter, quote or line break;
+// TSV has no quoting, so tabs and line breaks become spaces.
+static void export_field(ExportState* e, const char* text, bool first) {
+    if (!first) {
+        export_put(e, e->delimiter);
+    }
+    bool quote = false;
+    for (uint32_t i = 0; e->delimiter == ',' && text[i]; i++) {
+        quote |= text[i] == ',' || text[i] == '"' || text[i] == '\n' || text[i] == '\r';
+    }
+    if (quote) {
+        export_put(e, '"');
+    }
+    for (uint32_t i = 0; text[i]; i++) {
+        uint8_t c = (uint8_t)text[i];
+        if (e->delimiter == '\t' && (c == '\t' || c == '\n' || c == '\r')) {
+            c = ' ';
+        } else if (c == '"' && quote) {
+            export_put(e, '"');
+        }
+        export_put(e, c);
+    }
+    if (quote) {
+        export_put(e, '"');
+    }
+}
+
+static void export_end_row(ExportState* e) {
+    if (e->delimiter == ',') {
+        export_put(e, '\r');
+    }
+    export_put(e, '\n');
+}
+
+static void export_row(ExportState* e, const Task* task) {
+    char due[11] = "";
+    if (task->due_day != TXXT_DUE_NONE) {
+        format_due_date(due, task->due_day);
+        due[10] = '\0';
+    }
+    export_field(e, task->id, true);
+    export_field(e, task->title, false);
+    export_field(e, STATUS_STRINGS[task->status < TXXT_STATUS_COUNT ? task->status : 0], false);
+    export_field(e, PRIORITY_STRINGS[task->priority < TXXT_PRIORITY_COUNT ? task->priority : 0], false);
+    export_field(e, task->service_name, false);
+    export_field(e, intern_lookup(task->assignee_handle), false);
+    export_field(e, due, false);
+    export_end_row(e);
+}
+
+// Snapshot the list as shown and write the header row.
+static void export_begin(uint8_t delimiter) {
+    ExportState* e = &export_state;
+    uint32_t view[TXXT_MAX_TASKS];
+    e->row_count = task_list_view(view);
+    for (uint32_t k = 0; k < e->row_count; k++) {
+        copy_fixed_string(e->ids[k], TXXT_TASK_ID_MAX, (const uint8_t*)app_state.tasks[view[k]].id, TXXT_TASK_ID_MAX);
+    }
+    e->delimiter = delimiter == '\t' ? '\t' : ',';
+    e->cursor = 0;
+    e->rows_written = 0;
+    e->tail = e->head;  // drop what a replaced export left undrained
+    e->phase = EXPORT_RUNNING;
+    static const char* const HEADER[] = { "id", "title", "status", "priority", "service", "assignee", "due" };
+    for (uint32_t i = 0; i < sizeof(HEADER) / sizeof(HEADER[0]); i++) {
+        export_field(e, HEADER[i], i == 0);
+    }
+    export_end_row(e);
+}
+
+// Format rows while the ring has room for a worst-case row and the budget
+// lasts. Rows whose task has gone since the snapshot are skipped.
+static void export_step(double budget_ms) {
+    ExportState* e = &export_state;
+    if (e->phase != EXPORT_RUNNING) {
+        return;
+    }
+    double start = Clay__ProfilingNow();
+    uint32_t rows = 0;
+    while (e->cursor < e->row_count && TXXT_EXPORT_RING_BYTES - (e->head - e->tail) >= TXXT_EXPORT_ROW_MAX) {
+        int32_t index = find_task_by_id(e->ids[e->cursor++]);
+        if (index >= 0) {
+            export_row(e, &app_state.tasks[index]);
+            e->rows_written++;
+        }
+        if (++rows % TXXT_EXPORT_CLOCK_EVERY == 0 && Clay__ProfilingNow() - start >= budget_ms) {
+            break;
+        }
+    }
+    if (e->cursor >= e->row_count) {
+        e->phase = EXPORT_DRAINING;
+    }
+}
+
+static int32_t detail_cache_find(const char* id) {
+    if (id[0] == '\0') {
+        return -1;
+    }
+    for (uint32_t i = 0; i < TXXT_DETAIL_CACHE_SLOTS; i++) {
+        if (string_equals(detail_cache.slots[i].task_id, id)) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+// Cached detail for a task, or 0. Touches the slot for LRU. The task's slot
+// hint is only a shortcut: reloads and upserts drop it while the detail stays
+// cached, so a miss falls back to finding the slot by id.
+static TaskDetail* task_detail_get(Task* task) {
+    int32_t slot = task->detail_slot;
+    if (slot < 0 || slot >= (int32_t)TXXT_DETAIL_CACHE_SLOTS ||
+        !string_equals(detail_cache.slots[slot].task_id, task->id)) {
+        slot = detail_cache_find(task->id);
+        task->detail_slot = (int16_t)slot;
+        if (slot < 0) {
+            return 0;
+        }
+    }
+    TaskDetail* detail = &detail_cache.slots[slot];
+    detail->last_used = ++detail_cache.clock;
+    return detail;
+}
+
+static int32_t detail_queue_find(const char* id) {
+    for (uint32_t i = 0; i < detail_cache.queue_count; i++) {
+        if (string_equals(detail_cache.queue[i].id, id)) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+static void detail_queue_remove(uint32_t index) {
+    for (uint32_t i = index; i + 1 < detail_cache.queue_count; i++) {
+        detail_cache.queue[i] = detail_cache.queue[i + 1];
+    }
+    detail_cache.queue_count--;
+}
+
+// Ask the host for a task's detail tier. Urgent requests (the selected task)
+// jump the queue; prefetches are dropped when the queue is full.
+static void task_detail_request(Task* task, bool urgent) {
+    if (task->id[0] == '\0') {
+        return;
+    }
+    TaskDetail* cached = task_detail_get(task);
+    if (cached && !cached->stale) {
+        return;
+    }
+
+    int32_t existing = detail_queue_find(task->id);
+    if (existing >= 0) {
+        if (!urgent || existing == 0) {
+            return;
+        }
+        DetailRequest request = detail_cache.queue[existing];
+        detail_queue_remove((uint32_t)existing);
+        for (uint32_t i = detail_cache.queue_count; i > 0; i--) {
+            detail_cache.queue[i] = detail_cache.queue[i - 1];
+        }
+        detail_cache.queue[0] = request;
+        detail_cache.queue_count++;
+        return;
+    }
+
+    if (detail_cache.queue_count == TXXT_DETAIL_QUEUE_MAX) {
+        if (!urgent) {
+            return;
+        }
+        detail_cache.queue_count--;
+    }
+
+    uint32_t at = urgent ? 0 : detail_cache.queue_count;
+    for (uint32_t i = detail_cache.queue_count; i > at; i--) {
+        detail_cache.queue[i] = detail_cache.queue[i - 1];
+    }
+    DetailRequest* request = &detail_cache.queue[at];
+    copy_fixed_string(request->id, sizeof(request->id), (const uint8_t*)task->id, TXXT_TASK_ID_MAX);
+    request->requested_at = 0.0;
+    request->drained = false;
+    detail_cache.queue_count++;
+}
+
+static void detail_cache_invalidate(const char* id) {
+    for (uint32_t i = 0; i < TXXT_DETAIL_CACHE_SLOTS; i++) {
+        if (string_equals(detail_cache.slots[i].task_id, id)) {
+            detail_cache.slots[i].task_id[0] = '\0';
+            detail_cache.slots[i].last_used = 0;
+        }
+    }
+}
+
+// Slot for an incoming detail: its existing slot, a free one, or the least
+// recently used.
+static uint32_t detail_cache_slot_for(const char* id) {
+    uint32_t victim = 0;
+    for (uint32_t i = 0; i < TXXT_DETAIL_CACHE_SLOTS; i++) {
+        if (string_equals(detail_cache.slots[i].task_id, id)) {
+            return i;
+        }
+        if (detail_cache.slots[i].last_used < detail_cache.slots[victim].last_used) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+// Gap-buffer editing ---------------------------------------------------------
+
+static inline uint32_t edit_length(const EditField* field) {
+    return TXXT_EDIT_FIELD_MAX - (field->gap_end - field->gap_start);
+}
+
+static inline char edit_byte_at(const EditField* field, uint32_t pos) {
+    return pos < field->gap_start ? field->buffer[pos] : field->buffer[pos + (field->gap_end - field->gap_start)];
+}
+
+static inline bool edit_is_space(char c) {
+    return c == ' ' || c == '\n';
+}
+
+static void edit_move_gap(EditField* field, uint32_t pos) {
+    if (pos < field->gap_start) {
+        uint32_t n = field->gap_start - pos;
+        for (uint32_t i = 1; i <= n; i++) {
+            field->buffer[field->gap_end - i] = field->buffer[field->gap_start - i];
+        }
+        field->gap_start -= n;
+        field->gap_end -= n;
+    } else if (pos > field->gap_start) {
+        uint32_t n = pos - field->gap_start;
+        for (uint32_t i = 0; i < n; i++) {
+            field->buffer[field->gap_start + i] = field->buffer[field->gap_end + i];
+        }
+        field->gap_start += n;
+        field->gap_end += n;
+    }
+}
+
+// Record that bytes [lo, hi) (positions after the edit) changed. Multiple
+// edits between syncs widen the span; everything outside it keeps its tokens.
+static void edit_mark_dirty(EditField* field, uint32_t lo, uint32_t hi) {
+    uint32_t tail = edit_length(field) - hi;
+    if (field->revision == field->synced_revision) {
+        field->dirty_lo = lo;
+        field->dirty_tail = tail;
+    } else {
+        if (lo < field->dirty_lo) field->dirty_lo = lo;
+        if (tail < field->dirty_tail) field->dirty_tail = tail;
+    }
+    field->revision++;
+}
+
+static void edit_field_reset(EditField* field, uint32_t limit, bool multiline) {
+    field->gap_start = 0;
+    field->gap_end = TXXT_EDIT_FIELD_MAX;
+    field->anchor = 0;
+    field->limit = limit < TXXT_EDIT_FIELD_MAX ? limit : TXXT_EDIT_FIELD_MAX;
+    field->multiline = multiline;
+    field->token_count = 0;
+    field->length = 0;
+    field->scroll_x = 0.0f;
+    field->scroll_y = 0.0f;
+    field->geometry_valid = false;
+    edit_mark_dirty(field, 0, 0);
+    field->dirty_lo = 0;
+    field->dirty_tail = 0;
+}
+
+static void edit_delete_range(EditField* field, uint32_t lo, uint32_t hi) {
+    if (hi <= lo) {
+        return;
+    }
+    edit_move_gap(field, lo);
+    field->gap_end += hi - lo;
+    field->anchor = lo;
+    edit_mark_dirty(field, lo, lo);
+}
+
+static void edit_delete_selection(EditField* field) {
+    uint32_t caret = field->gap_start;
+    if (field->anchor < caret) {
+        edit_delete_range(field, field->anchor, caret);
+    } else {
+        edit_delete_range(field, caret, field->anchor);
+    }
+}
+
+// Insert UTF-8 bytes at the caret, replacing the selection. Input beyond the
+// field limit is dropped at a character boundary.
+static void edit_insert(EditField* field, const uint8_t* bytes, uint32_t count) {
+    edit_delete_selection(field);
+
+    uint32_t length = edit_length(field);
+    uint32_t room = field->limit > length ? field->limit - length : 0;
+    if (count > room) {
+        count = room;
+        while (count > 0 && (bytes[count] & 0xC0) == 0x80) {
+            count--;
+        }
+    }
+
+    uint32_t at = field->gap_start;
+    for (uint32_t i = 0; i < count; i++) {
+        char c = (char)bytes[i];
+        if (c == '\r') {
+            continue;
+        }
+        if (c == '\t' || (c == '\n' && !field->multiline)) {
+            c = ' ';
+        }
+        field->buffer[field->gap_start++] = c;
+    }
+    field->anchor = field->gap_start;
+    if (field->gap_start != at) {
+        edit_mark_dirty(field, at, field->gap_start);
+    }
+}
+
+static uint32_t edit_prev_char(const EditField* field, uint32_t pos) {
+    if (pos == 0) {
+        return 0;
+    }
+    pos--;
+    while (pos > 0 && (edit_byte_at(field, pos) & 0xC0) == 0x80) {
+        pos--;
+    }
+    return pos;
+}
+
+static uint32_t edit_next_char(const EditField* field, uint32_t pos) {
+    uint32_t length = edit_length(field);
+    if (pos >= length) {
+        return length;
+    }
+    pos++;
+    while (pos < length && (edit_byte_at(field, pos) & 0xC0) == 0x80) {
+        pos++;
+    }
+    return pos;
+}
+
+static uint32_t edit_prev_word(const EditField* field, uint32_t pos) {
+    while (pos > 0 && edit_is_space(edit_byte_at(field, pos - 1))) pos--;
+    while (pos > 0 && !edit_is_space(edit_byte_at(field, pos - 1))) pos--;
+    return pos;
+}
+
+static uint32_t edit_next_word(const EditField* field, uint32_t pos) {
+    uint32_t length = edit_length(field);
+    while (pos < length && !edit_is_space(edit_byte_at(field, pos))) pos++;
+    while (pos < length && edit_is_space(edit_byte_at(field, pos))) pos++;
+    return pos;
+}
+
+static inline void edit_set_caret(EditField* field, uint32_t pos, bool extend) {
+    edit_move_gap(field, pos);
+    if (!extend) {
+        field->anchor = pos;
+    }
+}
+
+// Width of the first `count` bytes of a token: the word part goes through the
+// host measure function, trailing spaces use the cached space width.
+static float edit_measure_prefix(const EditField* field, uint32_t start, uint32_t count) {
+    uint32_t word = 0;
+    while (word < count && !edit_is_space(field->text[start + word])) {
+        word++;
+    }
+    float width = (float)(count - word) * field->space_width;
+    if (word > 0) {
+        Clay_TextElementConfig config = edit_text_config(COLOR_TEXT);
+        Clay_StringSlice slice = { .length = (int32_t)word, .chars = &field->text[start], .baseChars = field->text };
+        width += Clay__MeasureText(slice, &config, Clay_GetCurrentContext()->measureTextUserData).width;
+    }
+    return width;
+}
+
+static float edit_measure_token(const EditField* field, uint32_t start, uint32_t count) {
+    Clay_String text = { .length = (int32_t)count, .chars = &field->text[start] };
+    Clay_TextElementConfig config = edit_text_config(COLOR_TEXT);
+    return Clay__MeasureTextCached(&text, &config)->unwrappedDimensions.width;
+}
+
+// Rebuild the contiguous text and token list. Tokens entirely before the dirty
+// span, or entirely within the untouched tail, keep their measured width.
+static void edit_field_retokenize(EditField* field) {
+    uint32_t old_count = field->token_count;
+    for (uint32_t i = 0; i < old_count; i++) {
+        edit_token_scratch[i] = field->tokens[i];
+    }
+
+    uint32_t length = edit_length(field);
+    int32_t shift = (int32_t)length - (int32_t)field->length;
+    for (uint32_t i = 0; i < length; i++) {
+        field->text[i] = edit_byte_at(field, i);
+    }
+    field->text[length] = '\0';
+    field->length = length;
+
+    uint32_t lo = field->dirty_lo;
+    uint32_t tail_start = field->dirty_tail < length ? length - field->dirty_tail : 0;
+    uint32_t old_index = 0;
+    uint32_t count = 0;
+    uint32_t pos = 0;
+    while (pos < length) {
+        uint32_t start = pos;
+        if (field->text[pos] == '\n') {
+            pos++;
+        } else {
+            while (pos < length && !edit_is_space(field->text[pos])) pos++;
+            while (pos < length && field->text[pos] == ' ') pos++;
+        }
+
+        float width = -1.0f;
+        if (pos < lo || start >= tail_start) {
+            uint32_t old_start = pos < lo ? start : (uint32_t)((int32_t)start - shift);
+            while (old_index < old_count && edit_token_scratch[old_index].start < old_start) {
+                old_index++;
+            }
+            if (old_index < old_count && edit_token_scratch[old_index].start == old_start &&
+                edit_token_scratch[old_index].length == pos - start) {
+                width = edit_token_scratch[old_index].width;
+            }
+        }
+        if (width < 0.0f) {
+            width = field->text[start] == '\n' ? 0.0f : edit_measure_token(field, start, pos - start);
+        }
+
+        field->tokens[count++] = (EditToken){ .start = (uint16_t)start, .length = (uint16_t)(pos - start), .width = width };
+    }
+    field->token_count = count;
+}
+
+// Greedy line breaking over token widths (single-line fields never wrap).
+static void edit_field_break_lines(EditField* field, float width) {
+    EditLine* line = &field->lines[0];
+    *line = (EditLine){0};
+    float line_width = 0.0f;
+    uint32_t line_count = 1;
+
+    for (uint32_t i = 0; i < field->token_count; i++) {
+        EditToken* token = &field->tokens[i];
+        if (field->text[token->start] == '\n') {
+            line = &field->lines[line_count++];
+            *line = (EditLine){ .first_token = (uint16_t)(i + 1), .start = (uint16_t)(token->start + 1), .end = (uint16_t)(token->start + 1) };
+            line_width = 0.0f;
+            continue;
+        }
+        if (field->multiline && width > 0.0f && line->token_count > 0 && line_width + token->width > width) {
+            line = &field->lines[line_count++];
+            *line = (EditLine){ .first_token = (uint16_t)i, .start = token->start, .end = token->start };
+            line_width = 0.0f;
+        }
+        line->token_count++;
+        line->end = (uint16_t)(token->start + token->length);
+        line_width += token->width;
+    }
+    field->line_count = line_count;
+}
+
+static uint32_t edit_line_of(const EditField* field, uint32_t pos) {
+    uint32_t line = 0;
+    while (line + 1 < field->line_count && field->lines[line + 1].start <= pos) {
+        line++;
+    }
+    return line;
+}
+
+static float edit_x_of(const EditField* field, uint32_t line_index, uint32_t pos) {
+    const EditLine* line = &field->lines[line_index];
+    float x = 0.0f;
+    for (uint32_t i = 0; i < line->token_count; i++) {
+        const EditToken* token = &field->tokens[line->first_token + i];
+        if (pos >= (uint32_t)token->start + token->length) {
+            x += token->width;
+            continue;
+        }
+        if (pos > token->start) {
+            x += edit_measure_prefix(field, token->start, pos - token->start);
+        }
+        break;
+    }
+    return x;
+}
+
+static void edit_field_sync(EditField* field, float width, float height) {
+    if (field->synced_revision != field->revision) {
+        if (field->space_width == 0.0f) {
+            Clay_TextElementConfig config = edit_text_config(COLOR_TEXT);
+            Clay_StringSlice space = { .length = 1, .chars = " ", .baseChars = " " };
+            field->space_width = Clay__MeasureText(space, &config, Clay_GetCurrentContext()->measureTextUserData).width;
+        }
+        edit_field_retokenize(field);
+    }
+    if (field->synced_revision != field->revision || field->synced_width != width) {
+        edit_field_break_lines(field, width);
+        field->synced_revision = field->revision;
+        field->synced_width = width;
+        field->geometry_valid = false;
+    }
+
+    uint32_t caret = field->gap_start;
+    if (field->geometry_valid && field->geometry_caret == caret && field->geometry_anchor == field->anchor) {
+        return;
+    }
+    field->caret_line = edit_line_of(field, caret);
+    field->caret_x = edit_x_of(field, field->caret_line, caret);
+    if (field->anchor == caret) {
+        field->anchor_line = field->caret_line;
+        field->anchor_x = field->caret_x;
+    } else {
+        field->anchor_line = edit_line_of(field, field->anchor);
+        field->anchor_x = edit_x_of(field, field->anchor_line, field->anchor);
+    }
+    field->geometry_caret = caret;
+    field->geometry_anchor = field->anchor;
+    field->geometry_valid = true;
+
+    // Keep the caret in view
+    if (!field->multiline && width > 0.0f) {
+        if (field->caret_x - field->scroll_x > width - 2.0f) field->scroll_x = field->caret_x - width + 2.0f;
+        if (field->caret_x < field->scroll_x) field->scroll_x = field->caret_x;
+    }
+    if (field->multiline && height > 0.0f) {
+        float top = (float)(field->caret_line * TXXT_EDIT_LINE_HEIGHT);
+        if (top + TXXT_EDIT_LINE_HEIGHT - field->scroll_y > height) field->scroll_y = top + TXXT_EDIT_LINE_HEIGHT - height;
+        if (top < field->scroll_y) field->scroll_y = top;
+    }
+}
+
+// Caret position for a point relative to the field's text origin. Token widths
+// locate the token; only that token is measured per character.
+static uint32_t edit_hit_test(const EditField* field, float x, float y) {
+    if (field->line_count == 0) {
+        return 0;
+    }
+    int32_t line_index = (int32_t)(y / (float)TXXT_EDIT_LINE_HEIGHT);
+    if (line_index < 0) line_index = 0;
+    if (line_index >= (int32_t)field->line_count) line_index = (int32_t)field->line_count - 1;
+    const EditLine* line = &field->lines[line_index];
+
+    float left = 0.0f;
+    for (uint32_t i = 0; i < line->token_count; i++) {
+        const EditToken* token = &field->tokens[line->first_token + i];
+        if (x >= left + token->width) {
+            left += token->width;
+            continue;
+        }
+        uint32_t best = token->start;
+        float best_distance = x - left;
+        if (best_distance < 0.0f) best_distance = -best_distance;
+        uint32_t pos = token->start;
+        while (pos < (uint32_t)token->start + token->length) {
+            pos++;
+            while (pos < (uint32_t)token->start + token->length && (field->text[pos] & 0xC0) == 0x80) pos++;
+            float distance = left + edit_measure_prefix(field, token->start, pos - token->start) - x;
+            if (distance < 0.0f) distance = -distance;
+            if (distance < best_distance) {
+                best = pos;
+                best_distance = distance;
+            }
+        }
+        return best;
+    }
+    return line->end;
+}
+
+static inline char ascii_fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + 32) : c;
+}
+
+// Resolve the service field (blanks around it ignored, ASCII case folded)
+// into edit_form.service_index: an exact name, else the only name it starts.
+// Empty means no service. Returns the reason it names none, or 0.
+static const char* edit_form_resolve_service(void) {
+    EditField* field = &edit_form.fields[TXXT_EDIT_FIELD_SERVICE];
+    edit_field_sync(field, field->synced_width, 0.0f);
+    const char* text = field->text;
+    uint32_t length = field->length;
+    while (length > 0 && edit_is_space(text[0])) {
+        text++;
+        length--;
+    }
+    while (length > 0 && edit_is_space(text[length - 1u])) {
+        length--;
+    }
+
+    edit_form.service_index = -1;
+    if (length == 0) {
+        return 0;
+    }
+    int32_t prefix_of = -1;
+    uint32_t prefix_count = 0;
+    for (uint32_t i = 0; i < app_state.service_count; i++) {
+        const char* name = app_state.services[i].name;
+        uint32_t k = 0;
+        while (k < length && name[k] && ascii_fold(name[k]) == ascii_fold(text[k])) {
+            k++;
+        }
+        if (k < length) {
+            continue;
+        }
+        if (name[k] == '\0') {
+            edit_form.service_index = (int32_t)i;
+            return 0;
+        }
+        prefix_of = (int32_t)i;
+        prefix_count++;
+    }
+    if (prefix_count == 1u) {
+        edit_form.service_index = prefix_of;
+        return 0;
+    }
+    return prefix_count == 0 ? "No service has that name" : "More than one service starts with that; type more of the name";
+}
+
+static bool edit_form_validate(void) {
+    edit_form.error = 0;
+    if (edit_length(&edit_form.fields[TXXT_EDIT_FIELD_TITLE]) == 0) {
+        edit_form.focus = (int32_t)TXXT_EDIT_FIELD_TITLE;
+        edit_form.error = "Title is required";
+        return false;
+    }
+    const char* service_error = edit_form_resolve_service();
+    if (service_error) {
+        edit_form.focus = (int32_t)TXXT_EDIT_FIELD_SERVICE;
+        edit_form.error = service_error;
+        return false;
+    }
+    EditField* due = &edit_form.fields[TXXT_EDIT_FIELD_DUE];
+    edit_field_sync(due, due->synced_width, 0.0f);
+    if (due->length > 0 && parse_due_day(due->text) == TXXT_DUE_NONE) {
+        edit_form.focus = (int32_t)TXXT_EDIT_FIELD_DUE;
+        edit_form.error = "Due date must be YYYY-MM-DD";
+        return false;
+    }
+    return true;
+}
+
+static void edit_form_open(int32_t service_index) {
+    edit_field_reset(&edit_form.fields[TXXT_EDIT_FIELD_TITLE], TXXT_TASK_TITLE_MAX - 1u, false);
+    edit_field_reset(&edit_form.fields[TXXT_EDIT_FIELD_DESC], TXXT_TASK_DESC_MAX - 1u, true);
+    edit_field_reset(&edit_form.fields[TXXT_EDIT_FIELD_SERVICE], TXXT_SERVICE_NAME_MAX - 1u, false);
+    edit_field_reset(&edit_form.fields[TXXT_EDIT_FIELD_DUE], TXXT_TASK_DUE_DATE_MAX - 1u, false);
+    edit_form.status = STATUS_PENDING;
+    edit_form.priority = PRIORITY_MEDIUM;
+    edit_form.submit_pending = false;
+    edit_form.service_index = -1;
+    edit_form.error = 0;
+    edit_form.focus = (int32_t)TXXT_EDIT_FIELD_TITLE;
+
+    if (service_index >= 0 && service_index < (int32_t)app_state.service_count) {
+        const char* name = app_state.services[service_index].name;
+        edit_insert(&edit_form.fields[TXXT_EDIT_FIELD_SERVICE], (const uint8_t*)name, str_len(name));
+    }
+}
+
+static void edit_form_click(int32_t field_index, Clay_Vector2 position) {
+    EditField* field = &edit_form.fields[field_index];
+    Clay_ElementData lines = Clay_GetElementData(CLAY_IDI("EditLines", field_index));
+    edit_form.focus = field_index;
+    if (!lines.found) {
+        return;
+    }
+
+    uint32_t pos = edit_hit_test(field, position.x - lines.boundingBox.x, position.y - lines.boundingBox.y);
+    double dt = app_time_seconds - edit_form.last_click_time;
+    if (edit_form.last_click_field == field_index && dt <= 0.35) {
+        // Double click selects the word under the pointer
+        uint32_t lo = pos;
+        uint32_t hi = pos;
+        while (lo > 0 && !edit_is_space(edit_byte_at(field, lo - 1))) lo--;
+        while (hi < edit_length(field) && !edit_is_space(edit_byte_at(field, hi))) hi++;
+        edit_set_caret(field, lo, false);
+        edit_set_caret(field, hi, true);
+    } else {
+        edit_set_caret(field, pos, false);
+    }
+    edit_form.last_click_field = field_index;
+    edit_form.last_click_time = app_time_seconds;
+}
+
+static void edit_form_key(uint32_t key, uint32_t modifiers) {
+    if (edit_form.focus < 0) {
+        return;
+    }
+    EditField* field = &edit_form.fields[edit_form.focus];
+    bool extend = (modifiers & TXXT_KEY_MOD_SHIFT) != 0;
+    bool word = (modifiers & TXXT_KEY_MOD_WORD) != 0;
+    uint32_t caret = field->gap_start;
+    bool has_selection = field->anchor != caret;
+
+    switch (key) {
+        case TXXT_KEY_BACKSPACE:
+            if (has_selection) {
+                edit_delete_selection(field);
+            } else {
+                edit_delete_range(field, word ? edit_prev_word(field, caret) : edit_prev_char(field, caret), caret);
+            }
+            break;
+        case TXXT_KEY_DELETE:
+            if (has_selection) {
+                edit_delete_selection(field);
+            } else {
+                edit_delete_range(field, caret, word ? edit_next_word(field, caret) : edit_next_char(field, caret));
+            }
+            break;
+        case TXXT_KEY_LEFT:
+            if (has_selection && !extend) {
+                edit_set_caret(field, field->anchor < caret ? field->anchor : caret, false);
+            } else {
+                edit_set_caret(field, word ? edit_prev_word(field, caret) : edit_prev_char(field, caret), extend);
+            }
+            break;
+        case TXXT_KEY_RIGHT:
+            if (has_selection && !extend) {
+                edit_set_caret(field, field->anchor > caret ? field->anchor : caret, false);
+            } else {
+                edit_set_caret(field, word ? edit_next_word(field, caret) : edit_next_char(field, caret), extend);
+            }
+            break;
+        case TXXT_KEY_UP:
+        case TXXT_KEY_DOWN: {
+            edit_field_sync(field, field->synced_width, 0.0f);
+            int32_t line = (int32_t)field->caret_line + (key == TXXT_KEY_UP ? -1 : 1);
+            if (line < 0) {
+                edit_set_caret(field, 0, extend);
+            } else if (line >= (int32_t)field->line_count) {
+                edit_set_caret(field, edit_length(field), extend);
+            } else {
+                float y = ((float)line + 0.5f) * (float)TXXT_EDIT_LINE_HEIGHT;
+                edit_set_caret(field, edit_hit_test(field, field->caret_x, y), extend);
+            }
+            break;
+        }
+        case TXXT_KEY_HOME:
+        case TXXT_KEY_END: {
+            edit_field_sync(field, field->synced_width, 0.0f);
+            const EditLine* line = &field->lines[field->caret_line];
+            uint32_t target = key == TXXT_KEY_HOME ? line->start : line->end;
+            if (word) {
+                target = key == TXXT_KEY_HOME ? 0 : edit_length(field);
+            }
+            edit_set_caret(field, target, extend);
+            break;
+        }
+        case TXXT_KEY_TAB: {
+            int32_t step = extend ? (int32_t)TXXT_EDIT_FIELD_COUNT - 1 : 1;
+            edit_form.focus = (edit_form.focus + step) % (int32_t)TXXT_EDIT_FIELD_COUNT;
+            break;
+        }
+        case TXXT_KEY_ENTER:
+            if (field->multiline && !word) {
+                edit_insert(field, (const uint8_t*)"\n", 1);
+            } else if (edit_form_validate()) {
+                edit_form.submit_pending = true;
+            }
+            break;
+        case TXXT_KEY_ESCAPE:
+            app_state.create_panel_visible = false;
+            edit_form.focus = -1;
+            break;
+        case TXXT_KEY_SELECT_ALL:
+            edit_set_caret(field, 0, false);
+            edit_set_caret(field, edit_length(field), true);
+            break;
+        default:
+            break;
+    }
+}
+
+// WASM exports
+CLAY_WASM_EXPORT("SetScratchMemory") void SetScratchMemory(void* memory) {
+    frame_arena.memory = memory;
+}
+
+CLAY_WASM_EXPORT("GetTaskInputBuffer") uint32_t GetTaskInputBuffer(void) {
+    return (uint32_t)(uintptr_t)task_input_buffer;
+}
+
+CLAY_WASM_EXPORT("GetServiceInputBuffer") uint32_t GetServiceInputBuffer(void) {
+    return (uint32_t)(uintptr_t)service_input_buffer;
+}
+
+static void read_task_input_entry(Task* task, const uint8_t* entry) {
+    task->legacy_id = read_u32_le(entry + 0);
+    task->status = (TaskStatus)read_u32_le(entry + 4);
+    task->priority = (Priority)read_u32_le(entry + 8);
+
+    copy_fixed_string(task->id, sizeof(task->id), entry + 12, TXXT_TASK_ID_MAX);
+    copy_fixed_string(task->title, sizeof(task->title), entry + 52, TXXT_TASK_TITLE_MAX);
+    task->preview[0] = '\0';
+    copy_fixed_string(task->service_name, sizeof(task->service_name), entry + 180, TXXT_TASK_SERVICE_NAME_MAX);
+    copy_fixed_string(task->due_date, sizeof(task->due_date), entry + 244, TXXT_TASK_DUE_DATE_MAX);
+
+    task->service_handle = intern_string(task->service_name);
+    task->assignee_handle = 0;
+    task->due_day = parse_due_day(task->due_date);
+    task->scheduled_day = TXXT_DUE_NONE;
+    task->detail_slot = -1;
+    task->selected = false;
+}
+
+// Store task `index` of a full reload.
+static void hydrate_task_slot(uint32_t index, Task* incoming) {
+    app_state.tasks[index] = *incoming;
+}
+
+// Drop the tracks of tasks a full reload no longer holds open. Tasks that
+// leave without a COMPLETED or DELETED event (deleted while disconnected,
+// completed before a resync, evicted by the cap) would otherwise keep their
+// track until the table fills and new tasks go untracked.
+static void cycle_track_prune(void) {
+    for (uint32_t i = 0; i < TXXT_CYCLE_TRACK_SLOTS; i++) {
+        cycle_stats.tracks[i].live = false;
+    }
+    for (uint32_t i = 0; i < app_state.task_count; i++) {
+        uint8_t id[16];
+        CycleTrack* track;
+        if (app_state.tasks[i].status != STATUS_COMPLETED && parse_uuid(app_state.tasks[i].id, id) &&
+            (track = cycle_track_find(id, false))) {
+            track->live = true;
+        }
+    }
+    // Backward shift only pulls already-kept or not-yet-visited entries into
+    // the hole, so recheck the same slot after a removal.
+    for (uint32_t i = 0; i < TXXT_CYCLE_TRACK_SLOTS;) {
+        CycleTrack* track = &cycle_stats.tracks[i];
+        if (track->used && !track->live) {
+            cycle_track_remove(track);
+        } else {
+            i++;
+        }
+    }
+}
+
+static void finish_task_hydration(uint32_t count) {
+    app_state.task_count = count;
+    task_index_rebuild();
+    if (app_state.selected_task_index >= (int32_t)count) {
+        app_state.selected_task_index = -1;
+        app_state.show_detail_panel = false;
+    }
+    aggregates_rebuild();
+    cycle_track_prune();
+}
+
+// Canonical 8-4-4-4-12 lowercase UUID string (the REST ids) from 16 wire bytes.
+static void format_uuid(char* out, const uint8_t* bytes) {
+    static const char hex[] = "0123456789abcdef";
+    uint32_t at = 0;
+    for (uint32_t i = 0; i < 16u; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            out[at++] = '-';
+        }
+        out[at++] = hex[bytes[i] >> 4];
+        out[at++] = hex[bytes[i] & 0x0Fu];
+    }
+    out[at] = '\0';
+}
+
+// Epoch days to "YYYY-MM-DD" (inverse of parse_due_day).
+static void format_due_date(char* out, uint16_t day) {
+    // Civil from days (proleptic Gregorian), 1970-01-01 = 0.
+    int32_t z = (int32_t)day + 719468;
+    int32_t era = z / 146097;
+    int32_t doe = z - era * 146097;
+    int32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int32_t mp = (5 * doy + 2) / 153;
+    int32_t d = doy - (153 * mp + 2) / 5 + 1;
+    int32_t m = mp < 10 ? mp + 3 : mp - 9;
+    int32_t y = yoe + era * 400 + (m <= 2);
+
+    out[0] = (char)('0' + (y / 1000) % 10);
+    out[1] = (char)('0' + (y / 100) % 10);
+    out[2] = (char)('0' + (y / 10) % 10);
+    out[3] = (char)('0' + y % 10);
+    out[4] = '-';
+    out[5] = (char)('0' + m / 10);
+    out[6] = (char)('0' + m % 10);
+    out[7] = '-';
+    out[8] = (char)('0' + d / 10);
+    out[9] = (char)('0' + d % 10);
+    out[10] = '\0';
+}
+
+// Copy string-table entry `offset` (LEB128 length, then bytes) into `dst`.
+// False if the entry runs past the table.
+// Locate the string-table entry at `offset`: its bytes start at *start and
+// run for *length. False if the varint or the bytes overrun the table.
+static bool compact_string_span(const uint8_t* table, uint32_t table_size, uint32_t offset,
+                                uint32_t* start, uint32_t* length) {
+    uint32_t value = 0;
+    uint32_t at = offset;
+    for (uint32_t shift = 0;; shift += 7u) {
+        if (at >= table_size || shift > 28u) {
+            return false;
+        }
+        uint8_t b = table[at++];
+        value |= (uint32_t)(b & 0x7Fu) << shift;
+        if ((b & 0x80u) == 0) {
+            break;
+        }
+    }
+    if (value > table_size - at) {
+        return false;
+    }
+    *start = at;
+    *length = value;
+    return true;
+}
+
+static bool copy_compact_string(char* dst, uint32_t dst_cap, const uint8_t* table, uint32_t table_size, uint32_t offset) {
+    uint32_t start;
+    uint32_t length;
+    if (!compact_string_span(table, table_size, offset, &start, &length)) {
+        return false;
+    }
+    copy_fixed_string(dst, dst_cap, table + start, length);
+    return true;
+}
+
+// Decode the hot fields of a wire task record (bytes 0..56: id, status,
+// priority, date, service id). The title is left to the caller; the wire
+// carries only the assignee's UUID, so the name stays with the detail tier.
+static void read_wire_task(Task* task, const uint8_t* record) {
+    *task = (Task){0};
+    format_uuid(task->id, record);
+
+    // Wire status: 0 staged, 1 scheduled, 2 active, 3 completed.
+    uint8_t status = record[16];
+    task->status = status == 3u ? STATUS_COMPLETED : (status == 2u ? STATUS_IN_PROGRESS : STATUS_PENDING);
+    task->priority = record[17] < TXXT_PRIORITY_COUNT ? (Priority)record[17] : PRIORITY_LOW;
+
+    // The wire date is when the task is scheduled; the wire has no due date.
+    uint16_t date = (uint16_t)(record[18] | (record[19] << 8));
+    task->due_day = TXXT_DUE_NONE;
+    task->scheduled_day = date != TXXT_WIRE_DATE_NONE ? date : TXXT_DUE_NONE;
+
+    char service_id[TXXT_SERVICE_ID_MAX];
+    format_uuid(service_id, record + 24);
+    for (uint32_t i = 0; i < app_state.service_count; i++) {
+        if (string_equals(app_state.services[i].id, service_id)) {
+            copy_fixed_string(task->service_name, sizeof(task->service_name),
+                              (const uint8_t*)app_state.services[i].name, TXXT_SERVICE_NAME_MAX);
+            break;
+        }
+    }
+    task->service_handle = intern_string(task->service_name);
+    task->detail_slot = -1;
+}
+
+CLAY_WASM_EXPORT("ApplyTaskInputBuffer") void ApplyTaskInputBuffer(uint32_t count) {
+    uint32_t max = count;
+    if (max > TXXT_MAX_TASKS) {
+        max = TXXT_MAX_TASKS;
+    }
+
+    for (uint32_t i = 0; i < max; i++) {
+        const uint8_t* entry = task_input_buffer + TXXT_TASK_INPUT_HDR_SIZE + (i * TXXT_TASK_INPUT_STRIDE);
+        Task incoming;
+        read_task_input_entry(&incoming, entry);
+        hydrate_task_slot(i, &incoming);
+    }
+    finish_task_hydration(max);
+    // Cached details keep showing, refetched as their tasks come into view.
+    for (uint32_t i = 0; i < TXXT_DETAIL_CACHE_SLOTS; i++) {
+        detail_cache.slots[i].stale = true;
+    }
+}
+
+// Replace the task with the same UUID in place (keeping its selection), or
+// append it.
+static void upsert_task(Task* incoming) {
+    // The detail tier may be stale now; it is refetched when next needed.
+    detail_cache_invalidate(incoming->id);
+
+    int32_t index = find_task_by_id(incoming->id);
+    if (index >= 0) {
+        Task* task = &app_state.tasks[index];
+        aggregates_apply(task, -1);
+        incoming->selected = task->selected;
+        // Detail-derived: kept until the refetch replaces them.
+        copy_fixed_string(incoming->preview, sizeof(incoming->preview), (const uint8_t*)task->preview, sizeof(task->preview));
+        incoming->assignee_handle = task->assignee_handle;
+        *task = *incoming;
+        aggregates_apply(task, 1);
+    } else if (app_state.task_count < TXXT_MAX_TASKS) {
+        Task* task = &app_state.tasks[app_state.task_count++];
+        *task = *incoming;
+        task_index_insert(app_state.task_count - 1u);
+        aggregates_apply(task, 1);
+    }
+}
+
+static void remove_task_at(int32_t index) {
+    Task* task = &app_state.tasks[index];
+    aggregates_apply(task, -1);
+    detail_cache_invalidate(task->id);
+    dep_drop_task(task->id);
+    int32_t queued = detail_queue_find(task->id);
+    if (queued >= 0) {
+        detail_queue_remove((uint32_t)queued);
+    }
+    task_index_remove((uint32_t)index);
+    for (uint32_t i = (uint32_t)index; i + 1 < app_state.task_count; i++) {
+        app_state.tasks[i] = app_state.tasks[i + 1];
+    }
+    app_state.task_count--;
+
+    if (app_state.selected_task_index == index) {
+        app_state.selected_task_index = -1;
+        app_state.show_detail_panel = false;
+    } else if (app_state.selected_task_index > index) {
+        app_state.selected_task_index--;
+    }
+}
+
+// Upsert a single task from entry `entry_index` of the task input buffer.
+// Existing tasks (matched by UUID) keep their list position.
+CLAY_WASM_EXPORT("UpsertTaskInputEntry") void UpsertTaskInputEntry(uint32_t entry_index) {
+    if (entry_index >= TXXT_MAX_TASKS) {
+        return;
+    }
+
+    Task incoming;
+    read_task_input_entry(&incoming, task_input_buffer + TXXT_TASK_INPUT_HDR_SIZE + (entry_index * TXXT_TASK_INPUT_STRIDE));
+    upsert_task(&incoming);
+}
+
+CLAY_WASM_EXPORT("GetTaskIdInputBuffer") uint32_t GetTaskIdInputBuffer(void) {
+    return (uint32_t)(uintptr_t)task_id_input;
+}
+
+// Remove the task whose UUID is in the task id input buffer. Preserves list order.
+CLAY_WASM_EXPORT("DeleteTaskByIdInput") bool DeleteTaskByIdInput(void) {
+    int32_t index = find_task_by_id(task_id_input);
+    if (index < 0) {
+        return false;
+    }
+    remove_task_at(index);
+    return true;
+}
+
+CLAY_WASM_EXPORT("GetTaskDetailInputBuffer") uint32_t GetTaskDetailInputBuffer(void) {
+    return (uint32_t)(uintptr_t)detail_input_buffer;
+}
+
+// Store the detail tier the host fetched for one task (see TXXT_DETAIL_INPUT_SIZE).
+CLAY_WASM_EXPORT("ApplyTaskDetailInput") void ApplyTaskDetailInput(void) {
+    char id[TXXT_TASK_ID_MAX];
+    copy_fixed_string(id, sizeof(id), detail_input_buffer + 0, TXXT_TASK_ID_MAX);
+
+    int32_t queued = detail_queue_find(id);
+    if (queued >= 0) {
+        detail_queue_remove((uint32_t)queued);
+    }
+    int32_t index = find_task_by_id(id);
+    if (index < 0) {
+        return;
+    }
+
+    uint32_t slot = detail_cache_slot_for(id);
+    TaskDetail* detail = &detail_cache.slots[slot];
+    copy_fixed_string(detail->task_id, sizeof(detail->task_id), (const uint8_t*)id, TXXT_TASK_ID_MAX);
+    copy_fixed_string(detail->description, sizeof(detail->description), detail_input_buffer + 40, TXXT_TASK_DESC_MAX);
+    copy_fixed_string(detail->category, sizeof(detail->category), detail_input_buffer + 552, TXXT_TASK_CATEGORY_MAX);
+    copy_fixed_string(detail->assigned_to, sizeof(detail->assigned_to), detail_input_buffer + 616, TXXT_TASK_ASSIGNED_TO_MAX);
+    detail->last_used = ++detail_cache.clock;
+    detail->stale = false;
+
+    // The card preview and assignee counts come with the detail tier.
+    Task* task = &app_state.tasks[index];
+    copy_preview(task->preview, sizeof(task->preview), detail_input_buffer + 40, TXXT_TASK_DESC_MAX);
+    aggregates_apply(task, -1);
+    task->assignee_handle = intern_string(detail->assigned_to);
+    aggregates_apply(task, 1);
+    task->detail_slot = (int16_t)slot;
+}
+
+CLAY_WASM_EXPORT("GetDetailRequestBuffer") uint32_t GetDetailRequestBuffer(void) {
+    return (uint32_t)(uintptr_t)detail_request_buffer;
+}
+
+// Hand queued detail requests to the host: writes NUL-terminated ids at
+// TXXT_DETAIL_REQUEST_STRIDE and returns how many. Requests still unanswered
+// after TXXT_DETAIL_RETRY_SECONDS are handed out again.
+CLAY_WASM_EXPORT("DrainDetailRequests") uint32_t DrainDetailRequests(void) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < detail_cache.queue_count; i++) {
+        DetailRequest* request = &detail_cache.queue[i];
+        if (request->drained && app_time_seconds - request->requested_at < TXXT_DETAIL_RETRY_SECONDS) {
+            continue;
+        }
+        char* out = (char*)detail_request_buffer + count * TXXT_DETAIL_REQUEST_STRIDE;
+        copy_fixed_string(out, TXXT_DETAIL_REQUEST_STRIDE, (const uint8_t*)request->id, TXXT_TASK_ID_MAX);
+        request->drained = true;
+        request->requested_at = app_time_seconds;
+        count++;
+    }
+    return count;
+}
+
+CLAY_WASM_EXPORT("SetToday") void SetToday(uint32_t epoch_day) {
+    if (epoch_day >= TXXT_DUE_NONE) {
+        epoch_day = TXXT_DUE_NONE - 1u;
+    }
+    if (aggregates.today == (uint16_t)epoch_day) {
+        return;
+    }
+    aggregates.today = (uint16_t)epoch_day;
+    // Overdue depends on the clock, not on any task event. Day rollover is rare; recount once.
+    aggregates_rebuild();
+}
+
+CLAY_WASM_EXPORT("ApplyServiceInputBuffer") void ApplyServiceInputBuffer(uint32_t count) {
+    uint32_t max = count;
+    if (max > 64u) {
+        max = 64u;
+    }
+
+    for (uint32_t i = 0; i < max; i++) {
+        Service* service = &app_state.services[i];
+        const uint8_t* entry = service_input_buffer + TXXT_SERVICE_INPUT_HDR_SIZE + (i * TXXT_SERVICE_INPUT_STRIDE);
+
+        copy_fixed_string(service->id, sizeof(service->id), entry + 0, TXXT_SERVICE_ID_MAX);
+        copy_fixed_string(service->name, sizeof(service->name), entry + 64, TXXT_SERVICE_NAME_MAX);
+    }
+
+    app_state.service_count = max;
+    service_index_rebuild();
+    if (app_state.selected_service_index >= (int32_t)max) {
+        app_state.selected_service_index = -1;
+    }
+}
+
+// Input buffer for a compact snapshot of `length` bytes (0 if it cannot be
+// had). Snapshots past the static buffer get pages grown at the end of linear
+// memory, kept for the next one; the host must re-read memory.buffer after
+// calling this. Native hosts decode from their own buffer instead
+// (apply_compact_snapshot).
+CLAY_WASM_EXPORT("GetSnapshotInputBuffer") uint32_t GetSnapshotInputBuffer(uint32_t length) {
+    if (length > snapshot_input_capacity) {
+#if defined(__wasm__)
+        uint32_t pages = (length + 65535u) / 65536u;
+        uint32_t end = (uint32_t)__builtin_wasm_memory_size(0) * 65536u;
+        bool at_end = snapshot_input != snapshot_input_buffer &&
+                      (uint32_t)(uintptr_t)snapshot_input + snapshot_input_capacity == end;
+        if (at_end) {
+            pages -= snapshot_input_capacity / 65536u; // extend the region in place
+        }
+        int32_t old_pages = (int32_t)__builtin_wasm_memory_grow(0, pages);
+        if (old_pages < 0) {
+            return 0;
+        }
+        if (!at_end) {
+            snapshot_input = (uint8_t*)(uintptr_t)((uint32_t)old_pages * 65536u);
+        }
+        snapshot_input_capacity = (length + 65535u) / 65536u * 65536u;
+#else
+        return 0;
+#endif
+    }
+    return (uint32_t)(uintptr_t)snapshot_input;
+}
+
+// Hydrate services and tasks from a compact wire snapshot frame. Records are
+// decoded straight into the stores (the first TXXT_MAX_TASKS tasks); strings
+// resolve through the table in O(1) per field. Returns false (and leaves the
+// stores untouched) on a malformed frame.
+static bool apply_compact_snapshot(const uint8_t* frame, uint32_t length) {
+    if (length < TXXT_COMPACT_HEADER_SIZE || frame[0] != TXXT_COMPACT_MSG_SNAPSHOT) {
+        return false;
+    }
+
+    uint32_t task_count = read_u32_le(frame + 9);
+    uint32_t service_count = read_u32_le(frame + 13);
+    uint32_t table_size = read_u32_le(frame + 17);
+    uint64_t expected = (uint64_t)TXXT_COMPACT_HEADER_SIZE +
+                        (uint64_t)task_count * TXXT_COMPACT_TASK_STRIDE +
+                        (uint64_t)service_count * TXXT_COMPACT_SERVICE_STRIDE + table_size;
+    if (expected != length) {
+        return false;
+    }
+
+    const uint8_t* tasks = frame + TXXT_COMPACT_HEADER_SIZE;
+    const uint8_t* services = tasks + task_count * TXXT_COMPACT_TASK_STRIDE;
+    const uint8_t* table = services + service_count * TXXT_COMPACT_SERVICE_STRIDE;
+    // Every string must decode before anything is stored, so a bad frame
+    // cannot leave the stores half-replaced.
+    uint32_t start;
+    uint32_t span;
+    for (uint32_t i = 0; i < task_count; i++) {
+        if (!compact_string_span(table, table_size, read_u32_le(tasks + i * TXXT_COMPACT_TASK_STRIDE + 56), &start, &span)) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < service_count; i++) {
+        if (!compact_string_span(table, table_size, read_u32_le(services + i * TXXT_COMPACT_SERVICE_STRIDE + 16), &start, &span)) {
+            return false;
+        }
+    }
+
+    uint32_t service_max = service_count < 64u ? service_count : 64u;
+    for (uint32_t i = 0; i < service_max; i++) {
+        const uint8_t* record = services + i * TXXT_COMPACT_SERVICE_STRIDE;
+        Service* service = &app_state.services[i];
+        format_uuid(service->id, record);
+        copy_compact_string(service->name, sizeof(service->name), table, table_size, read_u32_le(record + 16));
+    }
+    app_state.service_count = service_max;
+    service_index_rebuild();
+    if (app_state.selected_service_index >= (int32_t)service_max) {
+        app_state.selected_service_index = -1;
+    }
+
+    uint32_t task_max = task_count < TXXT_MAX_TASKS ? task_count : TXXT_MAX_TASKS;
+    for (uint32_t i = 0; i < task_max; i++) {
+        const uint8_t* record = tasks + i * TXXT_COMPACT_TASK_STRIDE;
+        Task incoming;
+        read_wire_task(&incoming, record);
+        copy_compact_string(incoming.title, sizeof(incoming.title), table, table_size, read_u32_le(record + 56));
+        hydrate_task_slot(i, &incoming);
+    }
+    finish_task_hydration(task_max);
+    return true;
+}
+
+// apply_compact_snapshot on `length` bytes written at GetSnapshotInputBuffer.
+CLAY_WASM_EXPORT("ApplyCompactSnapshot") bool ApplyCompactSnapshot(uint32_t length) {
+    if (length > snapshot_input_capacity) {
+        return false;
+    }
+    return apply_compact_snapshot(snapshot_input, length);
+}
+
+// Framed length of a wire event by message type (0 = not an event).
+static uint32_t wire_event_length(uint8_t type) {
+    switch (type) {
+        case TXXT_WIRE_TASK_CREATED: return 9u + TXXT_WIRE_TASK_STRIDE;
+        case TXXT_WIRE_TASK_SCHEDULED:
+        case TXXT_WIRE_TASK_MOVED: return TXXT_WIRE_EVENT_HEADER + 6u;
+        case TXXT_WIRE_TASK_UNSCHEDULED:
+        case TXXT_WIRE_TASK_COMPLETED:
+        case TXXT_WIRE_TASK_DELETED: return TXXT_WIRE_EVENT_HEADER;
+        case TXXT_WIRE_DURABLE: return 9u;
+        default: return 0;
+    }
+}
+
+// Apply one framed event to the task store, keeping aggregates in step.
+// Events for tasks this client doesn't hold are ignored.
+static void apply_wire_event(const uint8_t* event) {
+    uint8_t type = event[0];
+    if (type == TXXT_WIRE_DURABLE) {
+        return; // durability ack, no state change
+    }
+    if (type == TXXT_WIRE_TASK_CREATED) {
+        Task incoming;
+        read_wire_task(&incoming, event + 9);
+        copy_fixed_string(incoming.title, sizeof(incoming.title), event + 9 + 56, TXXT_TASK_TITLE_MAX);
+        upsert_task(&incoming);
+        if (find_task_by_id(incoming.id) >= 0) {
+            cycle_stats_apply(event, &incoming);
+        }
+        return;
+    }
+
+    char id[TXXT_TASK_ID_MAX];
+    format_uuid(id, event + 9);
+    int32_t index = find_task_by_id(id);
+    if (index < 0) {
+        return;
+    }
+    Task* task = &app_state.tasks[index];
+    cycle_stats_apply(event, task);
+    if (type == TXXT_WIRE_TASK_DELETED) {
+        remove_task_at(index);
+        return;
+    }
+
+    aggregates_apply(task, -1);
+    switch (type) {
+        case TXXT_WIRE_TASK_SCHEDULED:
+        case TXXT_WIRE_TASK_MOVED: {
+            if (type == TXXT_WIRE_TASK_SCHEDULED) {
+                task->status = STATUS_PENDING;
+            }
+            uint16_t date = (uint16_t)(event[25] | (event[26] << 8));
+            task->scheduled_day = date != TXXT_WIRE_DATE_NONE ? date : TXXT_DUE_NONE;
+            break;
+        }
+        case TXXT_WIRE_TASK_UNSCHEDULED:
+            task->status = STATUS_PENDING;
+            task->scheduled_day = TXXT_DUE_NONE;
+            break;
+        case TXXT_WIRE_TASK_COMPLETED:
+            task->status = STATUS_COMPLETED;
+            break;
+    }
+    aggregates_apply(task, 1);
+}
+
+CLAY_WASM_EXPORT("GetEventInputBuffer") uint32_t GetEventInputBuffer(void) {
+    return (uint32_t)(uintptr_t)event_input_buffer;
+}
+
+// HELLO's hydrated revision: the events up to it that follow are replayed.
+CLAY_WASM_EXPORT("SetReplayHorizon") void SetReplayHorizon(uint64_t revision) {
+    cycle_stats.replay_horizon = revision;
+}
+
+// Apply a game-socket frame of `length` bytes from the event input buffer:
+// one event, or a batch applied in a single call. Returns how many events
+// were applied; a malformed event stops the batch there.
+CLAY_WASM_EXPORT("ApplyEventFrame") uint32_t ApplyEventFrame(uint32_t length) {
+    const uint8_t* frame = event_input_buffer;
+    if (length == 0 || length > TXXT_EVENT_INPUT_MAX) {
+        return 0;
+    }
+
+    uint32_t count = 1;
+    uint32_t at = 0;
+    if (frame[0] == TXXT_WIRE_BATCH) {
+        if (length < TXXT_WIRE_BATCH_HEADER) {
+            return 0;
+        }
+        count = (uint32_t)frame[1] | ((uint32_t)frame[2] << 8);
+        at = TXXT_WIRE_BATCH_HEADER;
+    }
+
+    uint32_t applied = 0;
+    for (; applied < count; applied++) {
+        uint32_t event_length = at < length ? wire_event_length(frame[at]) : 0;
+        if (event_length == 0 || event_length > length - at) {
+            break;
+        }
+        apply_wire_event(frame + at);
+        at += event_length;
+    }
+    return applied;
+}
+
+CLAY_WASM_EXPORT("GetCurrentUserBuffer") uint32_t GetCurrentUserBuffer(void) {
+    return (uint32_t)(uintptr_t)app_state.current_user;
+}
+
+CLAY_WASM_EXPORT("GetSeriesInputBuffer") uint32_t GetSeriesInputBuffer(uint32_t slot) {
+    if (slot >= TXXT_MAX_SERIES) {
+        return 0;
+    }
+    return (uint32_t)(uintptr_t)chart_series[slot].values;
+}
+
+// Commit `count` samples written into the series buffer. The y range is
+// scanned once here so packing never touches the raw samples again.
+CLAY_WASM_EXPORT("CommitSeries") void CommitSeries(uint32_t slot, uint32_t count) {
+    if (slot >= TXXT_MAX_SERIES) {
+        return;
+    }
+    ChartSeries* series = &chart_series[slot];
+    if (count > TXXT_SERIES_MAX_POINTS) {
+        count = TXXT_SERIES_MAX_POINTS;
+    }
+
+    float lo = 0.0f;
+    float hi = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        float v = series->values[i];
+        if (i == 0 || v < lo) lo = v;
+        if (i == 0 || v > hi) hi = v;
+    }
+
+    series->count = count;
+    series->min_value = lo;
+    series->max_value = hi;
+    series->revision++;
+}
+
+static void series_append(uint32_t slot, float value) {
+    ChartSeries* series = &chart_series[slot];
+    uint32_t count = series->count;
+    if (count == TXXT_SERIES_MAX_POINTS) {
+        // Full: keep the newer half so appends stay amortized O(1).
+        uint32_t keep = TXXT_SERIES_MAX_POINTS / 2u;
+        for (uint32_t i = 0; i < keep; i++) {
+            series->values[i] = series->values[count - keep + i];
+        }
+        count = keep;
+    }
+    series->values[count] = value;
+    CommitSeries(slot, count + 1u);
+}
+
+// Sample throughput and burndown once per interval after the first task load.
+// A reload that drops completed tasks counts as zero throughput, not negative.
+static void series_sample(void) {
+    if (app_state.task_count == 0 || app_time_seconds < series_sampler.next_at) {
+        return;
+    }
+    series_sampler.next_at = app_time_seconds + TXXT_SERIES_SAMPLE_SECONDS;
+
+    uint32_t completed = aggregates.status_total[STATUS_COMPLETED];
+    uint32_t open = aggregates.status_total[STATUS_PENDING] + aggregates.status_total[STATUS_IN_PROGRESS];
+    if (series_sampler.primed) {
+        uint32_t done = completed > series_sampler.last_completed ? completed - series_sampler.last_completed : 0u;
+        series_append(TXXT_SERIES_THROUGHPUT, (float)done);
+    }
+    series_sampler.last_completed = completed;
+    series_sampler.primed = true;
+    series_append(TXXT_SERIES_BURNDOWN, (float)open);
+}
+
+CLAY_WASM_EXPORT("SetDataDirtyPulse") void SetDataDirtyPulse(float seconds) {
+    float duration = seconds > 0.0f ? seconds : 0.35f;
+    data_pulse_duration = duration;
+    if (data_pulse_remaining < duration) {
+        data_pulse_remaining = duration;
+    }
+}
+
+// Dependency links arrive as records in the dependency input buffer
+// (TXXT_DEP_INPUT_STRIDE bytes each, UUIDs as 16 wire bytes).
+CLAY_WASM_EXPORT("GetDependencyInputBuffer") uint32_t GetDependencyInputBuffer(void) {
+    return (uint32_t)(uintptr_t)dep_input_buffer;
+}
+
+// [blocker][blocked] pairs. Returns how many links are now in place; a link
+// that would close a cycle is rejected and counted instead.
+CLAY_WASM_EXPORT("AddDependencies") uint32_t AddDependencies(uint32_t count) {
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < count && i < TXXT_DEP_INPUT_MAX; i++) {
+        const uint8_t* record = dep_input_buffer + i * TXXT_DEP_INPUT_STRIDE;
+        int32_t from = dep_node_find(record, true);
+        int32_t to = dep_node_find(record + 16, true);
+        if (from >= 0 && to >= 0 && dep_add_edge((uint16_t)from, (uint16_t)to)) {
+            added++;
+        }
+    }
+    return added;
+}
+
+CLAY_WASM_EXPORT("RemoveDependencies") uint32_t RemoveDependencies(uint32_t count) {
+    uint32_t removed = 0;
+    for (uint32_t i = 0; i < count && i < TXXT_DEP_INPUT_MAX; i++) {
+        const uint8_t* record = dep_input_buffer + i * TXXT_DEP_INPUT_STRIDE;
+        int32_t from = dep_node_find(record, false);
+        int32_t to = dep_node_find(record + 16, false);
+        if (from >= 0 && to >= 0 && dep_remove_edge((uint16_t)from, (uint16_t)to)) {
+            removed++;
+        }
+    }
+    return removed;
+}
+
+// [task][f32 duration @16] records; durations are in days (default 1).
+CLAY_WASM_EXPORT("SetDependencyDurations") void SetDependencyDurations(uint32_t count) {
+    for (uint32_t i = 0; i < count && i < TXXT_DEP_INPUT_MAX; i++) {
+        const uint8_t* record = dep_input_buffer + i * TXXT_DEP_INPUT_STRIDE;
+        int32_t node = dep_node_find(record, true);
+        union { uint32_t bits; float value; } duration = { .bits = read_u32_le(record + 16) };
+        if (node >= 0 && duration.value >= 0.0f && duration.value != dep_graph.duration[node]) {
+            dep_graph.duration[node] = duration.value;
+            dep_queue((uint16_t)node);
+        }
+    }
+    dep_repair();
+}
+
+// Per-node arrays are initialised as nodes are created, so only the index
+// and counters need resetting.
+CLAY_WASM_EXPORT("ClearDependencies") void ClearDependencies(void) {
+    DepGraph* g = &dep_graph;
+    for (uint32_t i = 0; i < TXXT_DEP_HASH_SLOTS; i++) {
+        g->hash[i] = 0;
+    }
+    g->node_count = 0;
+    g->edge_count = 0;
+    g->live_edges = 0;
+    g->csr_edges = 0;
+    g->csr_nodes = 0;
+    g->rejected_cycles = 0;
+    g->critical_dirty = true;
+}
+
+CLAY_WASM_EXPORT("GetDependencyEdgeCount") uint32_t GetDependencyEdgeCount(void) {
+    return dep_graph.live_edges;
+}
+
+CLAY_WASM_EXPORT("GetRejectedDependencyCount") uint32_t GetRejectedDependencyCount(void) {
+    return dep_graph.rejected_cycles;
+}
+
+CLAY_WASM_EXPORT("GetCriticalPathLength") float GetCriticalPathLength(void) {
+    dep_refresh_critical();
+    return dep_graph.critical_length;
+}
+
+CLAY_WASM_EXPORT("SetDependencyView") void SetDependencyView(bool enabled) {
+    dep_view_enabled = enabled;
+}
+
+CLAY_WASM_EXPORT("GetRecurrenceInputBuffer") uint32_t GetRecurrenceInputBuffer(void) {
+    return (uint32_t)(uintptr_t)recur_input_buffer;
+}
+
+// Add or replace the rule in the recurrence input buffer (matched by id).
+// Its overrides are kept; ones that no longer land on an occurrence are ignored.
+CLAY_WASM_EXPORT("UpsertRecurrenceRule") bool UpsertRecurrenceRule(void) {
+    RecurStore* store = &recur_store;
+    const uint8_t* input = recur_input_buffer;
+    int32_t index = recur_rule_find(input);
+    if (index < 0) {
+        for (uint32_t i = 0; i < store->rule_count && index < 0; i++) {
+            if (!store->rules[i].used) {
+                index = (int32_t)i;
+            }
+        }
+        if (index < 0 && store->rule_count < TXXT_RECUR_RULES_MAX) {
+            index = (int32_t)store->rule_count++;
+        }
+        if (index < 0) {
+            return false;
+        }
+    }
+    RecurRule* rule = &store->rules[index];
+    for (uint32_t i = 0; i < 16u; i++) {
+        rule->id[i] = input[i];
+    }
+    rule->start_day = (uint16_t)(input[16] | (input[17] << 8));
+    rule->until_day = (uint16_t)(input[18] | (input[19] << 8));
+    rule->interval = (uint16_t)(input[20] | (input[21] << 8));
+    rule->kind = input[22] == RECUR_WEEKLY ? RECUR_WEEKLY : RECUR_DAILY;
+    rule->weekdays = input[23] & 0x7Fu;
+    rule->priority = input[24] < TXXT_PRIORITY_COUNT ? input[24] : PRIORITY_LOW;
+    copy_fixed_string(rule->title, sizeof(rule->title), input + 32, TXXT_RECUR_TITLE_MAX);
+    if (rule->interval == 0) {
+        rule->interval = 1;
+    }
+    rule->used = true;
+    store->revision++;
+    return true;
+}
+
+CLAY_WASM_EXPORT("RemoveRecurrenceRule") bool RemoveRecurrenceRule(void) {
+    int32_t index = recur_rule_find(recur_input_buffer);
+    if (index < 0) {
+        return false;
     }
-    return -1;
+    recur_remove_rule((uint32_t)index);
+    return true;
 }
 
-static inline uint8_t pulse_alpha(void) {
-    if (data_pulse_remaining <= 0.0f || data_pulse_duration <= 0.0f) {
-        return 0;
+// Complete, skip or move one occurrence (state pending and not moved resets it).
+CLAY_WASM_EXPORT("SetRecurrenceOverride") bool SetRecurrenceOverride(void) {
+    const uint8_t* input = recur_input_buffer;
+    int32_t index = recur_rule_find(input);
+    if (index < 0 || input[20] > RECUR_OCC_SKIPPED) {
+        return false;
     }
-    float t = data_pulse_remaining / data_pulse_duration;
-    if (t < 0.0f) t = 0.0f;
-    if (t > 1.0f) t = 1.0f;
-    float a = 30.0f + (1.0f - t) * 140.0f;
-    if (a < 0.0f) a = 0.0f;
-    if (a > 255.0f) a = 255.0f;
-    return (uint8_t)a;
+    uint16_t day = (uint16_t)(input[16] | (input[17] << 8));
+    uint16_t moved_to = (uint16_t)(input[18] | (input[19] << 8));
+    return recur_set_override((uint16_t)index, day, moved_to, input[20]);
 }
 
-// WASM exports
-CLAY_WASM_EXPORT("SetScratchMemory") void SetScratchMemory(void* memory) {
-    frame_arena.memory = memory;
+// First visible day of the schedule strip (TXXT_DUE_NONE = this week).
+CLAY_WASM_EXPORT("SetScheduleWindow") void SetScheduleWindow(uint32_t first_day, bool visible) {
+    schedule_first_day = first_day < TXXT_DUE_NONE - TXXT_SCHEDULE_DAYS ? (uint16_t)first_day : TXXT_DUE_NONE;
+    schedule_visible = visible;
 }
 
-CLAY_WASM_EXPORT("GetTaskInputBuffer") uint32_t GetTaskInputBuffer(void) {
-    return (uint32_t)(uintptr_t)task_input_buffer;
+CLAY_WASM_EXPORT("GetRecurrenceExpansionCount") uint32_t GetRecurrenceExpansionCount(void) {
+    return recur_store.expansions;
 }
 
-CLAY_WASM_EXPORT("GetServiceInputBuffer") uint32_t GetServiceInputBuffer(void) {
-    return (uint32_t)(uintptr_t)service_input_buffer;
+// Start a bulk import. delimiter: ',' or '\t' (0 = detect from the first line).
+CLAY_WASM_EXPORT("BeginImport") void BeginImport(uint32_t delimiter) {
+    ImportState* s = &import_state;
+    s->delimiter = (uint8_t)delimiter;
+    s->started = false;
+    s->header_done = false;
+    s->header_valid = false;
+    s->in_quotes = false;
+    s->quote_closed = false;
+    for (uint32_t c = 0; c < TXXT_IMPORT_COLUMNS_MAX; c++) {
+        s->field_length[c] = 0;
+    }
+    s->truncated = 0;
+    s->field = 0;
+    s->records = 0;
+    s->accepted = 0;
+    for (uint32_t r = 0; r < IMPORT_REJECT_KINDS; r++) {
+        s->rejected[r] = 0;
+    }
+    s->first_rejected_row = 0;
+    s->batch[0] = TXXT_WIRE_CMD_BATCH;
+    s->batch[1] = 0;
+    s->batch[2] = 0;
+    s->batch_length = TXXT_WIRE_CMD_BATCH_HEADER;
 }
 
-CLAY_WASM_EXPORT("ApplyTaskInputBuffer") void ApplyTaskInputBuffer(uint32_t count) {
-    uint32_t max = count;
-    if (max > TXXT_MAX_TASKS) {
-        max = TXXT_MAX_TASKS;
+CLAY_WASM_EXPORT("GetImportInputBuffer") uint32_t GetImportInputBuffer(void) {
+    return (uint32_t)(uintptr_t)import_input_buffer;
+}
+
+// Parse the next `length` bytes of the import input buffer; `last` ends the
+// text (a final row without a line feed still counts). Returns the rows
+// accepted into the batch so far.
+CLAY_WASM_EXPORT("ImportChunk") uint32_t ImportChunk(uint32_t length, bool last) {
+    ImportState* s = &import_state;
+    const uint8_t* data = import_input_buffer;
+    if (s->batch_length == 0) {
+        BeginImport(s->delimiter);
+    }
+    if (length > TXXT_IMPORT_CHUNK_MAX) {
+        length = TXXT_IMPORT_CHUNK_MAX;
+    }
+    if (!s->started) {
+        s->started = true;
+        if (length >= 3u && data[0] == 0xEFu && data[1] == 0xBBu && data[2] == 0xBFu) {
+            data += 3;
+            length -= 3u;
+        }
+        if (s->delimiter == 0) {
+            uint32_t tabs = 0;
+            uint32_t commas = 0;
+            for (uint32_t i = 0; i < length && data[i] != '\n'; i++) {
+                tabs += data[i] == '\t';
+                commas += data[i] == ',';
+            }
+            s->delimiter = tabs > commas ? '\t' : ',';
+        }
+    }
+    import_scan(s, data, length);
+    if (last && (s->field > 0 || s->field_length[0] > 0 || s->in_quotes)) {
+        s->in_quotes = false;
+        import_end_row(s);
     }
+    return s->accepted;
+}
 
-    for (uint32_t i = 0; i < max; i++) {
-        Task* task = &app_state.tasks[i];
-        const uint8_t* entry = task_input_buffer + TXXT_TASK_INPUT_HDR_SIZE + (i * TXXT_TASK_INPUT_STRIDE);
+CLAY_WASM_EXPORT("IsImportHeaderValid") bool IsImportHeaderValid(void) {
+    return import_state.header_valid;
+}
 
-        task->legacy_id = read_u32_le(entry + 0);
-        task->status = (TaskStatus)read_u32_le(entry + 4);
-        task->priority = (Priority)read_u32_le(entry + 8);
+// Data rows refused for `reason` (ImportReject).
+CLAY_WASM_EXPORT("GetImportRejectedCount") uint32_t GetImportRejectedCount(uint32_t reason) {
+    return reason < IMPORT_REJECT_KINDS ? import_state.rejected[reason] : 0;
+}
 
-        copy_fixed_string(task->id, sizeof(task->id), entry + 12, TXXT_TASK_ID_MAX);
-        copy_fixed_string(task->title, sizeof(task->title), entry + 52, TXXT_TASK_TITLE_MAX);
-        copy_fixed_string(task->description, sizeof(task->description), entry + 180, TXXT_TASK_DESC_MAX);
-        copy_fixed_string(task->category, sizeof(task->category), entry + 692, TXXT_TASK_CATEGORY_MAX);
-        copy_fixed_string(task->service_name, sizeof(task->service_name), entry + 756, TXXT_TASK_SERVICE_NAME_MAX);
-        copy_fixed_string(task->due_date, sizeof(task->due_date), entry + 820, TXXT_TASK_DUE_DATE_MAX);
-        copy_fixed_string(task->assigned_to, sizeof(task->assigned_to), entry + 852, TXXT_TASK_ASSIGNED_TO_MAX);
+CLAY_WASM_EXPORT("GetImportFirstRejectedRow") uint32_t GetImportFirstRejectedRow(void) {
+    return import_state.first_rejected_row;
+}
 
-        task->selected = false;
-    }
+// The command batch frame (wire.rs COMMAND_BATCH_HEADER), ready to send.
+CLAY_WASM_EXPORT("GetImportBatch") uint32_t GetImportBatch(void) {
+    return (uint32_t)(uintptr_t)import_state.batch;
+}
 
-    app_state.task_count = max;
-    if (app_state.selected_task_index >= (int32_t)max) {
-        app_state.selected_task_index = -1;
-        app_state.show_detail_panel = false;
-    }
+CLAY_WASM_EXPORT("GetImportBatchLength") uint32_t GetImportBatchLength(void) {
+    return import_state.batch_length;
 }
 
-CLAY_WASM_EXPORT("ApplyServiceInputBuffer") void ApplyServiceInputBuffer(uint32_t count) {
-    uint32_t max = count;
-    if (max > 64u) {
-        max = 64u;
+// Export the task list as shown. delimiter: ',' (CSV) or '\t' (TSV). Rows
+// are formatted after each frame (UpdateDrawFrame); drain them with
+// GetExportReadable / ConsumeExport. Restarts a running export. Returns the
+// row count.
+CLAY_WASM_EXPORT("BeginExport") uint32_t BeginExport(uint32_t delimiter) {
+    export_begin((uint8_t)delimiter);
+    return export_state.row_count;
+}
+
+// ExportPhase. A finished export reports EXPORT_DRAINING until its last byte
+// is consumed, then goes idle.
+CLAY_WASM_EXPORT("GetExportPhase") uint32_t GetExportPhase(void) {
+    ExportState* e = &export_state;
+    if (e->phase == EXPORT_DRAINING && e->head == e->tail) {
+        e->phase = EXPORT_IDLE;
     }
+    return e->phase;
+}
 
-    for (uint32_t i = 0; i < max; i++) {
-        Service* service = &app_state.services[i];
-        const uint8_t* entry = service_input_buffer + TXXT_SERVICE_INPUT_HDR_SIZE + (i * TXXT_SERVICE_INPUT_STRIDE);
+CLAY_WASM_EXPORT("GetExportReadPointer") uint32_t GetExportReadPointer(void) {
+    return (uint32_t)(uintptr_t)(export_state.ring + (export_state.tail & (TXXT_EXPORT_RING_BYTES - 1u)));
+}
 
-        copy_fixed_string(service->id, sizeof(service->id), entry + 0, TXXT_SERVICE_ID_MAX);
-        copy_fixed_string(service->name, sizeof(service->name), entry + 64, TXXT_SERVICE_NAME_MAX);
-    }
+// Bytes readable in one piece from GetExportReadPointer (the ring may wrap).
+CLAY_WASM_EXPORT("GetExportReadable") uint32_t GetExportReadable(void) {
+    const ExportState* e = &export_state;
+    uint32_t to_end = TXXT_EXPORT_RING_BYTES - (e->tail & (TXXT_EXPORT_RING_BYTES - 1u));
+    uint32_t pending = e->head - e->tail;
+    return pending < to_end ? pending : to_end;
+}
 
-    app_state.service_count = max;
-    if (app_state.selected_service_index >= (int32_t)max) {
-        app_state.selected_service_index = -1;
-    }
+CLAY_WASM_EXPORT("ConsumeExport") void ConsumeExport(uint32_t length) {
+    ExportState* e = &export_state;
+    e->tail += length < e->head - e->tail ? length : e->head - e->tail;
 }
 
-CLAY_WASM_EXPORT("GetCurrentUserBuffer") uint32_t GetCurrentUserBuffer(void) {
-    return (uint32_t)(uintptr_t)app_state.current_user;
+CLAY_WASM_EXPORT("GetExportDelimiter") uint32_t GetExportDelimiter(void) {
+    return export_state.delimiter;
 }
 
-CLAY_WASM_EXPORT("SetDataDirtyPulse") void SetDataDirtyPulse(float seconds) {
-    float duration = seconds > 0.0f ? seconds : 0.35f;
-    data_pulse_duration = duration;
-    if (data_pulse_remaining < duration) {
-        data_pulse_remaining = duration;
-    }
+CLAY_WASM_EXPORT("GetExportRowsWritten") uint32_t GetExportRowsWritten(void) {
+    return export_state.rows_written;
 }
 
 #define TXXT_PACKED_CMD_SIZE 64u
-#define TXXT_PACKED_HDR_SIZE 16u
+#define TXXT_PACKED_HDR_SIZE 32u
+#define TXXT_PACKED_LAYER_SIZE 32u
+// Must match CMD_BUFFER_BYTES in dist/index.html. Series vertices are packed
+// after the fixed-stride commands and must fit in the same buffer.
+#define TXXT_CMD_BUFFER_BYTES (1024u * 1024u)
 
 static inline void write_u16(uint8_t* p, uint16_t v) {
     p[0] = (uint8_t)(v & 0xff);
@@ -1206,23 +5784,202 @@ static inline void write_f32(uint8_t* p, float v) {
     write_u32(p, u.u);
 }
 
-static void PackRenderCommands(uint32_t scratch_address, Clay_RenderCommandArray cmds) {
-    if (scratch_address == 0) {
+// Retained layers: top-level panels the renderer composites from a cached
+// bitmap for as long as their content hash is unchanged. Order is the layer
+// id; must match RETAINED_LAYER_COUNT in dist/index.html.
+static const Clay_String retained_layer_panels[] = {
+    CLAY_STRING_CONST("Sidebar"),
+    CLAY_STRING_CONST("TaskListHeader"),
+    CLAY_STRING_CONST("TaskScroll"),
+    CLAY_STRING_CONST("DockPanel"),
+};
+#define TXXT_LAYER_COUNT (sizeof(retained_layer_panels) / sizeof(retained_layer_panels[0]))
+
+static uint32_t hash_fnv1a_bytes(uint32_t hash, const uint8_t* bytes, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Hash of everything a layer's commands draw: the packed commands, with the
+// text pointer and vertex offset replaced by the text and vertices they point
+// at, so a panel whose strings or series merely moved in memory still matches.
+static uint32_t hash_layer(const uint8_t* base, const uint8_t* packed, Clay_RenderCommandArray cmds, int32_t start, int32_t end) {
+    uint32_t hash = 2166136261u;
+    for (int32_t i = start; i < end; i++) {
+        Clay_RenderCommand* cmd = &cmds.internalArray[i];
+        uint8_t c[TXXT_PACKED_CMD_SIZE];
+        for (uint32_t j = 0; j < TXXT_PACKED_CMD_SIZE; j++) {
+            c[j] = packed[(uint32_t)i * TXXT_PACKED_CMD_SIZE + j];
+        }
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_TEXT) {
+            write_u32(c + 20, 0);
+            hash = hash_fnv1a_bytes(hash, (const uint8_t*)cmd->renderData.text.stringContents.chars,
+                                    (uint32_t)cmd->renderData.text.stringContents.length);
+        } else if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_CUSTOM) {
+            uint32_t vertex_offset = (uint32_t)c[56] | ((uint32_t)c[57] << 8) | ((uint32_t)c[58] << 16) | ((uint32_t)c[59] << 24);
+            uint32_t vertex_count = (uint32_t)c[60] | ((uint32_t)c[61] << 8);
+            write_u32(c + 56, 0);
+            hash = hash_fnv1a_bytes(hash, base + vertex_offset, vertex_count * 8u);
+        }
+        hash = hash_fnv1a_bytes(hash, c, TXXT_PACKED_CMD_SIZE);
+    }
+    return hash;
+}
+
+// Layer table, after the series vertices. Per layer:
+// u32 first_command, u32 command_count (0 = not drawn this frame),
+// u32 content_hash, u32 layer_id, f32 x, y, width, height (panel bounds).
+// Every command of a layer lies in [first_command, first_command + command_count)
+// and draws within the panel bounds, on top of whatever precedes it.
+static uint32_t PackRetainedLayers(uint8_t* base, uint32_t table_start, Clay_RenderCommandArray cmds) {
+    if (table_start + TXXT_LAYER_COUNT * TXXT_PACKED_LAYER_SIZE > TXXT_CMD_BUFFER_BYTES) {
+        return 0;
+    }
+
+    const uint8_t* packed = base + TXXT_PACKED_HDR_SIZE;
+    for (uint32_t i = 0; i < TXXT_LAYER_COUNT; i++) {
+        uint8_t* l = base + table_start + i * TXXT_PACKED_LAYER_SIZE;
+        for (uint32_t j = 0; j < TXXT_PACKED_LAYER_SIZE; j++) {
+            l[j] = 0;
+        }
+        write_u32(l + 12, i);
+
+        Clay_ElementId id = Clay_GetElementId(retained_layer_panels[i]);
+        Clay_ElementRenderRange range = Clay_GetElementRenderRange(id);
+        Clay_ElementData panel = Clay_GetElementData(id);
+        if (!range.found || !panel.found || range.start >= range.end || range.end > cmds.length) {
+            continue;
+        }
+
+        write_u32(l + 0, (uint32_t)range.start);
+        write_u32(l + 4, (uint32_t)(range.end - range.start));
+        write_u32(l + 8, hash_layer(base, packed, cmds, range.start, range.end));
+        write_f32(l + 16, panel.boundingBox.x);
+        write_f32(l + 20, panel.boundingBox.y);
+        write_f32(l + 24, panel.boundingBox.width);
+        write_f32(l + 28, panel.boundingBox.height);
+    }
+    return TXXT_LAYER_COUNT;
+}
+
+static inline void series_emit_vertex(ChartSeries* series, uint32_t index, float x_scale, float y_scale, float height) {
+    float x = (float)index * x_scale;
+    float y = height - (series->values[index] - series->min_value) * y_scale;
+    if (series->max_value <= series->min_value) {
+        y = height * 0.5f;
+    }
+    series->vertices[series->vertex_count * 2 + 0] = x;
+    series->vertices[series->vertex_count * 2 + 1] = y;
+    series->vertex_count++;
+}
+
+// Largest-Triangle-Three-Buckets: keep the first and last samples, and from each
+// bucket in between the sample forming the largest triangle with the previously
+// kept sample and the next bucket's average. Produces `threshold` vertices in
+// element-local pixels.
+static void series_downsample_lttb(ChartSeries* series, uint32_t threshold, float width, float height) {
+    uint32_t count = series->count;
+    float x_scale = count > 1 ? width / (float)(count - 1) : 0.0f;
+    float range = series->max_value - series->min_value;
+    float y_scale = range > 0.0f ? height / range : 0.0f;
+
+    series->vertex_count = 0;
+    if (threshold >= count || threshold < 3) {
+        uint32_t n = count < TXXT_SERIES_MAX_VERTICES ? count : TXXT_SERIES_MAX_VERTICES;
+        for (uint32_t i = 0; i < n; i++) {
+            series_emit_vertex(series, i, x_scale, y_scale, height);
+        }
         return;
     }
 
-    uint8_t* base = (uint8_t*)(uintptr_t)scratch_address;
+    const float* v = series->values;
+    float every = (float)(count - 2) / (float)(threshold - 2);
+    uint32_t a = 0;
+    series_emit_vertex(series, a, x_scale, y_scale, height);
+
+    for (uint32_t i = 0; i < threshold - 2; i++) {
+        // Average of the next bucket
+        uint32_t avg_start = (uint32_t)((float)(i + 1) * every) + 1;
+        uint32_t avg_end = (uint32_t)((float)(i + 2) * every) + 1;
+        if (avg_end > count) avg_end = count;
+        float avg_x = 0.0f;
+        float avg_y = 0.0f;
+        for (uint32_t j = avg_start; j < avg_end; j++) {
+            avg_x += (float)j;
+            avg_y += v[j];
+        }
+        float avg_len = (float)(avg_end - avg_start);
+        if (avg_len > 0.0f) {
+            avg_x /= avg_len;
+            avg_y /= avg_len;
+        }
+
+        // Pick the point in this bucket with the largest triangle area
+        uint32_t range_start = (uint32_t)((float)i * every) + 1;
+        uint32_t range_end = (uint32_t)((float)(i + 1) * every) + 1;
+        float ax = (float)a;
+        float ay = v[a];
+        float max_area = -1.0f;
+        uint32_t next_a = range_start;
+        for (uint32_t j = range_start; j < range_end; j++) {
+            float area = (ax - avg_x) * (v[j] - ay) - (ax - (float)j) * (avg_y - ay);
+            if (area < 0.0f) area = -area;
+            if (area > max_area) {
+                max_area = area;
+                next_a = j;
+            }
+        }
+
+        series_emit_vertex(series, next_a, x_scale, y_scale, height);
+        a = next_a;
+    }
+
+    series_emit_vertex(series, count - 1, x_scale, y_scale, height);
+}
+
+// Vertices for a series at the given element size, about one per pixel of width.
+static uint32_t series_vertices(ChartSeries* series, float width, float height) {
+    if (series->cached_revision != series->revision ||
+        series->cached_width != width || series->cached_height != height) {
+        uint32_t threshold = width > 2.0f ? (uint32_t)width : 2u;
+        if (threshold > TXXT_SERIES_MAX_VERTICES) {
+            threshold = TXXT_SERIES_MAX_VERTICES;
+        }
+        series_downsample_lttb(series, threshold, width, height);
+        series->cached_revision = series->revision;
+        series->cached_width = width;
+        series->cached_height = height;
+    }
+    return series->vertex_count;
+}
+
+// Pack `cmds` into the stream at `base`, which the renderer addresses as
+// `address`. Text normally points into this module's memory; with
+// `inline_text` the strings are copied in after the vertices and pointed at
+// there, so the stream stands alone (prerender.c ships it to another
+// process). Returns the stream length in bytes.
+static uint32_t PackRenderCommandStream(uint8_t* base, uint32_t address, Clay_RenderCommandArray cmds, bool inline_text) {
     uint32_t len = (uint32_t)cmds.length;
 
     // Header
     // u32 length
     // u32 command_size
     // u32 commands_ptr
+    // u32 vertex_bytes (series vertex region, follows the commands)
+    // u32 layers_offset (layer table, follows the vertices and any inline
+    //     text; from buffer start)
+    // u32 layer_count (0 = no table this frame, draw everything)
+    // u32 stream_bytes (everything above, from buffer start)
     // u32 reserved
     write_u32(base + 0, len);
     write_u32(base + 4, TXXT_PACKED_CMD_SIZE);
-    write_u32(base + 8, scratch_address + TXXT_PACKED_HDR_SIZE);
-    write_u32(base + 12, 0);
+    write_u32(base + 8, address + TXXT_PACKED_HDR_SIZE);
+
+    uint32_t vertex_start = TXXT_PACKED_HDR_SIZE + (len * TXXT_PACKED_CMD_SIZE);
+    uint32_t vertex_cursor = vertex_start;
 
     uint8_t* out = base + TXXT_PACKED_HDR_SIZE;
     for (uint32_t i = 0; i < len; i++) {
@@ -1325,7 +6082,29 @@ static void PackRenderCommands(uint32_t scratch_address, Clay_RenderCommandArray
                 write_f32(c + 44, cu->cornerRadius.bottomRight);
                 write_f32(c + 48, cu->cornerRadius.bottomLeft);
 
-                write_u32(c + 52, (uint32_t)(uintptr_t)cu->customData);
+                // Series: [52..56] line color (RGBA u8), [56..60] vertex offset
+                // from buffer start (u32), [60..62] vertex count (u16), [62] kind.
+                // Vertices are f32 x,y pairs relative to the bounding box.
+                // Anything else keeps the customData pointer at [52..56].
+                ChartSeries* series = custom_chart_series(cu);
+                if (!series) {
+                    write_u32(c + 52, (uint32_t)(uintptr_t)cu->customData);
+                    break;
+                }
+                c[52] = (uint8_t)series->color.r;
+                c[53] = (uint8_t)series->color.g;
+                c[54] = (uint8_t)series->color.b;
+                c[55] = (uint8_t)series->color.a;
+                uint32_t n = series_vertices(series, cmd->boundingBox.width, cmd->boundingBox.height);
+                if (vertex_cursor + n * 8u <= TXXT_CMD_BUFFER_BYTES) {
+                    write_u32(c + 56, vertex_cursor);
+                    write_u16(c + 60, (uint16_t)n);
+                    c[62] = (uint8_t)series->header.kind;
+                    for (uint32_t v = 0; v < n * 2u; v++) {
+                        write_f32(base + vertex_cursor + v * 4u, series->vertices[v]);
+                    }
+                    vertex_cursor += n * 8u;
+                }
                 break;
             }
 
@@ -1336,10 +6115,267 @@ static void PackRenderCommands(uint32_t scratch_address, Clay_RenderCommandArray
                 break;
         }
     }
+
+    write_u32(base + 12, vertex_cursor - vertex_start);
+
+    uint32_t cursor = vertex_cursor;
+    if (inline_text) {
+        for (uint32_t i = 0; i < len; i++) {
+            Clay_RenderCommand* cmd = &cmds.internalArray[i];
+            if (cmd->commandType != CLAY_RENDER_COMMAND_TYPE_TEXT) {
+                continue;
+            }
+            uint8_t* c = out + (i * TXXT_PACKED_CMD_SIZE);
+            uint32_t n = (uint32_t)cmd->renderData.text.stringContents.length;
+            if (cursor + n > TXXT_CMD_BUFFER_BYTES) {
+                n = 0; // out of room: draw nothing rather than stray memory
+            }
+            for (uint32_t j = 0; j < n; j++) {
+                base[cursor + j] = (uint8_t)cmd->renderData.text.stringContents.chars[j];
+            }
+            write_u32(c + 20, address + cursor);
+            write_u32(c + 24, n);
+            cursor += n;
+        }
+        cursor = (cursor + 3u) & ~3u;
+    }
+
+    uint32_t layer_count = PackRetainedLayers(base, cursor, cmds);
+    write_u32(base + 16, cursor);
+    write_u32(base + 20, layer_count);
+    cursor += layer_count * TXXT_PACKED_LAYER_SIZE;
+    write_u32(base + 24, cursor);
+    write_u32(base + 28, 0);
+    return cursor;
 }
 
-CLAY_WASM_EXPORT("UpdateDrawFrame") void UpdateDrawFrame(
-    uint32_t cmd_buffer_address,
+static void PackRenderCommands(uint32_t scratch_address, Clay_RenderCommandArray cmds) {
+    if (scratch_address == 0) {
+        return;
+    }
+    PackRenderCommandStream((uint8_t*)(uintptr_t)scratch_address, scratch_address, cmds, false);
+}
+
+// ── Heat overlay ──────────────────────────────────────────────
+// Toggled with F6 (Shift+F6 picks the metric). Tints every element by its
+// own share of one metric from Clay's per-element cost table, and lists the
+// named components (CLAY_ID elements) that cost the most, each charged with
+// everything below it up to the next named component.
+
+#define TXXT_HEAT_SIZING_TIME 0u
+#define TXXT_HEAT_RENDER_COMMANDS 1u
+#define TXXT_HEAT_MEASURE_MISSES 2u
+#define TXXT_HEAT_WRAPPED_LINES 3u
+#define TXXT_HEAT_METRIC_COUNT 4u
+
+#define TXXT_HEAT_MAX_ROWS 16384u
+#define TXXT_HEAT_LABELS 6u
+#define TXXT_HEAT_LABEL_CHARS 96
+#define TXXT_HEAT_PANEL_WIDTH 360.0f
+#define TXXT_HEAT_LINE_HEIGHT 20.0f
+
+static const char* HEAT_METRIC_NAMES[TXXT_HEAT_METRIC_COUNT] = {
+    "sizing time", "render commands", "measure misses", "wrapped lines"
+};
+
+static bool heat_overlay_enabled = false;
+static uint32_t heat_metric = TXXT_HEAT_SIZING_TIME;
+static float heat_component_cost[TXXT_HEAT_MAX_ROWS];
+
+static float heat_value(const Clay_ElementCost* cost) {
+    switch (heat_metric) {
+        case TXXT_HEAT_RENDER_COMMANDS: return (float)cost->renderCommandCount;
+        case TXXT_HEAT_MEASURE_MISSES: return (float)cost->measureCacheMisses;
+        case TXXT_HEAT_WRAPPED_LINES: return (float)cost->wrappedLineCount;
+        case TXXT_HEAT_SIZING_TIME:
+        default: return cost->sizingMs;
+    }
+}
+
+// Label text built in place in the frame arena; nothing else may allocate
+// from the arena until heat_label_end.
+typedef struct {
+    char* chars;
+    int32_t length;
+} HeatLabel;
+
+static HeatLabel heat_label_begin(void) {
+    return (HeatLabel){ (char*)((uint8_t*)frame_arena.memory + frame_arena.offset), 0 };
+}
+
+static void heat_label_append(HeatLabel* label, const char* chars, int32_t length) {
+    for (int32_t i = 0; i < length && label->length < TXXT_HEAT_LABEL_CHARS; i++) {
+        label->chars[label->length++] = chars[i];
+    }
+}
+
+static void heat_label_u32(HeatLabel* label, uint32_t value) {
+    char digits[10];
+    int32_t n = 0;
+    do {
+        digits[n++] = (char)('0' + (value % 10u));
+        value /= 10u;
+    } while (value != 0 && n < (int32_t)sizeof(digits));
+    while (n > 0) {
+        heat_label_append(label, &digits[--n], 1);
+    }
+}
+
+static void heat_label_metric(HeatLabel* label, float value) {
+    if (heat_metric == TXXT_HEAT_SIZING_TIME) {
+        uint32_t hundredths = (uint32_t)(value * 100.0f + 0.5f);
+        heat_label_u32(label, hundredths / 100u);
+        heat_label_append(label, ".", 1);
+        char fraction[2] = { (char)('0' + (hundredths / 10u) % 10u), (char)('0' + hundredths % 10u) };
+        heat_label_append(label, fraction, 2);
+        heat_label_append(label, " ms", 3);
+    } else {
+        heat_label_u32(label, (uint32_t)value);
+    }
+}
+
+static Clay_StringSlice heat_label_end(HeatLabel* label) {
+    frame_arena.offset += ((uint32_t)label->length + 3u) & ~3u;
+    return (Clay_StringSlice){ .length = label->length, .chars = label->chars, .baseChars = label->chars };
+}
+
+static void heat_add_command(Clay_RenderCommandArray* cmds, Clay_RenderCommand cmd) {
+    if (cmds->length < cmds->capacity) {
+        cmds->internalArray[cmds->length++] = cmd;
+    }
+}
+
+static void heat_add_text(Clay_RenderCommandArray* cmds, Clay_BoundingBox box, Clay_StringSlice text, Clay_Color color) {
+    heat_add_command(cmds, (Clay_RenderCommand){
+        .boundingBox = box,
+        .renderData = { .text = {
+            .stringContents = text,
+            .textColor = color,
+            .fontId = FONT_ID_BODY_16,
+            .fontSize = 14,
+            .lineHeight = (uint16_t)TXXT_HEAT_LINE_HEIGHT,
+        } },
+        .zIndex = INT16_MAX,
+        .commandType = CLAY_RENDER_COMMAND_TYPE_TEXT,
+    });
+}
+
+// Append the overlay for the frame just laid out (profiled) to its commands.
+static void AppendHeatOverlay(Clay_RenderCommandArray* cmds) {
+    Clay_ElementCostArray costs = Clay_GetElementCosts();
+    if (costs.length == 0) {
+        return;
+    }
+
+    float max_value = 0.0f;
+    for (int32_t i = 0; i < costs.length; i++) {
+        float value = heat_value(&costs.internalArray[i]);
+        if (value > max_value) {
+            max_value = value;
+        }
+    }
+
+    // Tint: yellow for cheap, red for the most expensive element this frame.
+    for (int32_t i = 0; i < costs.length && max_value > 0.0f; i++) {
+        Clay_ElementCost* cost = &costs.internalArray[i];
+        Clay_BoundingBox box = cost->boundingBox;
+        float value = heat_value(cost);
+        if (value <= 0.0f || box.width <= 0.0f || box.height <= 0.0f
+            || box.x > window_width || box.y > window_height
+            || box.x + box.width < 0.0f || box.y + box.height < 0.0f) {
+            continue;
+        }
+        float t = value / max_value;
+        heat_add_command(cmds, (Clay_RenderCommand){
+            .boundingBox = box,
+            .renderData = { .rectangle = {
+                .backgroundColor = { 255.0f, 210.0f - 180.0f * t, 40.0f - 10.0f * t, 30.0f + 130.0f * t },
+            } },
+            .zIndex = INT16_MAX,
+            .commandType = CLAY_RENDER_COMMAND_TYPE_RECTANGLE,
+        });
+    }
+
+    // Charge every row to its nearest named ancestor-or-self.
+    int32_t rows = costs.length < (int32_t)TXXT_HEAT_MAX_ROWS ? costs.length : (int32_t)TXXT_HEAT_MAX_ROWS;
+    for (int32_t i = 0; i < rows; i++) {
+        heat_component_cost[i] = 0.0f;
+    }
+    for (int32_t i = 0; i < rows; i++) {
+        int32_t owner = i;
+        while (owner > 0 && costs.internalArray[owner].elementId.stringId.length == 0) {
+            owner = costs.internalArray[owner].parentIndex;
+        }
+        if (owner > 0) {
+            heat_component_cost[owner] += heat_value(&costs.internalArray[i]);
+        }
+    }
+
+    int32_t top[TXXT_HEAT_LABELS];
+    uint32_t top_count = 0;
+    for (int32_t i = 1; i < rows; i++) {
+        if (heat_component_cost[i] <= 0.0f) {
+            continue;
+        }
+        uint32_t slot = top_count < TXXT_HEAT_LABELS ? top_count++ : TXXT_HEAT_LABELS;
+        while (slot > 0 && heat_component_cost[top[slot - 1]] < heat_component_cost[i]) {
+            if (slot < TXXT_HEAT_LABELS) {
+                top[slot] = top[slot - 1];
+            }
+            slot--;
+        }
+        if (slot < TXXT_HEAT_LABELS) {
+            top[slot] = i;
+        }
+    }
+
+    Clay_BoundingBox panel = {
+        window_width - TXXT_HEAT_PANEL_WIDTH - 12.0f, 12.0f,
+        TXXT_HEAT_PANEL_WIDTH, 16.0f + TXXT_HEAT_LINE_HEIGHT * (float)(top_count + 1u)
+    };
+    heat_add_command(cmds, (Clay_RenderCommand){
+        .boundingBox = panel,
+        .renderData = { .rectangle = {
+            .backgroundColor = { 20.0f, 20.0f, 28.0f, 220.0f },
+            .cornerRadius = { 6.0f, 6.0f, 6.0f, 6.0f },
+        } },
+        .zIndex = INT16_MAX,
+        .commandType = CLAY_RENDER_COMMAND_TYPE_RECTANGLE,
+    });
+
+    Clay_BoundingBox line = { panel.x + 10.0f, panel.y + 8.0f, panel.width - 20.0f, TXXT_HEAT_LINE_HEIGHT };
+    HeatLabel title = heat_label_begin();
+    heat_label_append(&title, "Heat: ", 6);
+    const char* metric_name = HEAT_METRIC_NAMES[heat_metric];
+    heat_label_append(&title, metric_name, (int32_t)str_len(metric_name));
+    heat_label_append(&title, " (Shift+F6: next)", 17);
+    heat_add_text(cmds, line, heat_label_end(&title), (Clay_Color){ 255, 210, 40, 255 });
+
+    for (uint32_t k = 0; k < top_count; k++) {
+        Clay_ElementCost* cost = &costs.internalArray[top[k]];
+        line.y += TXXT_HEAT_LINE_HEIGHT;
+        HeatLabel label = heat_label_begin();
+        heat_label_metric(&label, heat_component_cost[top[k]]);
+        heat_label_append(&label, "  ", 2);
+        heat_label_append(&label, cost->elementId.stringId.chars,
+                          cost->elementId.stringId.length < 40 ? cost->elementId.stringId.length : 40);
+        if (cost->elementId.offset != 0) {
+            heat_label_append(&label, "#", 1);
+            heat_label_u32(&label, cost->elementId.offset);
+        }
+        heat_label_append(&label, "  (", 3);
+        heat_label_u32(&label, (uint32_t)cost->descendantCount);
+        heat_label_append(&label, " below)", 7);
+        heat_add_text(cmds, line, heat_label_end(&label), (Clay_Color){ 235, 235, 240, 255 });
+    }
+}
+
+// Render commands of the last frame laid out, for CaptureLastFrame.
+static Clay_RenderCommandArray last_frame_commands;
+
+// Advance one frame and lay it out. Shared by every host renderer: the canvas
+// host gets the result packed (UpdateDrawFrame), terminal.c rasterizes it.
+static Clay_RenderCommandArray LayoutFrame(
     float width, float height,
     float mouse_wheel_x, float mouse_wheel_y,
     float mouse_x, float mouse_y,
@@ -1350,6 +6386,7 @@ CLAY_WASM_EXPORT("UpdateDrawFrame") void UpdateDrawFrame(
     window_width = width;
     window_height = height;
     app_time_seconds += delta_time;
+    series_sample();
 
     if (data_pulse_remaining > 0.0f) {
         data_pulse_remaining -= delta_time;
@@ -1362,9 +6399,61 @@ CLAY_WASM_EXPORT("UpdateDrawFrame") void UpdateDrawFrame(
     Clay_SetPointerState((Clay_Vector2){mouse_x, mouse_y}, mouse_down || touch_down);
     Clay_UpdateScrollContainers(touch_down, (Clay_Vector2){mouse_wheel_x, mouse_wheel_y}, delta_time);
 
+    Clay_SetElementCostProfilingEnabled(heat_overlay_enabled);
     Clay_RenderCommandArray cmds = CreateLayout();
     UpdateLoginRects();
+    if (heat_overlay_enabled) {
+        AppendHeatOverlay(&cmds);
+    }
+    last_frame_commands = cmds;
+    return cmds;
+}
+
+CLAY_WASM_EXPORT("UpdateDrawFrame") void UpdateDrawFrame(
+    uint32_t cmd_buffer_address,
+    float width, float height,
+    float mouse_wheel_x, float mouse_wheel_y,
+    float mouse_x, float mouse_y,
+    bool touch_down, bool mouse_down,
+    float delta_time
+) {
+    Clay_RenderCommandArray cmds = LayoutFrame(width, height, mouse_wheel_x, mouse_wheel_y,
+                                               mouse_x, mouse_y, touch_down, mouse_down, delta_time);
     PackRenderCommands(cmd_buffer_address, cmds);
+    export_step(TXXT_EXPORT_FRAME_BUDGET_MS);
+}
+
+// Re-pack the last frame as a self-contained stream (text inline, addressed
+// from 0) for a renderer replay capture (dist/replay.html). Overwrites the
+// live stream, so call it once the frame has been drawn. Returns its length.
+CLAY_WASM_EXPORT("CaptureLastFrame") uint32_t CaptureLastFrame(uint32_t cmd_buffer_address) {
+    if (cmd_buffer_address == 0) {
+        return 0;
+    }
+    return PackRenderCommandStream((uint8_t*)(uintptr_t)cmd_buffer_address, 0, last_frame_commands, true);
+}
+
+CLAY_WASM_EXPORT("SetHeatOverlay") void SetHeatOverlay(bool enabled, uint32_t metric) {
+    heat_overlay_enabled = enabled;
+    heat_metric = metric < TXXT_HEAT_METRIC_COUNT ? metric : TXXT_HEAT_SIZING_TIME;
+}
+
+CLAY_WASM_EXPORT("IsHeatOverlayEnabled") bool IsHeatOverlayEnabled(void) {
+    return heat_overlay_enabled;
+}
+
+CLAY_WASM_EXPORT("GetHeatMetric") uint32_t GetHeatMetric(void) {
+    return heat_metric;
+}
+
+// The last frame's per-element cost table (Clay_ElementCost rows, see
+// clay.h), empty unless the heat overlay is on. For txxtElementCosts().
+CLAY_WASM_EXPORT("GetElementCostTable") uint32_t GetElementCostTable(void) {
+    return (uint32_t)(uintptr_t)Clay_GetElementCosts().internalArray;
+}
+
+CLAY_WASM_EXPORT("GetElementCostCount") uint32_t GetElementCostCount(void) {
+    return (uint32_t)Clay_GetElementCosts().length;
 }
 
 // JS interop functions
@@ -1387,26 +6476,41 @@ CLAY_WASM_EXPORT("AddTask") void AddTask(
         task->id[0] = 0;
         task->status = (TaskStatus)status;
         task->priority = (Priority)priority;
+        task->service_handle = 0;
+        task->assignee_handle = 0;
+        task->due_day = TXXT_DUE_NONE;
+        task->scheduled_day = TXXT_DUE_NONE;
+        task->detail_slot = -1;
+        aggregates_apply(task, 1);
         app_state.task_count++;
     }
 }
 
 CLAY_WASM_EXPORT("ClearTasks") void ClearTasks(void) {
     app_state.task_count = 0;
+    task_index_rebuild();
+    aggregates_rebuild();
 }
 
 CLAY_WASM_EXPORT("GetTaskCount") uint32_t GetTaskCount(void) {
     return app_state.task_count;
 }
 
-CLAY_WASM_EXPORT("GetSelectedTaskIndex") int32_t GetSelectedTaskIndex(void) {
-    return app_state.selected_task_index;
+// Service/assignee names refused by the full intern table so far (each
+// refusal counts); those tasks count as No service / Unassigned. The host
+// reports any increase.
+CLAY_WASM_EXPORT("GetInternOverflowCount") uint32_t GetInternOverflowCount(void) {
+    return intern_table.overflowed;
 }
 
-CLAY_WASM_EXPORT("GetShowCreateModal") bool GetShowCreateModal(void) {
-    bool result = app_state.show_create_modal;
-    app_state.show_create_modal = false;
-    return result;
+// Services as loaded (Service records: 37-byte id, 64-byte name), so the
+// host can read the id behind GetEditServiceIndex.
+CLAY_WASM_EXPORT("GetServiceTable") uint32_t GetServiceTable(void) {
+    return (uint32_t)(uintptr_t)app_state.services;
+}
+
+CLAY_WASM_EXPORT("GetSelectedTaskIndex") int32_t GetSelectedTaskIndex(void) {
+    return app_state.selected_task_index;
 }
 
 CLAY_WASM_EXPORT("GetPendingCreateServiceIndex") int32_t GetPendingCreateServiceIndex(void) {
@@ -1416,24 +6520,153 @@ CLAY_WASM_EXPORT("GetPendingCreateServiceIndex") int32_t GetPendingCreateService
 }
 
 CLAY_WASM_EXPORT("SetCreatePanelVisible") void SetCreatePanelVisible(bool visible) {
+    if (visible && !app_state.create_panel_visible) {
+        edit_form_open(app_state.pending_create_service_index);
+    }
     app_state.create_panel_visible = visible;
     if (!visible) {
         app_state.pending_create_service_index = -1;
+        edit_form.focus = -1;
+    }
+}
+
+// Text editing. The host forwards keyboard/IME input from a hidden input
+// element; all layout, caret and selection work happens here.
+CLAY_WASM_EXPORT("GetEditInputBuffer") uint32_t GetEditInputBuffer(void) {
+    return (uint32_t)(uintptr_t)edit_input_buffer;
+}
+
+CLAY_WASM_EXPORT("GetEditFocus") int32_t GetEditFocus(void) {
+    return app_state.create_panel_visible ? edit_form.focus : -1;
+}
+
+CLAY_WASM_EXPORT("EditInsertText") void EditInsertText(uint32_t length) {
+    if (edit_form.focus < 0) {
+        return;
+    }
+    if (length > TXXT_EDIT_INPUT_MAX) {
+        length = TXXT_EDIT_INPUT_MAX;
+    }
+    edit_insert(&edit_form.fields[edit_form.focus], edit_input_buffer, length);
+}
+
+CLAY_WASM_EXPORT("EditKey") void EditKey(uint32_t key, uint32_t modifiers) {
+    edit_form_key(key, modifiers);
+}
+
+// Copy the focused field's selection into the edit input buffer.
+CLAY_WASM_EXPORT("CopyEditSelection") uint32_t CopyEditSelection(void) {
+    if (edit_form.focus < 0) {
+        return 0;
+    }
+    EditField* field = &edit_form.fields[edit_form.focus];
+    uint32_t caret = field->gap_start;
+    uint32_t lo = field->anchor < caret ? field->anchor : caret;
+    uint32_t hi = field->anchor < caret ? caret : field->anchor;
+    for (uint32_t i = lo; i < hi; i++) {
+        edit_input_buffer[i - lo] = (uint8_t)edit_byte_at(field, i);
+    }
+    return hi - lo;
+}
+
+CLAY_WASM_EXPORT("GetEditFieldText") uint32_t GetEditFieldText(uint32_t index) {
+    if (index >= TXXT_EDIT_FIELD_COUNT) {
+        return 0;
     }
+    EditField* field = &edit_form.fields[index];
+    edit_field_sync(field, field->synced_width, 0.0f);
+    return (uint32_t)(uintptr_t)field->text;
+}
+
+CLAY_WASM_EXPORT("GetEditStatus") uint32_t GetEditStatus(void) {
+    return (uint32_t)edit_form.status;
+}
+
+CLAY_WASM_EXPORT("GetEditPriority") uint32_t GetEditPriority(void) {
+    return (uint32_t)edit_form.priority;
+}
+
+// Service index (into GetServiceTable) the validated form names, or -1.
+CLAY_WASM_EXPORT("GetEditServiceIndex") int32_t GetEditServiceIndex(void) {
+    return edit_form.service_index;
+}
+
+// Returns true once per validated submit (Create button or Enter).
+CLAY_WASM_EXPORT("TakeEditSubmit") bool TakeEditSubmit(void) {
+    bool result = edit_form.submit_pending;
+    edit_form.submit_pending = false;
+    return result;
 }
 
 CLAY_WASM_EXPORT("InitApp") void InitApp(void) {
     app_state.logged_in = false;
     app_state.task_count = 0;
+    task_index_rebuild();
     app_state.service_count = 0;
+    service_index_rebuild();
     app_state.selected_task_index = -1;
     app_state.selected_service_index = -1;
     app_state.pending_create_service_index = -1;
     app_state.filter_status = FILTER_ALL;
-    app_state.show_create_modal = false;
     app_state.create_panel_visible = false;
     app_state.show_detail_panel = false;
+    app_state.show_dashboard = false;
     app_state.current_user[0] = '\0';
+    for (uint32_t i = 0; i < TXXT_MAX_SERIES; i++) {
+        chart_series[i].header = (CustomHeader){ TXXT_CUSTOM_MAGIC, CUSTOM_KIND_SERIES_LINE };
+        chart_series[i].color = COLOR_PRIMARY;
+    }
+    chart_series[TXXT_SERIES_THROUGHPUT].header.kind = CUSTOM_KIND_SERIES_AREA;
+    chart_series[TXXT_SERIES_THROUGHPUT].color = COLOR_PRIMARY;
+    chart_series[TXXT_SERIES_BURNDOWN].header.kind = CUSTOM_KIND_SERIES_LINE;
+    chart_series[TXXT_SERIES_BURNDOWN].color = COLOR_PRIORITY_HIGH;
+    aggregates_rebuild();
+}
+
+static void zero_bytes(void* dst, uint32_t size) {
+    uint8_t* bytes = (uint8_t*)dst;
+    for (uint32_t i = 0; i < size; i++) {
+        bytes[i] = 0;
+    }
+}
+
+// Every store back to its load-time state, then InitApp: for a native host
+// that lays out frames for one client after another (prerender.c), so nothing
+// the previous client loaded (interned names, detail tiers, series,
+// dependencies, recurrences, cycle stats, edits) leaks into the next frame.
+// Clay's own state is the host's to reinitialize.
+CLAY_WASM_EXPORT("ResetApp") void ResetApp(void) {
+    zero_bytes(&app_state, sizeof(app_state));
+    zero_bytes(&intern_table, sizeof(intern_table));
+    intern_table.count = 1;
+    zero_bytes(&aggregates, sizeof(aggregates));
+    zero_bytes(&detail_cache, sizeof(detail_cache));
+    zero_bytes(chart_series, sizeof(chart_series));
+    zero_bytes(&series_sampler, sizeof(series_sampler));
+    zero_bytes(&cycle_stats, sizeof(cycle_stats));
+    cycle_stats.rng = 0x9E3779B9u;
+    zero_bytes(&dep_graph, sizeof(dep_graph));
+    dep_view_enabled = false;
+    zero_bytes(&recur_store, sizeof(recur_store));
+    recur_store.revision = 1;
+    schedule_visible = false;
+    schedule_first_day = TXXT_DUE_NONE;
+    zero_bytes(&import_state, sizeof(import_state));
+    zero_bytes(&export_state, sizeof(export_state));
+    zero_bytes(service_by_handle, sizeof(service_by_handle));
+    zero_bytes(service_wire_ids, sizeof(service_wire_ids));
+    zero_bytes(&edit_form, sizeof(edit_form));
+    edit_form.focus = -1;
+    edit_form.last_click_field = -1;
+    zero_bytes(login_rects, sizeof(login_rects));
+    heat_overlay_enabled = false;
+    heat_metric = TXXT_HEAT_SIZING_TIME;
+    zero_bytes(heat_component_cost, sizeof(heat_component_cost));
+    data_pulse_remaining = 0.0f;
+    app_time_seconds = 0.0;
+    last_service_click_index = -1;
+    last_service_click_time = 0.0;
+    InitApp();
 }
 
 CLAY_WASM_EXPORT("GetLoginRect") Rect* GetLoginRect(uint32_t which) {
@@ -1443,7 +6676,9 @@ CLAY_WASM_EXPORT("GetLoginRect") Rect* GetLoginRect(uint32_t which) {
     return &login_rects[which];
 }
 
+#ifdef CLAY_WASM
 // Dummy main for WASM
 int main(void) {
     return 0;
 }
+#endif
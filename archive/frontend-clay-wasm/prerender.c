@@ -0,0 +1,73 @@
+// Native prerender library (see prerender.h). Includes the UI translation
+// unit directly, as terminal.c does, and measures text from the client's
+// reported font metrics instead of a canvas.
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "prerender.h"
+#include "main.c"
+
+static TxxtFontMetrics prerender_fonts[TXXT_PRERENDER_FONT_MAX];
+static uint32_t prerender_font_count;
+static Clay_Arena prerender_arena;
+
+static Clay_Dimensions prerender_measure(Clay_StringSlice text, Clay_TextElementConfig* config, void* user_data) {
+    (void)user_data;
+    if (config->fontId >= prerender_font_count) {
+        return (Clay_Dimensions){ 0.0f, (float)config->fontSize };
+    }
+    const TxxtFontMetrics* font = &prerender_fonts[config->fontId];
+    float scale = font->size > 0.0f ? (float)config->fontSize / font->size : 1.0f;
+    float width = 0.0f;
+    for (int32_t i = 0; i < text.length; i++) {
+        uint8_t b = (uint8_t)text.chars[i];
+        if ((b & 0xc0) == 0x80) {
+            continue; // UTF-8 continuation: counted with its lead byte
+        }
+        uint32_t glyph = (uint32_t)b - TXXT_PRERENDER_GLYPH_FIRST;
+        width += glyph < TXXT_PRERENDER_GLYPH_COUNT ? font->advances[glyph] : font->fallback_advance;
+    }
+    return (Clay_Dimensions){ width * scale, font->line_height * scale };
+}
+
+bool txxt_prerender_init(void) {
+    uint32_t memory_size = Clay_MinMemorySize();
+    void* memory = malloc(memory_size);
+    void* scratch = calloc(1, TXXT_CMD_BUFFER_BYTES);
+    if (!memory || !scratch) {
+        free(memory);
+        free(scratch);
+        return false;
+    }
+    prerender_arena = Clay_CreateArenaWithCapacityAndMemory(memory_size, memory);
+    SetScratchMemory(scratch);
+    return true;
+}
+
+uint32_t txxt_prerender(const TxxtPrerenderRequest* request, uint8_t* out, uint32_t capacity) {
+    if (capacity < TXXT_PRERENDER_OUTPUT_BYTES) {
+        return 0;
+    }
+
+    prerender_font_count = request->font_count < TXXT_PRERENDER_FONT_MAX ? request->font_count : TXXT_PRERENDER_FONT_MAX;
+    memcpy(prerender_fonts, request->fonts, prerender_font_count * sizeof(TxxtFontMetrics));
+
+    // Every client starts from the same fresh state: a new Clay context over
+    // the same arena (no scroll offsets, element ids or text measurements
+    // from the previous client's fonts) and every app store reset.
+    Clay_Initialize(prerender_arena, (Clay_Dimensions){ request->width, request->height },
+                    (Clay_ErrorHandler){ Clay__ErrorHandlerFunctionDefault, 0 });
+    Clay_SetMeasureTextFunction(prerender_measure, 0);
+    ResetApp();
+    SetLoggedIn(true);
+    SetToday(request->today);
+    if (request->snapshot_length > 0 && !apply_compact_snapshot(request->snapshot, request->snapshot_length)) {
+        return 0;
+    }
+
+    // Pointer parked off-screen so nothing renders hovered.
+    Clay_RenderCommandArray cmds = LayoutFrame(request->width, request->height, 0.0f, 0.0f,
+                                               -1.0f, -1.0f, false, false, 0.0f);
+    return PackRenderCommandStream(out, 0, cmds, true);
+}
@@ -0,0 +1,70 @@
+// Native prerender library: lays out the first frame of the txxt UI (main.c)
+// for a client that has not instantiated its WASM yet, so a host process can
+// ship a paintable frame together with the snapshot.
+//
+// Build with ./build-prerender.sh (libtxxt_prerender.a / .so). All calls share
+// one UI instance: a host serving several clients must serialize them.
+//
+// The txxt backend does not serve prerendered frames. A host that does
+// names its endpoint in the page, <meta name="txxt-prerender" content="URL">,
+// and the canvas client (dist/index.html) then asks it for the first frame:
+//
+//   POST URL?width=<css px>&height=<css px>
+//   body: u32 font_count, then font_count TxxtFontMetrics (little-endian)
+//   200:  u32 snapshot_length, the compact snapshot frame (the game socket's
+//         `?snapshot=compact` encoding), then the packed render command
+//         stream txxt_prerender() wrote
+//
+// Without the meta tag, or on any other response, the client starts cold.
+
+#ifndef TXXT_PRERENDER_H
+#define TXXT_PRERENDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TXXT_PRERENDER_API __attribute__((visibility("default")))
+
+// Fonts main.c uses (FONT_ID_*); the client reports one table per id.
+#define TXXT_PRERENDER_FONT_MAX 4u
+// First and count of the glyphs with their own advance (printable ASCII).
+#define TXXT_PRERENDER_GLYPH_FIRST 32u
+#define TXXT_PRERENDER_GLYPH_COUNT 95u
+// Size of the output buffer txxt_prerender() needs (TXXT_CMD_BUFFER_BYTES).
+#define TXXT_PRERENDER_OUTPUT_BYTES (1024u * 1024u)
+
+// Text metrics the client measured for one font id at `size` px. Widths at
+// other sizes scale linearly; codepoints outside printable ASCII use
+// `fallback_advance`.
+typedef struct {
+    float size;
+    float line_height;
+    float fallback_advance;
+    float advances[TXXT_PRERENDER_GLYPH_COUNT];
+} TxxtFontMetrics;
+
+typedef struct {
+    // Compact snapshot frame to hydrate from (may be empty).
+    const uint8_t* snapshot;
+    uint32_t snapshot_length;
+    // Client viewport in CSS pixels.
+    float width;
+    float height;
+    const TxxtFontMetrics* fonts;
+    uint32_t font_count;
+    // Days since the Unix epoch, for the overdue counters.
+    uint32_t today;
+} TxxtPrerenderRequest;
+
+// Set up the UI instance. Call once before txxt_prerender(); false if out of
+// memory.
+TXXT_PRERENDER_API bool txxt_prerender_init(void);
+
+// Lay out the first frame `request` describes and write it to `out` as a
+// self-contained packed render command stream (the layout PackRenderCommands
+// documents in main.c, addressed from 0, with the text inline). Returns the
+// stream length, or 0 if the snapshot is malformed or `capacity` is below
+// TXXT_PRERENDER_OUTPUT_BYTES.
+TXXT_PRERENDER_API uint32_t txxt_prerender(const TxxtPrerenderRequest* request, uint8_t* out, uint32_t capacity);
+
+#endif
@@ -0,0 +1,875 @@
+// txxt terminal client: the same UI as the canvas build (main.c), rendered
+// into a character cell grid and drawn with ANSI escape sequences.
+//
+// Layout runs in virtual pixels, TXXT_CELL_W x TXXT_CELL_H per cell, so the
+// pixel-sized UI keeps its proportions; text measures one cell per codepoint
+// whatever the font. Each frame rasterizes the render commands into a back
+// grid and writes only the cells that differ from the front grid.
+//
+// Data comes from the game socket (compact snapshot, then event frames) over
+// a plain WebSocket, so point it at a local backend or an SSH tunnel:
+//
+//     ./build-terminal.sh && ./txxt-term [host[:port]]
+//
+// Keyboard and mouse come from the TTY (SGR mouse reporting). The client is
+// read-only: task edits are not sent back yet. q or Ctrl-C quits.
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "main.c"
+
+#define TXXT_CELL_W 8.0f
+#define TXXT_CELL_H 16.0f
+#define TXXT_TERM_SCISSOR_MAX 16u
+#define TXXT_TERM_DEFAULT_HOST "127.0.0.1"
+#define TXXT_TERM_DEFAULT_PORT "3000"
+#define TXXT_TERM_RETRY_SECONDS 3.0
+#define TXXT_TERM_CONNECT_SECONDS 5.0
+#define TXXT_TERM_FRAME_MS 33
+// Largest WebSocket message accepted (a snapshot); bigger frames are dropped.
+#define TXXT_WS_MESSAGE_MAX (64u * 1024u * 1024u)
+
+// ── Cell grid ──────────────────────────────────────────────────
+
+typedef struct {
+    uint32_t codepoint;
+    uint8_t fg[3];
+    uint8_t bg[3];
+} Cell;
+
+typedef struct {
+    int32_t x0, y0, x1, y1; // cells, [x0, x1) x [y0, y1)
+} CellRect;
+
+static Cell* front_cells;
+static Cell* back_cells;
+static int32_t grid_cols;
+static int32_t grid_rows;
+static CellRect scissor_stack[TXXT_TERM_SCISSOR_MAX];
+static uint32_t scissor_depth;
+
+static char* out_buffer;
+static size_t out_length;
+static size_t out_capacity;
+
+static int tty_fd = -1;
+static struct termios tty_saved;
+// Set by SIGTERM/SIGHUP/SIGINT; the frame loop exits and atexit restores the tty.
+static volatile sig_atomic_t tty_quit_signal;
+static char status_line[128];
+
+static void out_bytes(const char* bytes, size_t n) {
+    if (out_length + n > out_capacity) {
+        size_t capacity = out_capacity ? out_capacity * 2 : 65536;
+        while (capacity < out_length + n) capacity *= 2;
+        out_buffer = realloc(out_buffer, capacity);
+        out_capacity = capacity;
+    }
+    memcpy(out_buffer + out_length, bytes, n);
+    out_length += n;
+}
+
+static void out_str(const char* str) {
+    out_bytes(str, strlen(str));
+}
+
+static void out_flush(void) {
+    size_t at = 0;
+    while (at < out_length) {
+        ssize_t n = write(tty_fd, out_buffer + at, out_length - at);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            break;
+        }
+        at += (size_t)n;
+    }
+    out_length = 0;
+}
+
+static void color_bytes(uint8_t out[3], Clay_Color color) {
+    out[0] = (uint8_t)color.r;
+    out[1] = (uint8_t)color.g;
+    out[2] = (uint8_t)color.b;
+}
+
+// Blend `color` over `under` by the color's alpha (0..255).
+static void blend_into(uint8_t under[3], Clay_Color color) {
+    float a = color.a / 255.0f;
+    if (a >= 1.0f) {
+        color_bytes(under, color);
+        return;
+    }
+    under[0] = (uint8_t)(under[0] + (color.r - under[0]) * a);
+    under[1] = (uint8_t)(under[1] + (color.g - under[1]) * a);
+    under[2] = (uint8_t)(under[2] + (color.b - under[2]) * a);
+}
+
+static bool grid_resize(int32_t cols, int32_t rows) {
+    if (cols == grid_cols && rows == grid_rows && front_cells) {
+        return false;
+    }
+    free(front_cells);
+    free(back_cells);
+    grid_cols = cols;
+    grid_rows = rows;
+    front_cells = calloc((size_t)cols * (size_t)rows, sizeof(Cell));
+    back_cells = calloc((size_t)cols * (size_t)rows, sizeof(Cell));
+    // Nothing on screen matches a zero codepoint, so the first frame is full.
+    return true;
+}
+
+static CellRect clip_rect(void) {
+    CellRect clip = { 0, 0, grid_cols, grid_rows };
+    if (scissor_depth > 0) {
+        clip = scissor_stack[scissor_depth - 1];
+    }
+    return clip;
+}
+
+static CellRect intersect(CellRect a, CellRect b) {
+    CellRect r = {
+        a.x0 > b.x0 ? a.x0 : b.x0,
+        a.y0 > b.y0 ? a.y0 : b.y0,
+        a.x1 < b.x1 ? a.x1 : b.x1,
+        a.y1 < b.y1 ? a.y1 : b.y1,
+    };
+    return r;
+}
+
+static int32_t to_col(float x) {
+    return (int32_t)(x / TXXT_CELL_W + 0.5f);
+}
+
+static int32_t to_row(float y) {
+    return (int32_t)(y / TXXT_CELL_H + 0.5f);
+}
+
+static CellRect cells_of(Clay_BoundingBox box) {
+    CellRect r = { to_col(box.x), to_row(box.y), to_col(box.x + box.width), to_row(box.y + box.height) };
+    return r;
+}
+
+static Cell* cell_at(int32_t col, int32_t row) {
+    CellRect clip = clip_rect();
+    if (col < clip.x0 || col >= clip.x1 || row < clip.y0 || row >= clip.y1) {
+        return NULL;
+    }
+    return &back_cells[row * grid_cols + col];
+}
+
+static void put_glyph(int32_t col, int32_t row, uint32_t codepoint, Clay_Color color) {
+    Cell* cell = cell_at(col, row);
+    if (cell) {
+        cell->codepoint = codepoint;
+        memcpy(cell->fg, cell->bg, 3);
+        blend_into(cell->fg, color);
+    }
+}
+
+// Next codepoint of a UTF-8 run; malformed bytes decode as U+FFFD.
+static uint32_t utf8_next(const char* s, int32_t length, int32_t* at) {
+    uint8_t b = (uint8_t)s[*at];
+    int32_t extra = b < 0x80 ? 0 : b >= 0xf0 ? 3 : b >= 0xe0 ? 2 : b >= 0xc0 ? 1 : -1;
+    (*at)++;
+    if (extra < 0 || *at + extra > length) {
+        return 0xfffd;
+    }
+    uint32_t cp = extra == 0 ? b : (uint32_t)(b & (0x3f >> extra));
+    for (int32_t i = 0; i < extra; i++, (*at)++) {
+        cp = (cp << 6) | ((uint8_t)s[*at] & 0x3f);
+    }
+    return cp;
+}
+
+static int32_t utf8_count(const char* s, int32_t length) {
+    int32_t count = 0;
+    for (int32_t i = 0; i < length; i++) {
+        if (((uint8_t)s[i] & 0xc0) != 0x80) count++;
+    }
+    return count;
+}
+
+// ── Rasterizer ─────────────────────────────────────────────────
+
+static void draw_rectangle(Clay_RenderCommand* cmd) {
+    Clay_Color color = cmd->renderData.rectangle.backgroundColor;
+    CellRect r = cells_of(cmd->boundingBox);
+    if (r.y1 == r.y0 && cmd->boundingBox.height > 0.0f && r.x1 > r.x0) {
+        // Thinner than half a cell: a rule, not a fill.
+        int32_t row = (int32_t)((cmd->boundingBox.y + cmd->boundingBox.height * 0.5f) / TXXT_CELL_H);
+        for (int32_t col = r.x0; col < r.x1; col++) put_glyph(col, row, 0x2500, color); // ─
+        return;
+    }
+    if (r.x1 == r.x0 && cmd->boundingBox.width > 0.0f && r.y1 > r.y0) {
+        int32_t col = (int32_t)((cmd->boundingBox.x + cmd->boundingBox.width * 0.5f) / TXXT_CELL_W);
+        for (int32_t row = r.y0; row < r.y1; row++) put_glyph(col, row, 0x2502, color); // │
+        return;
+    }
+    r = intersect(r, clip_rect());
+    for (int32_t row = r.y0; row < r.y1; row++) {
+        for (int32_t col = r.x0; col < r.x1; col++) {
+            Cell* cell = &back_cells[row * grid_cols + col];
+            blend_into(cell->bg, color);
+            cell->codepoint = ' ';
+        }
+    }
+}
+
+static void draw_border(Clay_RenderCommand* cmd) {
+    Clay_BorderRenderData* border = &cmd->renderData.border;
+    CellRect r = cells_of(cmd->boundingBox);
+    if (r.x1 <= r.x0 || r.y1 <= r.y0) {
+        return;
+    }
+    int32_t right = r.x1 - 1;
+    int32_t bottom = r.y1 - 1;
+    if (border->width.top) for (int32_t col = r.x0; col <= right; col++) put_glyph(col, r.y0, 0x2500, border->color);
+    if (border->width.bottom) for (int32_t col = r.x0; col <= right; col++) put_glyph(col, bottom, 0x2500, border->color);
+    if (border->width.left) for (int32_t row = r.y0; row <= bottom; row++) put_glyph(r.x0, row, 0x2502, border->color);
+    if (border->width.right) for (int32_t row = r.y0; row <= bottom; row++) put_glyph(right, row, 0x2502, border->color);
+    if (r.y1 - r.y0 > 1) {
+        if (border->width.top && border->width.left) put_glyph(r.x0, r.y0, 0x250c, border->color);     // ┌
+        if (border->width.top && border->width.right) put_glyph(right, r.y0, 0x2510, border->color);   // ┐
+        if (border->width.bottom && border->width.left) put_glyph(r.x0, bottom, 0x2514, border->color);   // └
+        if (border->width.bottom && border->width.right) put_glyph(right, bottom, 0x2518, border->color); // ┘
+    }
+}
+
+static void draw_text(Clay_RenderCommand* cmd) {
+    Clay_TextRenderData* text = &cmd->renderData.text;
+    int32_t row = (int32_t)((cmd->boundingBox.y + cmd->boundingBox.height * 0.5f) / TXXT_CELL_H);
+    int32_t col = to_col(cmd->boundingBox.x);
+    for (int32_t at = 0; at < text->stringContents.length; col++) {
+        uint32_t cp = utf8_next(text->stringContents.chars, text->stringContents.length, &at);
+        put_glyph(col, row, cp < 0x20 ? ' ' : cp, text->textColor);
+    }
+}
+
+// Series charts: one dot per downsampled vertex, at cell resolution.
+static void draw_custom(Clay_RenderCommand* cmd) {
+    ChartSeries* series = custom_chart_series(&cmd->renderData.custom);
+    if (!series) {
+        return;
+    }
+    uint32_t n = series_vertices(series, cmd->boundingBox.width, cmd->boundingBox.height);
+    for (uint32_t v = 0; v < n; v++) {
+        int32_t col = (int32_t)((cmd->boundingBox.x + series->vertices[v * 2]) / TXXT_CELL_W);
+        int32_t row = (int32_t)((cmd->boundingBox.y + series->vertices[v * 2 + 1]) / TXXT_CELL_H);
+        put_glyph(col, row, 0x2022, series->color); // •
+    }
+}
+
+static void rasterize(Clay_RenderCommandArray cmds) {
+    size_t count = (size_t)grid_cols * (size_t)grid_rows;
+    for (size_t i = 0; i < count; i++) {
+        back_cells[i].codepoint = ' ';
+        color_bytes(back_cells[i].fg, COLOR_TEXT);
+        color_bytes(back_cells[i].bg, COLOR_BG);
+    }
+    scissor_depth = 0;
+
+    for (int32_t i = 0; i < cmds.length; i++) {
+        Clay_RenderCommand* cmd = &cmds.internalArray[i];
+        switch (cmd->commandType) {
+            case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: draw_rectangle(cmd); break;
+            case CLAY_RENDER_COMMAND_TYPE_BORDER: draw_border(cmd); break;
+            case CLAY_RENDER_COMMAND_TYPE_TEXT: draw_text(cmd); break;
+            case CLAY_RENDER_COMMAND_TYPE_CUSTOM: draw_custom(cmd); break;
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START:
+                if (scissor_depth < TXXT_TERM_SCISSOR_MAX) {
+                    scissor_stack[scissor_depth] = intersect(cells_of(cmd->boundingBox), clip_rect());
+                }
+                scissor_depth++;
+                break;
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END:
+                if (scissor_depth > 0) scissor_depth--;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Status overlay on the bottom row (connection state).
+    if (status_line[0] && grid_rows > 0) {
+        scissor_depth = 0;
+        Clay_Color bg = COLOR_SIDEBAR;
+        int32_t row = grid_rows - 1;
+        for (int32_t col = 0; col < grid_cols; col++) {
+            color_bytes(back_cells[row * grid_cols + col].bg, bg);
+            back_cells[row * grid_cols + col].codepoint = ' ';
+        }
+        int32_t length = (int32_t)strlen(status_line);
+        for (int32_t at = 0, col = 1; at < length; col++) {
+            put_glyph(col, row, utf8_next(status_line, length, &at), COLOR_TEXT_WHITE);
+        }
+    }
+}
+
+// ── Diff and output ────────────────────────────────────────────
+
+static void out_utf8(uint32_t cp) {
+    char b[4];
+    size_t n;
+    if (cp < 0x80) { b[0] = (char)cp; n = 1; }
+    else if (cp < 0x800) { b[0] = (char)(0xc0 | (cp >> 6)); b[1] = (char)(0x80 | (cp & 0x3f)); n = 2; }
+    else if (cp < 0x10000) { b[0] = (char)(0xe0 | (cp >> 12)); b[1] = (char)(0x80 | ((cp >> 6) & 0x3f)); b[2] = (char)(0x80 | (cp & 0x3f)); n = 3; }
+    else { b[0] = (char)(0xf0 | (cp >> 18)); b[1] = (char)(0x80 | ((cp >> 12) & 0x3f)); b[2] = (char)(0x80 | ((cp >> 6) & 0x3f)); b[3] = (char)(0x80 | (cp & 0x3f)); n = 4; }
+    out_bytes(b, n);
+}
+
+// Write the cells that changed since the last present, then swap. Cursor
+// moves are skipped for runs of adjacent changes and colors are only set
+// when they differ from the previous cell written.
+static void present(void) {
+    char seq[48];
+    int32_t cursor_col = -1;
+    int32_t cursor_row = -1;
+    bool have_colors = false;
+    uint8_t fg[3] = {0}, bg[3] = {0};
+
+    for (int32_t row = 0; row < grid_rows; row++) {
+        for (int32_t col = 0; col < grid_cols; col++) {
+            Cell* next = &back_cells[row * grid_cols + col];
+            Cell* shown = &front_cells[row * grid_cols + col];
+            if (memcmp(next, shown, sizeof(Cell)) == 0) {
+                continue;
+            }
+            if (row != cursor_row || col != cursor_col) {
+                snprintf(seq, sizeof(seq), "\x1b[%d;%dH", row + 1, col + 1);
+                out_str(seq);
+            }
+            if (!have_colors || memcmp(fg, next->fg, 3) != 0) {
+                snprintf(seq, sizeof(seq), "\x1b[38;2;%u;%u;%um", next->fg[0], next->fg[1], next->fg[2]);
+                out_str(seq);
+                memcpy(fg, next->fg, 3);
+            }
+            if (!have_colors || memcmp(bg, next->bg, 3) != 0) {
+                snprintf(seq, sizeof(seq), "\x1b[48;2;%u;%u;%um", next->bg[0], next->bg[1], next->bg[2]);
+                out_str(seq);
+                memcpy(bg, next->bg, 3);
+            }
+            have_colors = true;
+            out_utf8(next->codepoint);
+            *shown = *next;
+            cursor_row = row;
+            cursor_col = col + 1;
+        }
+    }
+    if (out_length > 0) {
+        out_flush();
+    }
+}
+
+static Clay_Dimensions measure_cells(Clay_StringSlice text, Clay_TextElementConfig* config, void* user_data) {
+    (void)config;
+    (void)user_data;
+    return (Clay_Dimensions){ (float)utf8_count(text.chars, text.length) * TXXT_CELL_W, TXXT_CELL_H };
+}
+
+// ── TTY ────────────────────────────────────────────────────────
+
+static void tty_restore(void) {
+    if (tty_fd < 0) {
+        return;
+    }
+    out_str("\x1b[?1003l\x1b[?1006l\x1b[0m\x1b[?25h\x1b[?1049l");
+    out_flush();
+    tcsetattr(tty_fd, TCSAFLUSH, &tty_saved);
+}
+
+static void tty_on_signal(int sig) {
+    (void)sig;
+    tty_quit_signal = 1;
+}
+
+static bool tty_open(void) {
+    tty_fd = open("/dev/tty", O_RDWR | O_NOCTTY);
+    if (tty_fd < 0 || tcgetattr(tty_fd, &tty_saved) != 0) {
+        return false;
+    }
+    struct termios raw = tty_saved;
+    raw.c_iflag &= ~(tcflag_t)(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
+    raw.c_oflag &= ~(tcflag_t)OPOST;
+    raw.c_cflag |= CS8;
+    raw.c_lflag &= ~(tcflag_t)(ECHO | ICANON | IEXTEN | ISIG);
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    tcsetattr(tty_fd, TCSAFLUSH, &raw);
+    atexit(tty_restore);
+    // Without SA_RESTART, so a signal also cuts the frame poll short.
+    struct sigaction quit = {0};
+    quit.sa_handler = tty_on_signal;
+    sigemptyset(&quit.sa_mask);
+    sigaction(SIGTERM, &quit, NULL);
+    sigaction(SIGHUP, &quit, NULL);
+    sigaction(SIGINT, &quit, NULL);
+    // Alternate screen, hidden cursor, any-motion SGR mouse reporting.
+    out_str("\x1b[?1049h\x1b[?25l\x1b[?1003h\x1b[?1006h\x1b[2J");
+    out_flush();
+    return true;
+}
+
+static void tty_size(int32_t* cols, int32_t* rows) {
+    struct winsize ws;
+    if (ioctl(tty_fd, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0 && ws.ws_row > 0) {
+        *cols = ws.ws_col;
+        *rows = ws.ws_row;
+    } else {
+        *cols = 80;
+        *rows = 24;
+    }
+}
+
+typedef struct {
+    float mouse_x, mouse_y;
+    float wheel_y;
+    bool mouse_down;
+    bool pressed_this_frame;
+    // A press and release read in the same frame: release on the next one,
+    // so Clay sees the click.
+    bool release_pending;
+    bool quit;
+} InputState;
+
+static void edit_text(const uint8_t* bytes, uint32_t length) {
+    if (length > TXXT_EDIT_INPUT_MAX) length = TXXT_EDIT_INPUT_MAX;
+    memcpy(edit_input_buffer, bytes, length);
+    EditInsertText(length);
+}
+
+// CSI final byte and modifier parameter to an edit key.
+static void edit_csi(char final, int32_t param, int32_t modifier) {
+    uint32_t mods = 0;
+    if (modifier > 1) {
+        if ((modifier - 1) & 1) mods |= TXXT_KEY_MOD_SHIFT;
+        if ((modifier - 1) & 6) mods |= TXXT_KEY_MOD_WORD; // alt or ctrl
+    }
+    uint32_t key = 0;
+    switch (final) {
+        case 'A': key = TXXT_KEY_UP; break;
+        case 'B': key = TXXT_KEY_DOWN; break;
+        case 'C': key = TXXT_KEY_RIGHT; break;
+        case 'D': key = TXXT_KEY_LEFT; break;
+        case 'H': key = TXXT_KEY_HOME; break;
+        case 'F': key = TXXT_KEY_END; break;
+        case 'Z': key = TXXT_KEY_TAB; mods |= TXXT_KEY_MOD_SHIFT; break;
+        case '~':
+            key = param == 1 || param == 7 ? TXXT_KEY_HOME :
+                  param == 4 || param == 8 ? TXXT_KEY_END :
+                  param == 3 ? TXXT_KEY_DELETE : 0;
+            break;
+    }
+    if (key) EditKey(key, mods);
+}
+
+// Parse whatever the TTY delivered this frame.
+static void read_input(InputState* input) {
+    uint8_t buf[512];
+    ssize_t n = read(tty_fd, buf, sizeof(buf));
+    if (n <= 0) {
+        return;
+    }
+    bool editing = GetEditFocus() >= 0;
+    for (ssize_t i = 0; i < n;) {
+        uint8_t b = buf[i];
+        if (b == 0x03) { // Ctrl-C
+            input->quit = true;
+            return;
+        }
+        if (b == 0x1b && i + 1 < n && buf[i + 1] == '[') {
+            // CSI: ESC [ [<] params final
+            ssize_t j = i + 2;
+            bool sgr_mouse = j < n && buf[j] == '<';
+            if (sgr_mouse) j++;
+            int32_t params[3] = {0, 0, 0};
+            int32_t count = 0;
+            for (; j < n && ((buf[j] >= '0' && buf[j] <= '9') || buf[j] == ';'); j++) {
+                if (buf[j] == ';') {
+                    if (count < 2) count++;
+                } else {
+                    params[count] = params[count] * 10 + (buf[j] - '0');
+                }
+            }
+            if (j >= n) {
+                break; // truncated sequence
+            }
+            char final = (char)buf[j];
+            i = j + 1;
+            if (sgr_mouse) {
+                int32_t button = params[0];
+                input->mouse_x = ((float)params[1] - 0.5f) * TXXT_CELL_W;
+                input->mouse_y = ((float)params[2] - 0.5f) * TXXT_CELL_H;
+                if (button & 64) {
+                    input->wheel_y += (button & 1) ? -3.0f * TXXT_CELL_H : 3.0f * TXXT_CELL_H;
+                } else if ((button & 32) == 0 && (button & 3) == 0) {
+                    if (final == 'M') {
+                        input->mouse_down = true;
+                        input->pressed_this_frame = true;
+                        input->release_pending = false;
+                    } else if (input->pressed_this_frame) {
+                        input->release_pending = true;
+                    } else {
+                        input->mouse_down = false;
+                    }
+                }
+            } else if (editing) {
+                edit_csi(final, params[0], params[1]);
+            }
+            continue;
+        }
+        i++;
+        if (!editing) {
+            if (b == 'q') input->quit = true;
+            continue;
+        }
+        switch (b) {
+            case 0x1b: EditKey(TXXT_KEY_ESCAPE, 0); break;
+            case 0x7f:
+            case 0x08: EditKey(TXXT_KEY_BACKSPACE, 0); break;
+            case '\r': EditKey(TXXT_KEY_ENTER, 0); break;
+            case '\t': EditKey(TXXT_KEY_TAB, 0); break;
+            case 0x01: EditKey(TXXT_KEY_SELECT_ALL, 0); break;
+            default: {
+                if (b < 0x20) break;
+                // Forward the printable run in one insert.
+                ssize_t start = i - 1;
+                while (i < n && buf[i] >= 0x20 && buf[i] != 0x7f) i++;
+                edit_text(buf + start, (uint32_t)(i - start));
+                break;
+            }
+        }
+    }
+}
+
+// ── Game socket ────────────────────────────────────────────────
+
+typedef struct {
+    int fd;
+    // Non-blocking connect in flight; the upgrade request goes out once the
+    // socket turns writable, or the attempt is dropped at connect_deadline.
+    bool connecting;
+    double connect_deadline;
+    bool upgraded;
+    uint8_t* data;
+    size_t length;
+    size_t capacity;
+    // Fragments of the message being assembled.
+    uint8_t* message;
+    size_t message_length;
+    size_t message_capacity;
+    bool message_dropped;
+} GameSocket;
+
+static void socket_close(GameSocket* sock) {
+    if (sock->fd >= 0) {
+        close(sock->fd);
+    }
+    sock->fd = -1;
+    sock->connecting = false;
+    sock->upgraded = false;
+    sock->length = 0;
+    sock->message_length = 0;
+    sock->message_dropped = false;
+}
+
+// Start a non-blocking connect so an unreachable host never stalls the frame
+// loop; socket_finish_connect completes it. Only the first address that
+// accepts the attempt is used.
+static bool socket_connect(GameSocket* sock, const char* host, const char* port, double now) {
+    struct addrinfo hints = {0};
+    struct addrinfo* addrs = NULL;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, port, &hints, &addrs) != 0) {
+        return false;
+    }
+    int fd = -1;
+    for (struct addrinfo* a = addrs; a; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) continue;
+        if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0 &&
+            (connect(fd, a->ai_addr, a->ai_addrlen) == 0 || errno == EINPROGRESS)) {
+            break;
+        }
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addrs);
+    if (fd < 0) {
+        return false;
+    }
+    sock->fd = fd;
+    sock->connecting = true;
+    sock->connect_deadline = now + TXXT_TERM_CONNECT_SECONDS;
+    sock->upgraded = false;
+    sock->length = 0;
+    return true;
+}
+
+// The socket polled writable: check the connect result, go back to blocking
+// I/O and send the upgrade request.
+static bool socket_finish_connect(GameSocket* sock, const char* host, const char* port) {
+    int fd = sock->fd;
+    int error = 0;
+    socklen_t error_length = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_length) != 0 || error != 0 ||
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK) != 0) {
+        return false;
+    }
+    sock->connecting = false;
+
+    // The accept key is not checked: this only ever talks to a txxt backend.
+    char request[512];
+    int length = snprintf(request, sizeof(request),
+        "GET /api/game?snapshot=compact HTTP/1.1\r\n"
+        "Host: %s:%s\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dHh4dC10ZXJtaW5hbCE=\r\n"
+        "Sec-WebSocket-Version: 13\r\n\r\n", host, port);
+    return write(fd, request, (size_t)length) == length;
+}
+
+// Client frames must be masked; a zero key keeps the payload as-is.
+static void socket_send(GameSocket* sock, uint8_t opcode, const uint8_t* payload, size_t length) {
+    uint8_t header[8] = { (uint8_t)(0x80 | opcode), (uint8_t)(0x80 | (length < 126 ? length : 0)), 0, 0, 0, 0 };
+    if (length >= 126) {
+        return; // control frames only
+    }
+    if (write(sock->fd, header, 6) == 6 && length > 0) {
+        ssize_t ignored = write(sock->fd, payload, length);
+        (void)ignored;
+    }
+}
+
+static void apply_message(const uint8_t* message, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (message[0] == TXXT_COMPACT_MSG_SNAPSHOT) {
+        // Decoded in place: no copy into the WASM-sized input buffer.
+        if (!apply_compact_snapshot(message, (uint32_t)length)) {
+            snprintf(status_line, sizeof(status_line), "malformed snapshot");
+        }
+        return;
+    }
+    if (length <= TXXT_EVENT_INPUT_MAX) {
+        memcpy(event_input_buffer, message, length);
+        if (ApplyEventFrame((uint32_t)length) > 0) {
+            SetDataDirtyPulse(0.35f);
+        }
+    }
+}
+
+// Read what the socket has and apply every complete message. Returns false
+// once the connection is gone.
+static bool socket_pump(GameSocket* sock) {
+    if (sock->capacity - sock->length < 65536) {
+        sock->capacity = sock->capacity ? sock->capacity * 2 : 262144;
+        sock->data = realloc(sock->data, sock->capacity);
+    }
+    ssize_t n = read(sock->fd, sock->data + sock->length, sock->capacity - sock->length);
+    if (n == 0 || (n < 0 && errno != EINTR && errno != EAGAIN)) {
+        return false;
+    }
+    if (n > 0) {
+        sock->length += (size_t)n;
+    }
+
+    size_t at = 0;
+    if (!sock->upgraded) {
+        uint8_t* end = memmem(sock->data, sock->length, "\r\n\r\n", 4);
+        if (!end) {
+            return true;
+        }
+        if (sock->length < 12 || memcmp(sock->data + 9, "101", 3) != 0) {
+            snprintf(status_line, sizeof(status_line), "game socket refused the upgrade");
+            return false;
+        }
+        sock->upgraded = true;
+        status_line[0] = '\0';
+        at = (size_t)(end - sock->data) + 4;
+    }
+
+    for (;;) {
+        const uint8_t* frame = sock->data + at;
+        size_t available = sock->length - at;
+        if (available < 2) break;
+        uint64_t payload = frame[1] & 0x7f;
+        size_t header = 2;
+        if (payload == 126) {
+            if (available < 4) break;
+            payload = ((uint64_t)frame[2] << 8) | frame[3];
+            header = 4;
+        } else if (payload == 127) {
+            if (available < 10) break;
+            payload = 0;
+            for (int i = 0; i < 8; i++) payload = (payload << 8) | frame[2 + i];
+            header = 10;
+        }
+        if (payload > TXXT_WS_MESSAGE_MAX) {
+            snprintf(status_line, sizeof(status_line), "message too large (%llu bytes)", (unsigned long long)payload);
+            return false;
+        }
+        if (available < header + payload) break;
+
+        bool fin = frame[0] & 0x80;
+        uint8_t opcode = frame[0] & 0x0f;
+        const uint8_t* body = frame + header;
+        at += header + (size_t)payload;
+
+        if (opcode == 0x8) return false; // close
+        if (opcode == 0x9) { socket_send(sock, 0xA, body, (size_t)payload); continue; }
+        if (opcode != 0x0 && opcode != 0x2) continue; // text and pong: ignored
+
+        if (opcode == 0x2) {
+            sock->message_length = 0;
+            sock->message_dropped = false;
+        }
+        if (sock->message_length + payload > TXXT_WS_MESSAGE_MAX) {
+            sock->message_dropped = true;
+        } else {
+            size_t needed = sock->message_length + (size_t)payload;
+            if (needed > sock->message_capacity) {
+                size_t capacity = sock->message_capacity ? sock->message_capacity : 65536;
+                while (capacity < needed) capacity *= 2;
+                sock->message = realloc(sock->message, capacity);
+                sock->message_capacity = capacity;
+            }
+            memcpy(sock->message + sock->message_length, body, (size_t)payload);
+            sock->message_length += (size_t)payload;
+        }
+        if (fin) {
+            if (!sock->message_dropped) apply_message(sock->message, sock->message_length);
+            sock->message_length = 0;
+            sock->message_dropped = false;
+        }
+    }
+
+    memmove(sock->data, sock->data + at, sock->length - at);
+    sock->length -= at;
+    return true;
+}
+
+// ── Main loop ──────────────────────────────────────────────────
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void clay_error(Clay_ErrorData error) {
+    snprintf(status_line, sizeof(status_line), "clay: %.*s", error.errorText.length, error.errorText.chars);
+}
+
+int main(int argc, char** argv) {
+    char host[256] = TXXT_TERM_DEFAULT_HOST;
+    const char* port = TXXT_TERM_DEFAULT_PORT;
+    if (argc > 1) {
+        snprintf(host, sizeof(host), "%s", argv[1]);
+        char* colon = strrchr(host, ':');
+        if (colon) {
+            *colon = '\0';
+            port = argv[1] + (colon - host) + 1;
+        }
+    }
+
+    if (!tty_open()) {
+        fprintf(stderr, "txxt-term: needs a terminal\n");
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    uint32_t memory_size = Clay_MinMemorySize();
+    Clay_Arena arena = Clay_CreateArenaWithCapacityAndMemory(memory_size, malloc(memory_size));
+    int32_t cols, rows;
+    tty_size(&cols, &rows);
+    Clay_Initialize(arena, (Clay_Dimensions){ cols * TXXT_CELL_W, rows * TXXT_CELL_H }, (Clay_ErrorHandler){ clay_error, 0 });
+    Clay_SetMeasureTextFunction(measure_cells, 0);
+    SetScratchMemory(calloc(1, TXXT_CMD_BUFFER_BYTES));
+    InitApp();
+    SetLoggedIn(true); // dev mode, as in the canvas host
+    SetToday((uint32_t)(time(NULL) / 86400));
+
+    GameSocket sock = { .fd = -1 };
+    double retry_at = 0.0;
+    double last = now_seconds();
+    InputState input = {0};
+
+    while (!input.quit && !tty_quit_signal) {
+        double t = now_seconds();
+        if (sock.fd < 0 && t >= retry_at) {
+            snprintf(status_line, sizeof(status_line), "connecting to %s:%s", host, port);
+            if (!socket_connect(&sock, host, port, t)) {
+                snprintf(status_line, sizeof(status_line), "offline: %s:%s unreachable, retrying", host, port);
+                retry_at = t + TXXT_TERM_RETRY_SECONDS;
+            }
+        }
+
+        struct pollfd fds[2] = { { tty_fd, POLLIN, 0 }, { sock.fd, sock.connecting ? POLLOUT : POLLIN, 0 } };
+        if (poll(fds, sock.fd >= 0 ? 2 : 1, TXXT_TERM_FRAME_MS) < 0) {
+            fds[0].revents = 0;
+            fds[1].revents = 0;
+        }
+        if (fds[0].revents & POLLIN) {
+            read_input(&input);
+        }
+        if (sock.connecting) {
+            bool ready = (fds[1].revents & (POLLOUT | POLLHUP | POLLERR)) != 0;
+            if (ready ? !socket_finish_connect(&sock, host, port) : now_seconds() >= sock.connect_deadline) {
+                socket_close(&sock);
+                snprintf(status_line, sizeof(status_line), "offline: %s:%s %s, retrying", host, port,
+                         ready ? "unreachable" : "timed out");
+                retry_at = now_seconds() + TXXT_TERM_RETRY_SECONDS;
+            }
+        } else if (sock.fd >= 0 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+            if (!socket_pump(&sock)) {
+                socket_close(&sock);
+                if (!status_line[0]) {
+                    snprintf(status_line, sizeof(status_line), "disconnected, retrying");
+                }
+                retry_at = now_seconds() + TXXT_TERM_RETRY_SECONDS;
+            }
+        }
+        // Nothing to send these to yet.
+        TakeEditSubmit();
+        DrainDetailRequests();
+
+        tty_size(&cols, &rows);
+        if (grid_resize(cols, rows)) {
+            out_str("\x1b[0m\x1b[2J");
+        }
+
+        t = now_seconds();
+        float dt = (float)(t - last);
+        last = t;
+        Clay_RenderCommandArray cmds = LayoutFrame(cols * TXXT_CELL_W, rows * TXXT_CELL_H,
+                                                   0.0f, input.wheel_y, input.mouse_x, input.mouse_y,
+                                                   false, input.mouse_down, dt);
+        input.wheel_y = 0.0f;
+        input.pressed_this_frame = false;
+        if (input.release_pending) {
+            input.mouse_down = false;
+            input.release_pending = false;
+        }
+        rasterize(cmds);
+        present();
+    }
+
+    socket_close(&sock);
+    return 0;
+}
@@ -0,0 +1,665 @@
+//! Fan-out load generator for the game WebSocket.
+//!
+//! Boots the real server binary against a temp save file on a free localhost
+//! port, connects N simulated clients speaking the wire.rs binary protocol,
+//! drives a weighted command mix, then reports command → broadcast latency
+//! percentiles, throughput and server memory. Nothing leaves localhost.
+//!
+//! ```text
+//! cargo bench --bench fanout -- --clients 200 --commands 50 --rate 20
+//!
+//!   --clients N     connected clients                      [100]
+//!   --commands N    commands each client sends             [50]
+//!   --rate N        commands per second per client         [10]
+//!   --mix C:M:X:D   weights for create:move:complete:delete [2:5:1:1]
+//!   --seed N        tasks created before clients connect   [0]
+//!   --compact       hydrate with ?snapshot=compact
+//!   --idle-ms N     quiet time that ends the drain          [1000]
+//! ```
+//!
+//! Latency is measured per (event, receiving client): from the moment the
+//! owning client wrote the command to the moment each client read the event
+//! (plain or inside a batch frame). "echo" is the sender's own copy.
+
+use std::collections::HashMap;
+use std::net::SocketAddr;
+use std::process::{Child, Command, Stdio};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
+use tokio::sync::Barrier;
+
+// ── Wire constants (mirror backend/src/wire.rs) ────────────────
+
+const SNAPSHOT: u8 = 0x01;
+const TASK_CREATED: u8 = 0x02;
+const TASK_SCHEDULED: u8 = 0x03;
+const TASK_MOVED: u8 = 0x04;
+const TASK_UNSCHEDULED: u8 = 0x05;
+const TASK_COMPLETED: u8 = 0x06;
+const TASK_DELETED: u8 = 0x07;
+const SNAPSHOT_COMPACT: u8 = 0x08;
+const BATCH: u8 = 0x09;
+const DURABLE: u8 = 0x0A;
+const HELLO: u8 = 0x0B;
+
+const CMD_CREATE_TASK: u8 = 0x10;
+const CMD_MOVE_TASK: u8 = 0x12;
+const CMD_COMPLETE_TASK: u8 = 0x14;
+const CMD_DELETE_TASK: u8 = 0x15;
+
+const TASK_STRIDE: usize = 192;
+const SERVICE_STRIDE: usize = 80;
+const SNAPSHOT_HEADER: usize = 17;
+const COMPACT_SNAPSHOT_HEADER: usize = 21;
+const COMPACT_TASK_STRIDE: usize = 60;
+const COMPACT_SERVICE_STRIDE: usize = 20;
+const EVENT_HEADER: usize = 25;
+const BATCH_HEADER: usize = 3;
+const HELLO_LEN: usize = 17;
+
+/// 2026-02-11, a Wednesday.
+const BASE_DATE: u16 = 20495;
+
+fn event_frame_len(msg_type: u8) -> Option<usize> {
+    match msg_type {
+        TASK_CREATED => Some(9 + TASK_STRIDE),
+        TASK_SCHEDULED | TASK_MOVED => Some(EVENT_HEADER + 6),
+        TASK_UNSCHEDULED | TASK_COMPLETED | TASK_DELETED => Some(EVENT_HEADER),
+        DURABLE => Some(9),
+        _ => None,
+    }
+}
+
+// ── Options ────────────────────────────────────────────────────
+
+struct Options {
+    clients: usize,
+    commands: usize,
+    rate: f64,
+    /// create, move, complete, delete
+    mix: [u32; 4],
+    seed: usize,
+    compact: bool,
+    idle: Duration,
+}
+
+impl Options {
+    fn parse() -> Options {
+        let mut opts = Options {
+            clients: 100,
+            commands: 50,
+            rate: 10.0,
+            mix: [2, 5, 1, 1],
+            seed: 0,
+            compact: false,
+            idle: Duration::from_millis(1000),
+        };
+        let mut args = std::env::args().skip(1);
+        while let Some(arg) = args.next() {
+            let mut value = || args.next().unwrap_or_else(|| usage(&format!("{arg} needs a value")));
+            match arg.as_str() {
+                "--clients" => opts.clients = number(&value()),
+                "--commands" => opts.commands = number(&value()),
+                "--rate" => opts.rate = number(&value()),
+                "--seed" => opts.seed = number(&value()),
+                "--idle-ms" => opts.idle = Duration::from_millis(number(&value())),
+                "--compact" => opts.compact = true,
+                "--mix" => {
+                    let weights: Vec<u32> = value().split(':').map(number).collect();
+                    if weights.len() != 4 || weights.iter().all(|w| *w == 0) {
+                        usage("--mix takes four weights, e.g. 2:5:1:1");
+                    }
+                    opts.mix.copy_from_slice(&weights);
+                }
+                "--bench" => {} // passed by `cargo bench`
+                "--help" | "-h" => usage(""),
+                other => usage(&format!("unknown option {other}")),
+            }
+        }
+        if opts.clients == 0 || opts.rate <= 0.0 {
+            usage("--clients and --rate must be positive");
+        }
+        opts
+    }
+}
+
+fn number<T: std::str::FromStr>(s: &str) -> T {
+    s.parse().unwrap_or_else(|_| usage(&format!("not a number: {s}")))
+}
+
+fn usage(problem: &str) -> ! {
+    if !problem.is_empty() {
+        eprintln!("fanout: {problem}");
+    }
+    eprintln!("usage: cargo bench --bench fanout -- [--clients N] [--commands N] [--rate N]");
+    eprintln!("       [--mix C:M:X:D] [--seed N] [--compact] [--idle-ms N]");
+    std::process::exit(2);
+}
+
+// ── Server process ─────────────────────────────────────────────
+
+/// The server under test. Killed and its save file removed on drop.
+struct Server {
+    child: Child,
+    addr: SocketAddr,
+    save_file: std::path::PathBuf,
+}
+
+impl Server {
+    fn start() -> Server {
+        let addr = {
+            let probe = std::net::TcpListener::bind("127.0.0.1:0").expect("no free port");
+            probe.local_addr().unwrap()
+        };
+        let save_file = std::env::temp_dir().join(format!("txxt-fanout-{}.redb", std::process::id()));
+        let _ = std::fs::remove_file(&save_file);
+
+        let child = Command::new(env!("CARGO_BIN_EXE_txxt-server"))
+            .env("TXXT_SAVE_FILE", &save_file)
+            .env("TXXT_ADDR", addr.to_string())
+            .stdout(Stdio::null())
+            .stderr(Stdio::null())
+            .spawn()
+            .expect("failed to start txxt-server");
+
+        let deadline = Instant::now() + Duration::from_secs(10);
+        while std::net::TcpStream::connect(addr).is_err() {
+            assert!(Instant::now() < deadline, "server did not start listening on {addr}");
+            std::thread::sleep(Duration::from_millis(20));
+        }
+        Server { child, addr, save_file }
+    }
+
+    /// (VmRSS, VmHWM) in KiB, from /proc. None off Linux.
+    fn memory_kib(&self) -> Option<(u64, u64)> {
+        let status = std::fs::read_to_string(format!("/proc/{}/status", self.child.id())).ok()?;
+        let field = |name: &str| {
+            status.lines()
+                .find(|l| l.starts_with(name))
+                .and_then(|l| l.split_whitespace().nth(1))
+                .and_then(|v| v.parse().ok())
+        };
+        Some((field("VmRSS:")?, field("VmHWM:")?))
+    }
+}
+
+impl Drop for Server {
+    fn drop(&mut self) {
+        let _ = self.child.kill();
+        let _ = self.child.wait();
+        let _ = std::fs::remove_file(&self.save_file);
+    }
+}
+
+// ── Minimal WebSocket client ───────────────────────────────────
+//
+// Just enough RFC 6455 for a localhost bench: one upgrade request, masked
+// binary frames out, unfragmented or continued binary frames in.
+
+mod ws {
+    use std::io;
+    use std::net::SocketAddr;
+    use tokio::io::{AsyncBufReadExt, AsyncReadExt, AsyncWriteExt, BufReader};
+    use tokio::net::tcp::{OwnedReadHalf, OwnedWriteHalf};
+    use tokio::net::TcpStream;
+
+    pub struct Reader {
+        inner: BufReader<OwnedReadHalf>,
+    }
+
+    pub struct Writer {
+        inner: OwnedWriteHalf,
+        mask_state: u32,
+    }
+
+    pub async fn connect(addr: SocketAddr, path: &str) -> io::Result<(Reader, Writer)> {
+        let stream = TcpStream::connect(addr).await?;
+        stream.set_nodelay(true)?;
+        let (read, mut write) = stream.into_split();
+        let request = format!(
+            "GET {path} HTTP/1.1\r\nHost: {addr}\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\
+             Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n"
+        );
+        write.write_all(request.as_bytes()).await?;
+
+        let mut reader = BufReader::new(read);
+        let mut line = String::new();
+        reader.read_line(&mut line).await?;
+        if !line.starts_with("HTTP/1.1 101") {
+            return Err(io::Error::new(io::ErrorKind::Other, format!("upgrade refused: {}", line.trim())));
+        }
+        loop {
+            line.clear();
+            reader.read_line(&mut line).await?;
+            if line == "\r\n" || line.is_empty() {
+                break;
+            }
+        }
+        let mask_state = addr.port() as u32 ^ 0x9E37_79B9;
+        Ok((Reader { inner: reader }, Writer { inner: write, mask_state }))
+    }
+
+    impl Reader {
+        /// Next binary message, or None once the server closes.
+        pub async fn next(&mut self) -> io::Result<Option<Vec<u8>>> {
+            let mut message = Vec::new();
+            loop {
+                let mut head = [0u8; 2];
+                if self.inner.read_exact(&mut head).await.is_err() {
+                    return Ok(None);
+                }
+                let fin = head[0] & 0x80 != 0;
+                let opcode = head[0] & 0x0F;
+                let len = match head[1] & 0x7F {
+                    126 => self.inner.read_u16().await? as usize,
+                    127 => self.inner.read_u64().await? as usize,
+                    n => n as usize,
+                };
+                let start = message.len();
+                message.resize(start + len, 0);
+                self.inner.read_exact(&mut message[start..]).await?;
+                match opcode {
+                    0x8 => return Ok(None),
+                    0x9 | 0xA => message.truncate(start), // ping/pong: nothing to answer here
+                    _ if fin => return Ok(Some(message)),
+                    _ => {} // continuation follows
+                }
+            }
+        }
+    }
+
+    impl Writer {
+        pub async fn send(&mut self, payload: &[u8]) -> io::Result<()> {
+            let mut frame = Vec::with_capacity(payload.len() + 14);
+            frame.push(0x82); // FIN + binary
+            match payload.len() {
+                n if n < 126 => frame.push(0x80 | n as u8),
+                n if n <= u16::MAX as usize => {
+                    frame.push(0x80 | 126);
+                    frame.extend_from_slice(&(n as u16).to_be_bytes());
+                }
+                n => {
+                    frame.push(0x80 | 127);
+                    frame.extend_from_slice(&(n as u64).to_be_bytes());
+                }
+            }
+            // xorshift32: masks only need to be unpredictable to proxies.
+            self.mask_state ^= self.mask_state << 13;
+            self.mask_state ^= self.mask_state >> 17;
+            self.mask_state ^= self.mask_state << 5;
+            let mask = self.mask_state.to_be_bytes();
+            frame.extend_from_slice(&mask);
+            frame.extend(payload.iter().enumerate().map(|(i, b)| b ^ mask[i % 4]));
+            self.inner.write_all(&frame).await
+        }
+    }
+}
+
+// ── Simulated client ───────────────────────────────────────────
+
+/// Identifies one event across every client: (event type, task id or the
+/// create token, occurrence). Occurrence counts repeats of the same type on
+/// the same task (moves), which every client sees in the same order.
+type Key = (u8, u128, u32);
+
+struct Rng(u64);
+
+impl Rng {
+    fn next(&mut self) -> u64 {
+        // splitmix64
+        self.0 = self.0.wrapping_add(0x9E37_79B9_7F4A_7C15);
+        let mut z = self.0;
+        z = (z ^ (z >> 30)).wrapping_mul(0xBF58_476D_1CE4_E5B9);
+        z = (z ^ (z >> 27)).wrapping_mul(0x94D0_49BB_1331_11EB);
+        z ^ (z >> 31)
+    }
+
+    fn below(&mut self, n: usize) -> usize {
+        (self.next() % n as u64) as usize
+    }
+}
+
+#[derive(Default)]
+struct ClientReport {
+    sent: Vec<(Key, Instant)>,
+    received: Vec<(Key, Instant)>,
+    hydrate: Duration,
+    /// Disconnected by the server before the run ended.
+    dropped: bool,
+    frames: u64,
+    bytes: u64,
+}
+
+fn create_token(client: usize, seq: usize) -> u128 {
+    ((client as u128) << 32) | seq as u128
+}
+
+/// Parse "bench <client> <seq>" from a packed task title.
+fn title_token(record: &[u8]) -> Option<(usize, u128)> {
+    let title = &record[56..56 + 128];
+    let end = title.iter().position(|b| *b == 0).unwrap_or(title.len());
+    let mut parts = std::str::from_utf8(&title[..end]).ok()?.strip_prefix("bench ")?.split(' ');
+    let client: usize = parts.next()?.parse().ok()?;
+    let seq: usize = parts.next()?.parse().ok()?;
+    Some((client, create_token(client, seq)))
+}
+
+/// Every game socket opens with HELLO (the server epoch), then hydrates.
+/// Returns the HELLO and the snapshot frame.
+async fn read_hydration(reader: &mut ws::Reader) -> (Vec<u8>, Vec<u8>) {
+    let hello = reader.next().await.expect("read failed").expect("closed before hello");
+    assert!(
+        hello.len() == HELLO_LEN && hello[0] == HELLO,
+        "expected hello, got message type 0x{:02X}",
+        hello[0]
+    );
+    let snapshot = reader.next().await.expect("read failed").expect("closed before snapshot");
+    (hello, snapshot)
+}
+
+fn service_ids(snapshot: &[u8]) -> Vec<[u8; 16]> {
+    let task_count = u32::from_le_bytes(snapshot[9..13].try_into().unwrap()) as usize;
+    let service_count = u32::from_le_bytes(snapshot[13..17].try_into().unwrap()) as usize;
+    let (start, stride) = match snapshot[0] {
+        SNAPSHOT => (SNAPSHOT_HEADER + task_count * TASK_STRIDE, SERVICE_STRIDE),
+        SNAPSHOT_COMPACT => (COMPACT_SNAPSHOT_HEADER + task_count * COMPACT_TASK_STRIDE, COMPACT_SERVICE_STRIDE),
+        other => panic!("expected a snapshot, got message type 0x{other:02X}"),
+    };
+    (0..service_count)
+        .map(|i| snapshot[start + i * stride..start + i * stride + 16].try_into().unwrap())
+        .collect()
+}
+
+fn pack_create(service: &[u8; 16], title: &str, priority: u8, date: u16) -> Vec<u8> {
+    let mut buf = vec![0u8; 40];
+    buf[0] = CMD_CREATE_TASK;
+    buf[1] = priority;
+    buf[2..18].copy_from_slice(service);
+    buf[34..36].copy_from_slice(&date.to_le_bytes());
+    buf[36..38].copy_from_slice(&540u16.to_le_bytes());
+    buf[38..40].copy_from_slice(&60u16.to_le_bytes());
+    buf.extend_from_slice(title.as_bytes());
+    buf
+}
+
+fn pack_task_command(cmd: u8, task_id: &[u8; 16]) -> Vec<u8> {
+    let mut buf = vec![cmd];
+    buf.extend_from_slice(task_id);
+    buf
+}
+
+/// Split a frame into the events it carries (a batch, or one plain event).
+fn for_each_event(frame: &[u8], mut f: impl FnMut(&[u8])) {
+    if frame[0] != BATCH {
+        f(frame);
+        return;
+    }
+    let count = u16::from_le_bytes([frame[1], frame[2]]) as usize;
+    let mut offset = BATCH_HEADER;
+    for _ in 0..count {
+        let len = event_frame_len(frame[offset]).expect("unknown event in batch");
+        f(&frame[offset..offset + len]);
+        offset += len;
+    }
+}
+
+struct Shared {
+    opts: Options,
+    addr: SocketAddr,
+    ready: Barrier,
+    senders_done: AtomicBool,
+}
+
+async fn run_client(id: usize, shared: Arc<Shared>) -> ClientReport {
+    let opts = &shared.opts;
+    let path = if opts.compact { "/api/game?snapshot=compact" } else { "/api/game" };
+    let mut report = ClientReport::default();
+
+    let connect_start = Instant::now();
+    let (mut reader, mut writer) = ws::connect(shared.addr, path).await.expect("connect failed");
+    let (hello, snapshot) = read_hydration(&mut reader).await;
+    // Hydrated once the snapshot frame is in, not at the greeting.
+    report.hydrate = connect_start.elapsed();
+    report.frames += 2;
+    report.bytes += (hello.len() + snapshot.len()) as u64;
+    let services = service_ids(&snapshot);
+    assert!(!services.is_empty(), "server has no services to create tasks in");
+
+    // Our own tasks that are still scheduled, as learned from their echoes.
+    let live: Arc<Mutex<Vec<[u8; 16]>>> = Arc::default();
+
+    shared.ready.wait().await;
+
+    let recv = {
+        let live = live.clone();
+        let shared = shared.clone();
+        tokio::spawn(async move {
+            let mut received = Vec::new();
+            let mut seen: HashMap<(u8, u128), u32> = HashMap::new();
+            let (mut frames, mut bytes) = (0u64, 0u64);
+            let mut dropped = false;
+            loop {
+                let frame = match tokio::time::timeout(shared.opts.idle, reader.next()).await {
+                    Ok(Ok(Some(frame))) => frame,
+                    Ok(_) => {
+                        // Closed under load: the server drops clients that lag its broadcast.
+                        dropped = !shared.senders_done.load(Ordering::Acquire);
+                        break;
+                    }
+                    Err(_) if shared.senders_done.load(Ordering::Acquire) => break,
+                    Err(_) => continue,
+                };
+                let at = Instant::now();
+                frames += 1;
+                bytes += frame.len() as u64;
+                for_each_event(&frame, |event| {
+                    let kind = event[0];
+                    if kind == DURABLE {
+                        return;
+                    }
+                    let subject = match kind {
+                        TASK_CREATED => match title_token(&event[9..]) {
+                            Some((owner, token)) => {
+                                if owner == id {
+                                    live.lock().unwrap().push(event[9..25].try_into().unwrap());
+                                }
+                                token
+                            }
+                            None => return, // not ours (e.g. seed tasks)
+                        },
+                        _ => u128::from_le_bytes(event[9..25].try_into().unwrap()),
+                    };
+                    let n = seen.entry((kind, subject)).or_insert(0);
+                    received.push(((kind, subject, *n), at));
+                    *n += 1;
+                });
+            }
+            (received, frames, bytes, dropped)
+        })
+    };
+
+    // Send loop: open-loop at the configured rate.
+    let mut rng = Rng((id as u64).wrapping_mul(0x2545_F491_4F6C_DD1D) + 1);
+    let mut sent_counts: HashMap<(u8, u128), u32> = HashMap::new();
+    let mut ticker = tokio::time::interval(Duration::from_secs_f64(1.0 / opts.rate));
+    let total_weight: u32 = opts.mix.iter().sum();
+    for seq in 0..opts.commands {
+        ticker.tick().await;
+
+        let mut pick = (rng.next() % total_weight as u64) as u32;
+        let mut kind = 0;
+        while pick >= opts.mix[kind] {
+            pick -= opts.mix[kind];
+            kind += 1;
+        }
+        let target = {
+            let mut live = live.lock().unwrap();
+            match kind {
+                _ if live.is_empty() => None,
+                1 => Some(live[rng.below(live.len())]),
+                2 | 3 => {
+                    let at = rng.below(live.len());
+                    Some(live.swap_remove(at))
+                }
+                _ => None,
+            }
+        };
+
+        let (frame, key) = match target {
+            None => {
+                let service = &services[rng.below(services.len())];
+                let date = BASE_DATE + (seq % 7) as u16;
+                let frame = pack_create(service, &format!("bench {id} {seq}"), (seq % 4) as u8, date);
+                (frame, (TASK_CREATED, create_token(id, seq)))
+            }
+            Some(task) if kind == 1 => {
+                let mut frame = pack_task_command(CMD_MOVE_TASK, &task);
+                frame.extend_from_slice(&(BASE_DATE + rng.below(7) as u16).to_le_bytes());
+                frame.extend_from_slice(&((rng.below(92) * 15) as u16).to_le_bytes());
+                frame.extend_from_slice(&60u16.to_le_bytes());
+                (frame, (TASK_MOVED, u128::from_le_bytes(task)))
+            }
+            Some(task) if kind == 2 => {
+                (pack_task_command(CMD_COMPLETE_TASK, &task), (TASK_COMPLETED, u128::from_le_bytes(task)))
+            }
+            Some(task) => (pack_task_command(CMD_DELETE_TASK, &task), (TASK_DELETED, u128::from_le_bytes(task))),
+        };
+
+        let n = sent_counts.entry(key).or_insert(0);
+        report.sent.push(((key.0, key.1, *n), Instant::now()));
+        *n += 1;
+        if writer.send(&frame).await.is_err() {
+            break;
+        }
+    }
+
+    shared.ready.wait().await; // every client has sent everything
+    shared.senders_done.store(true, Ordering::Release);
+
+    let (received, frames, bytes, dropped) = recv.await.expect("receiver panicked");
+    report.received = received;
+    report.dropped = dropped;
+    report.frames += frames;
+    report.bytes += bytes;
+    report
+}
+
+/// Create `count` tasks before the measured clients connect.
+async fn seed(addr: SocketAddr, count: usize) {
+    let (mut reader, mut writer) = ws::connect(addr, "/api/game").await.expect("seed connect failed");
+    let (_, snapshot) = read_hydration(&mut reader).await;
+    let services = service_ids(&snapshot);
+    for i in 0..count {
+        let service = &services[i % services.len()];
+        let frame = pack_create(service, &format!("seed {i}"), (i % 4) as u8, BASE_DATE + (i % 7) as u16);
+        writer.send(&frame).await.expect("seed send failed");
+    }
+    let mut created = 0;
+    while created < count {
+        let frame = reader.next().await.unwrap().expect("closed while seeding");
+        for_each_event(&frame, |event| created += (event[0] == TASK_CREATED) as usize);
+    }
+}
+
+// ── Report ─────────────────────────────────────────────────────
+
+fn percentiles(label: &str, mut micros: Vec<u64>) {
+    if micros.is_empty() {
+        println!("  {label:<10} (no samples)");
+        return;
+    }
+    micros.sort_unstable();
+    let at = |q: f64| micros[((micros.len() - 1) as f64 * q).round() as usize] as f64 / 1000.0;
+    println!(
+        "  {label:<10} n={:<9} p50 {:>8.3}  p90 {:>8.3}  p99 {:>8.3}  p99.9 {:>8.3}  max {:>8.3} ms",
+        micros.len(), at(0.5), at(0.9), at(0.99), at(0.999), at(1.0),
+    );
+}
+
+fn main() {
+    let opts = Options::parse();
+    let runtime = tokio::runtime::Builder::new_multi_thread().enable_all().build().unwrap();
+
+    let server = Server::start();
+    let addr = server.addr;
+    println!(
+        "fanout: {} clients × {} commands at {}/s, mix create:move:complete:delete = {:?}{}",
+        opts.clients, opts.commands, opts.rate, opts.mix,
+        if opts.compact { ", compact snapshots" } else { "" },
+    );
+
+    runtime.block_on(async move {
+        if opts.seed > 0 {
+            let start = Instant::now();
+            seed(addr, opts.seed).await;
+            println!("  seeded {} tasks in {:.2?}", opts.seed, start.elapsed());
+        }
+
+        let clients = opts.clients;
+        let shared = Arc::new(Shared {
+            opts,
+            addr,
+            ready: Barrier::new(clients),
+            senders_done: AtomicBool::new(false),
+        });
+
+        let start = Instant::now();
+        let handles: Vec<_> = (0..clients).map(|id| tokio::spawn(run_client(id, shared.clone()))).collect();
+        let mut reports = Vec::with_capacity(clients);
+        for handle in handles {
+            reports.push(handle.await.expect("client panicked"));
+        }
+        let elapsed = start.elapsed();
+
+        // Join every receipt with the time its command was written.
+        let sent: HashMap<Key, (Instant, usize)> = reports.iter().enumerate()
+            .flat_map(|(client, r)| r.sent.iter().map(move |(key, at)| (*key, (*at, client))))
+            .collect();
+        let (mut echo, mut fanout) = (Vec::new(), Vec::new());
+        let mut unmatched = 0usize;
+        for (client, report) in reports.iter().enumerate() {
+            for (key, at) in &report.received {
+                let Some((sent_at, owner)) = sent.get(key) else {
+                    unmatched += 1;
+                    continue;
+                };
+                let micros = at.saturating_duration_since(*sent_at).as_micros() as u64;
+                if *owner == client {
+                    echo.push(micros);
+                }
+                fanout.push(micros);
+            }
+        }
+
+        let commands = sent.len();
+        let first_sent = reports.iter().flat_map(|r| r.sent.first()).map(|(_, t)| *t).min();
+        let last_seen = reports.iter().flat_map(|r| r.received.iter().map(|(_, t)| *t)).max();
+        let applied = reports[0].received.len();
+        let frames: u64 = reports.iter().map(|r| r.frames).sum();
+        let bytes: u64 = reports.iter().map(|r| r.bytes).sum();
+
+        println!("  wall time  {elapsed:.2?}");
+        percentiles("hydrate", reports.iter().map(|r| r.hydrate.as_micros() as u64).collect());
+        percentiles("echo", echo);
+        percentiles("fan-out", fanout);
+        if let (Some(first), Some(last)) = (first_sent, last_seen) {
+            let secs = last.duration_since(first).as_secs_f64().max(1e-9);
+            println!(
+                "  throughput {:.0} commands/s sent, {:.0} events/s applied, {:.0} frames/s and {:.1} MiB/s delivered",
+                commands as f64 / secs, applied as f64 / secs, frames as f64 / secs,
+                bytes as f64 / secs / (1024.0 * 1024.0),
+            );
+        }
+        println!("  events     {applied} applied of {commands} commands sent ({unmatched} unmatched receipts)");
+        let dropped = reports.iter().filter(|r| r.dropped).count();
+        if dropped > 0 {
+            println!("  dropped    {dropped} clients disconnected for lagging the broadcast");
+        }
+    });
+
+    match server.memory_kib() {
+        Some((rss, peak)) => println!("  server mem rss {:.1} MiB, peak {:.1} MiB", rss as f64 / 1024.0, peak as f64 / 1024.0),
+        None => println!("  server mem n/a (no /proc)"),
+    }
+}
@@ -1,5 +1,6 @@
-use crate::persist::SaveFile;
-use crate::world::World;
+use crate::checkpoint::Checkpoint;
+use crate::store::{Submission, WorldStore};
+use crate::wire::SnapshotCache;
 use argon2::{Argon2, PasswordHash, PasswordVerifier};
 use axum::{
     extract::State,
@@ -50,9 +51,21 @@ pub struct Claims {
 // ── Shared state ───────────────────────────────────────────────
 
 pub struct AppState {
-    pub world: std::sync::RwLock<World>,
-    pub save_file: SaveFile,
-    pub game_tx: tokio::sync::broadcast::Sender<Vec<u8>>,
+    /// Published World versions; loading one never blocks the apply loop.
+    pub world: Arc<WorldStore>,
+    /// Commands for the apply loop, the World's only writer.
+    pub commands: tokio::sync::mpsc::Sender<Submission>,
+    /// Packed snapshot for hydrating clients. Reader-side only; the apply
+    /// loop never takes this lock.
+    pub snapshot: std::sync::Mutex<SnapshotCache>,
+    /// Checkpoint at the saved revision, mapped at boot: clients connecting
+    /// while the World is still loading are hydrated from it.
+    pub checkpoint: Option<Checkpoint>,
+    /// Packed events, shared by every subscriber (one allocation per event).
+    pub game_tx: tokio::sync::broadcast::Sender<Arc<[u8]>>,
+    /// Random id of this server run, greeted to every game socket
+    /// (wire::HELLO_LEN). Revisions only resume within one epoch.
+    pub epoch: u64,
 }
 
 pub type SharedState = Arc<AppState>;
@@ -103,7 +116,7 @@ pub async fn login(
     State(state): State<SharedState>,
     Json(payload): Json<LoginRequest>,
 ) -> Result<Json<LoginResponse>, (StatusCode, String)> {
-    let world = state.world.read().unwrap();
+    let world = state.world.loaded().await;
 
     let user = world.get_user_by_username(&payload.username)
         .ok_or((StatusCode::UNAUTHORIZED, "Invalid credentials".to_string()))?;
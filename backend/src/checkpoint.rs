@@ -0,0 +1,337 @@
+//! Memory-mapped checkpoint for fast cold starts.
+//!
+//! An optional file holding the World's tasks and services as a wire.rs
+//! fixed-stride SNAPSHOT frame, task records grouped by service, followed by
+//! a per-service index into them. At boot the file is mapped, not read: when
+//! its revision matches the save file's, clients connecting while the World
+//! is still loading from redb are hydrated straight from the mapping (full or
+//! scoped, no decoding), so time to first snapshot doesn't grow with the
+//! dataset.
+//!
+//! Rewritten off the apply path from a published World version, once the
+//! journal has gone quiet at a new revision; a checkpoint is only used when
+//! the save file holds exactly its revision. Written to a temp file and
+//! renamed into place, never modified in place.
+//!
+//! ```text
+//! [0..8]    magic "TXXTCKP1"
+//! [8..16]   revision (u64 LE)
+//! [16..24]  frame length (u64 LE)
+//! [24..28]  index entry count (u32 LE)
+//! [28..32]  _reserved
+//! [32..]    snapshot frame (wire::SNAPSHOT_HEADER + task + service records)
+//! then      index, one entry per service with tasks, sorted by service id:
+//!           service id (16) + first task slot (u32 LE) + task count (u32 LE)
+//! ```
+
+use crate::store::WorldStore;
+use crate::wire::{self, msg, EventScope, SERVICE_STRIDE, SNAPSHOT_HEADER, TASK_STRIDE};
+use crate::world::World;
+use memmap2::Mmap;
+use std::collections::HashSet;
+use std::fs::File;
+use std::io::Write;
+use std::sync::Arc;
+use std::time::Duration;
+use tokio::sync::watch;
+use uuid::Uuid;
+
+pub const CHECKPOINT_MAGIC: &[u8; 8] = b"TXXTCKP1";
+pub const CHECKPOINT_HEADER: usize = 32;
+pub const INDEX_ENTRY: usize = 24;
+
+/// How long the journal must stay at one revision before it is checkpointed.
+pub const CHECKPOINT_QUIET: Duration = Duration::from_secs(60);
+
+/// A mapped, validated checkpoint file.
+pub struct Checkpoint {
+    map: Mmap,
+    revision: u64,
+    frame_len: usize,
+    task_count: usize,
+    index_count: usize,
+}
+
+impl Checkpoint {
+    /// Map the checkpoint at `path` if it holds exactly `revision` (the save
+    /// file's). Only headers and the index are checked; records are not
+    /// touched until a client needs them.
+    pub fn open(path: &str, revision: u64) -> Result<Self, CheckpointError> {
+        let file = File::open(path)?;
+        // SAFETY: checkpoint files are only ever replaced by rename (see
+        // `write`), never written in place, so the mapping can't change.
+        let map = unsafe { Mmap::map(&file)? };
+
+        if map.len() < CHECKPOINT_HEADER || &map[0..8] != CHECKPOINT_MAGIC {
+            return Err(CheckpointError::Corrupt("bad header"));
+        }
+        let file_revision = u64::from_le_bytes(map[8..16].try_into().unwrap());
+        if file_revision != revision {
+            return Err(CheckpointError::Stale { checkpoint: file_revision, save_file: revision });
+        }
+        let frame_len = u64::from_le_bytes(map[16..24].try_into().unwrap()) as usize;
+        let index_count = u32::from_le_bytes(map[24..28].try_into().unwrap()) as usize;
+        let index_start = CHECKPOINT_HEADER.checked_add(frame_len)
+            .ok_or(CheckpointError::Corrupt("bad length"))?;
+        if map.len() != index_start + index_count * INDEX_ENTRY {
+            return Err(CheckpointError::Corrupt("bad length"));
+        }
+
+        let frame = &map[CHECKPOINT_HEADER..index_start];
+        if frame.len() < SNAPSHOT_HEADER
+            || frame[0] != msg::SNAPSHOT
+            || frame[1..9] != revision.to_le_bytes()
+        {
+            return Err(CheckpointError::Corrupt("bad frame header"));
+        }
+        let task_count = u32::from_le_bytes(frame[9..13].try_into().unwrap()) as usize;
+        let service_count = u32::from_le_bytes(frame[13..17].try_into().unwrap()) as usize;
+        if SNAPSHOT_HEADER + task_count * TASK_STRIDE + service_count * SERVICE_STRIDE != frame.len() {
+            return Err(CheckpointError::Corrupt("bad frame length"));
+        }
+
+        let mut previous: Option<&[u8]> = None;
+        for entry in map[index_start..].chunks_exact(INDEX_ENTRY) {
+            let (first, count) = index_run(entry);
+            if first + count > task_count || previous.map_or(false, |id| id >= &entry[0..16]) {
+                return Err(CheckpointError::Corrupt("bad index"));
+            }
+            previous = Some(&entry[0..16]);
+        }
+
+        Ok(Checkpoint { map, revision, frame_len, task_count, index_count })
+    }
+
+    pub fn revision(&self) -> u64 {
+        self.revision
+    }
+
+    fn frame(&self) -> &[u8] {
+        &self.map[CHECKPOINT_HEADER..CHECKPOINT_HEADER + self.frame_len]
+    }
+
+    fn service_records(&self) -> &[u8] {
+        &self.frame()[SNAPSHOT_HEADER + self.task_count * TASK_STRIDE..]
+    }
+
+    /// The packed task records of one service (binary search on the index).
+    fn service_tasks(&self, service_id: &Uuid) -> &[u8] {
+        let index_start = CHECKPOINT_HEADER + self.frame_len;
+        let index = &self.map[index_start..index_start + self.index_count * INDEX_ENTRY];
+        let (mut lo, mut hi) = (0, self.index_count);
+        while lo < hi {
+            let mid = (lo + hi) / 2;
+            let entry = &index[mid * INDEX_ENTRY..(mid + 1) * INDEX_ENTRY];
+            match entry[0..16].cmp(service_id.as_bytes().as_slice()) {
+                std::cmp::Ordering::Less => lo = mid + 1,
+                std::cmp::Ordering::Greater => hi = mid,
+                std::cmp::Ordering::Equal => {
+                    let (first, count) = index_run(entry);
+                    let start = SNAPSHOT_HEADER + first * TASK_STRIDE;
+                    return &self.frame()[start..start + count * TASK_STRIDE];
+                }
+            }
+        }
+        &[]
+    }
+
+    /// Snapshot frame for a client, optionally limited to `services`, plus
+    /// the scope that filters its events from then on. Same frames as
+    /// game.rs sends from the World at this revision (task order may differ).
+    pub fn snapshot(&self, compact: bool, services: Option<HashSet<Uuid>>) -> (Vec<u8>, Option<EventScope>) {
+        let (frame, scope) = match services {
+            None if compact => return (wire::compact_snapshot(self.frame()), None),
+            None => return (self.frame().to_vec(), None),
+            Some(services) => {
+                let runs: Vec<&[u8]> = services.iter().map(|id| self.service_tasks(id)).collect();
+                let (scope, frame) = EventScope::scope_packed(services, self.revision, &runs, self.service_records());
+                (frame, scope)
+            }
+        };
+        let frame = if compact { wire::compact_snapshot(&frame) } else { frame };
+        (frame, Some(scope))
+    }
+}
+
+fn index_run(entry: &[u8]) -> (usize, usize) {
+    let first = u32::from_le_bytes(entry[16..20].try_into().unwrap()) as usize;
+    let count = u32::from_le_bytes(entry[20..24].try_into().unwrap()) as usize;
+    (first, count)
+}
+
+/// Encode `world` as a checkpoint file.
+pub fn encode(world: &World) -> Vec<u8> {
+    let (frame, groups) = wire::pack_grouped_snapshot(world);
+    let mut buf = Vec::with_capacity(CHECKPOINT_HEADER + frame.len() + groups.len() * INDEX_ENTRY);
+    buf.extend_from_slice(CHECKPOINT_MAGIC);
+    buf.extend_from_slice(&world.revision.to_le_bytes());
+    buf.extend_from_slice(&(frame.len() as u64).to_le_bytes());
+    buf.extend_from_slice(&(groups.len() as u32).to_le_bytes());
+    buf.extend_from_slice(&[0; 4]);
+    buf.extend_from_slice(&frame);
+    for (service_id, first, count) in groups {
+        buf.extend_from_slice(service_id.as_bytes());
+        buf.extend_from_slice(&first.to_le_bytes());
+        buf.extend_from_slice(&count.to_le_bytes());
+    }
+    buf
+}
+
+/// Write a checkpoint of `world` to `path`: temp file, fsync, rename. A
+/// mapping of the file it replaces stays valid.
+pub fn write(path: &str, world: &World) -> std::io::Result<()> {
+    let tmp = format!("{path}.tmp");
+    let mut file = File::create(&tmp)?;
+    file.write_all(&encode(world))?;
+    file.sync_all()?;
+    std::fs::rename(&tmp, path)
+}
+
+/// Spawn the task that keeps the checkpoint at `path` current: once the
+/// World is loaded (immediately, unless `fresh` — the boot checkpoint is
+/// already at the loaded revision), then whenever `durable` has stayed at a
+/// new revision for CHECKPOINT_QUIET and the published World is at it too.
+pub fn spawn_writer(path: String, store: Arc<WorldStore>, mut durable: watch::Receiver<u64>, fresh: bool) {
+    tokio::spawn(async move {
+        let world = store.loaded().await;
+        let mut written = fresh.then_some(world.revision);
+        loop {
+            let world = store.load();
+            if written != Some(world.revision) && world.revision == *durable.borrow_and_update() {
+                let path = path.clone();
+                let revision = world.revision;
+                let result = tokio::task::spawn_blocking(move || write(&path, &world))
+                    .await
+                    .expect("checkpoint writer panicked");
+                match result {
+                    Ok(()) => written = Some(revision),
+                    Err(e) => eprintln!("[checkpoint] write at revision {revision} failed: {e}"),
+                }
+            }
+
+            if durable.changed().await.is_err() {
+                return; // journal is gone
+            }
+            // Wait for the journal to go quiet.
+            loop {
+                match tokio::time::timeout(CHECKPOINT_QUIET, durable.changed()).await {
+                    Ok(Ok(())) => continue,
+                    Ok(Err(_)) => return,
+                    Err(_) => break,
+                }
+            }
+        }
+    });
+}
+
+// ── Errors ─────────────────────────────────────────────────────
+
+#[derive(Debug)]
+pub enum CheckpointError {
+    Io(std::io::Error),
+    Corrupt(&'static str),
+    /// The save file has moved on (or back) since the checkpoint was written.
+    Stale { checkpoint: u64, save_file: u64 },
+}
+
+impl From<std::io::Error> for CheckpointError {
+    fn from(e: std::io::Error) -> Self {
+        CheckpointError::Io(e)
+    }
+}
+
+impl std::fmt::Display for CheckpointError {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        match self {
+            CheckpointError::Io(e) => write!(f, "io: {e}"),
+            CheckpointError::Corrupt(what) => write!(f, "corrupt: {what}"),
+            CheckpointError::Stale { checkpoint, save_file } => {
+                write!(f, "stale: checkpoint at revision {checkpoint}, save file at {save_file}")
+            }
+        }
+    }
+}
+
+// ── Tests ──────────────────────────────────────────────────────
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::world::{Priority, Service, Task, TaskStatus};
+
+    fn world() -> World {
+        let mut world = World::new();
+        for (n, name) in [(1u8, "Billing"), (2, "Search"), (3, "Empty")] {
+            let id = Uuid::from_bytes([n; 16]);
+            world.services.insert(id, Service { id, name: name.into() });
+        }
+        for n in 0..6u8 {
+            world.insert_task(Task {
+                id: Uuid::from_bytes([0x10 + n; 16]),
+                title: format!("task {n}"),
+                status: TaskStatus::Staged,
+                priority: Priority::Low,
+                service_id: Uuid::from_bytes([1 + n % 2; 16]),
+                created_by: Uuid::nil(),
+                assigned_to: None,
+                date: None,
+                start_time: None,
+                duration: None,
+            });
+        }
+        world.revision = 17;
+        world
+    }
+
+    fn temp_path(name: &str) -> String {
+        format!("/tmp/txxt_test_checkpoint_{name}_{}.bin", std::process::id())
+    }
+
+    #[test]
+    fn serves_the_snapshot_a_world_would() {
+        let path = temp_path("serve");
+        let world = world();
+        write(&path, &world).unwrap();
+        let checkpoint = Checkpoint::open(&path, 17).unwrap();
+
+        let (full, scope) = checkpoint.snapshot(false, None);
+        assert!(scope.is_none());
+        assert_eq!(full.len(), wire::pack_snapshot(&world).len());
+        assert_eq!(&full[..SNAPSHOT_HEADER], &wire::pack_snapshot(&world)[..SNAPSHOT_HEADER]);
+
+        let billing: HashSet<Uuid> = [Uuid::from_bytes([1; 16]), Uuid::from_bytes([3; 16])].into();
+        let (scoped, scope) = checkpoint.snapshot(false, Some(billing.clone()));
+        let (_, expected) = EventScope::scope_snapshot(billing, &world);
+        assert_eq!(scoped.len(), expected.len());
+        assert_eq!(&scoped[..SNAPSHOT_HEADER], &expected[..SNAPSHOT_HEADER]);
+        let mut scope = scope.unwrap();
+        let completed = |n: u8| wire::pack_event(&crate::world::Event::TaskCompleted {
+            revision: 18,
+            task_id: Uuid::from_bytes([0x10 + n; 16]),
+        });
+        assert!(scope.admits(&completed(0)) && !scope.admits(&completed(1)));
+
+        let (compact, _) = checkpoint.snapshot(true, None);
+        assert_eq!(compact[0], msg::SNAPSHOT_COMPACT);
+
+        let _ = std::fs::remove_file(&path);
+    }
+
+    #[test]
+    fn rejects_stale_and_corrupt_files() {
+        let path = temp_path("reject");
+        write(&path, &world()).unwrap();
+        assert!(matches!(
+            Checkpoint::open(&path, 18),
+            Err(CheckpointError::Stale { checkpoint: 17, save_file: 18 })
+        ));
+
+        let mut bytes = std::fs::read(&path).unwrap();
+        bytes.pop();
+        std::fs::write(&path, &bytes).unwrap();
+        assert!(matches!(Checkpoint::open(&path, 17), Err(CheckpointError::Corrupt(_))));
+
+        assert!(matches!(Checkpoint::open(&temp_path("missing"), 17), Err(CheckpointError::Io(_))));
+        let _ = std::fs::remove_file(&path);
+    }
+}
@@ -3,60 +3,188 @@
 //! Binary protocol over WebSocket using fixed-stride packed records.
 //! See wire.rs for the byte layout — readable by JS DataView at known offsets.
 //!
-//! - Client sends: packed binary commands (wire::unpack_command)
-//! - Server sends: packed binary snapshots + events (wire::pack_*)
+//! - Client sends: packed binary commands (wire::unpack_command), or many
+//!   at once in a command batch (wire::COMMAND_BATCH_HEADER, bulk import)
+//! - Server sends: packed binary snapshots + events (wire::pack_*), with
+//!   queued events coalesced into batch frames (wire::pack_batch)
+//!
+//! Clients connecting with `?snapshot=compact` receive the string-table
+//! snapshot (wire::COMPACT_SNAPSHOT_HEADER) instead of the fixed-stride one.
+//! Every connection is first greeted with the server epoch and the revision
+//! its hydration frames reach (wire::HELLO_LEN): events up to that revision
+//! are replayed history, later ones happen live.
+//! Clients reconnecting with `?since=<revision>&epoch=<epoch>` are replayed
+//! the events they missed instead, when the event log still holds them and
+//! the epoch is still this server run's.
+//!
+//! Clients connecting with `?services=<id>,<id>` (or sending an interest
+//! command, wire::INTEREST_HEADER) only get tasks and events for those
+//! services; changing the interest set re-sends a snapshot at the new scope.
+//!
+//! Clients connecting while the World is still loading (cold start) are
+//! hydrated from the boot checkpoint (checkpoint.rs) when there is one.
 
 use crate::auth::SharedState;
-use crate::wire;
+use crate::store::Submission;
+use crate::wire::{self, EventScope};
+use crate::world::World;
 use axum::{
     extract::{
         ws::{Message, WebSocket, WebSocketUpgrade},
-        State,
+        Query, State,
     },
     response::IntoResponse,
 };
 use futures_util::{SinkExt, StreamExt};
+use serde::Deserialize;
+use std::collections::HashSet;
+use std::sync::Arc;
+use tokio::sync::broadcast::error::TryRecvError;
+use tokio::sync::watch;
 use uuid::Uuid;
 
 // ── WS upgrade handler ────────────────────────────────────────
 
+#[derive(Debug, Deserialize)]
+pub struct WsParams {
+    /// "compact" selects the string-table snapshot encoding.
+    pub snapshot: Option<String>,
+    /// Revision the client already has (reconnect).
+    pub since: Option<u64>,
+    /// Epoch `since` was issued under (the HELLO of the earlier connection).
+    pub epoch: Option<u64>,
+    /// Comma-separated service ids the client views (absent = all).
+    pub services: Option<String>,
+}
+
+/// Services a client receives tasks and events for (None = every service).
+type Interest = Option<HashSet<Uuid>>;
+
 pub async fn ws_handler(
     ws: WebSocketUpgrade,
+    Query(params): Query<WsParams>,
     State(state): State<SharedState>,
 ) -> impl IntoResponse {
-    ws.on_upgrade(move |socket| handle_socket(socket, state))
+    let compact = params.snapshot.as_deref() == Some("compact");
+    let interest: Interest = params.services.as_deref().map(|list| {
+        list.split(',').filter_map(|id| Uuid::parse_str(id.trim()).ok()).collect()
+    });
+    // A revision from another server run may name different history: the
+    // server may have crashed and reissued it. Hydrate from scratch then.
+    let since = params.since.filter(|_| params.epoch == Some(state.epoch));
+    ws.on_upgrade(move |socket| handle_socket(socket, state, compact, since, interest))
 }
 
 // ── Socket lifecycle ───────────────────────────────────────────
 
-async fn handle_socket(socket: WebSocket, state: SharedState) {
+async fn handle_socket(
+    socket: WebSocket,
+    state: SharedState,
+    compact: bool,
+    since: Option<u64>,
+    interest: Interest,
+) {
     let (mut ws_tx, mut ws_rx) = socket.split();
 
     // Step 1: Subscribe to broadcast BEFORE reading snapshot.
     // This ensures we don't miss events between snapshot and subscription.
     let mut broadcast_rx = state.game_tx.subscribe();
 
-    // Step 2: Read-lock World, pack binary snapshot, send to this client.
-    let snapshot_bytes = {
-        let world = state.world.read().unwrap();
-        wire::pack_snapshot(&world)
+    // Step 2: Hydrate. While the World is still loading, a boot checkpoint
+    // holds exactly the revision it will load at: send that straight from
+    // the mapped file, then wait for the World.
+    let early = match &state.checkpoint {
+        Some(checkpoint) if !state.world.is_loaded() => {
+            let (frame, scope) = checkpoint.snapshot(compact, interest.clone());
+            let hello = wire::pack_hello(state.epoch, checkpoint.revision());
+            if ws_tx.send(Message::Binary(hello)).await.is_err()
+                || ws_tx.send(Message::Binary(frame)).await.is_err()
+            {
+                return; // client already gone
+            }
+            Some((checkpoint.revision(), scope))
+        }
+        _ => None,
     };
 
-    if ws_tx.send(Message::Binary(snapshot_bytes.into())).await.is_err() {
-        return; // client already gone
-    }
+    // Otherwise load the published World. A reconnecting client whose
+    // revision is still in the event log gets just the events it missed
+    // (O(changes)); anyone else gets a snapshot at its interest scope. Never
+    // waits on the apply loop.
+    let world = state.world.loaded().await;
+    let (frames, mut synced_revision, mut scope) = match early {
+        Some((revision, scope)) => (Vec::new(), revision, scope),
+        None => {
+            let (mut frames, revision, scope) = hydrate(&state, &world, compact, since, interest.clone());
+            frames.insert(0, wire::pack_hello(state.epoch, revision));
+            (frames, revision, scope)
+        }
+    };
 
     // Dev mode: use first user in World, or Uuid::nil if none.
-    let user_id = {
-        let world = state.world.read().unwrap();
-        world.users.keys().next().copied().unwrap_or(Uuid::nil())
-    };
+    let user_id = world.users.keys().next().copied().unwrap_or(Uuid::nil());
+    drop(world);
+
+    for frame in frames {
+        if ws_tx.send(Message::Binary(frame)).await.is_err() {
+            return; // client already gone
+        }
+    }
 
     // Step 3: Spawn broadcast forwarder (sends events to this client).
-    let mut send_task = tokio::spawn(async move {
-        while let Ok(bytes) = broadcast_rx.recv().await {
-            if ws_tx.send(Message::Binary(bytes.into())).await.is_err() {
-                break;
+    // Broadcast batch frames are split back into events; events already
+    // queued when it wakes are coalesced into batch frames of at most
+    // BATCH_MAX_EVENTS, so a burst costs this client one send per batch.
+    // Events the client already has (broadcast between subscribing and
+    // loading the World) or that fall outside its interest are skipped.
+    // A new interest set re-hydrates the client at the new scope.
+    let (interest_tx, mut interest_rx) = watch::channel(interest);
+    let mut send_task = tokio::spawn({
+        let state = state.clone();
+        async move {
+            loop {
+                let first = tokio::select! {
+                    changed = interest_rx.changed() => {
+                        if changed.is_err() {
+                            return; // command side finished
+                        }
+                        let interest = interest_rx.borrow_and_update().clone();
+                        let (frame, revision, new_scope) =
+                            snapshot_for(&state, &state.world.load(), compact, interest);
+                        synced_revision = revision;
+                        scope = new_scope;
+                        if ws_tx.send(Message::Binary(frame)).await.is_err() {
+                            return;
+                        }
+                        continue;
+                    }
+                    received = broadcast_rx.recv() => match received {
+                        Ok(bytes) => bytes,
+                        Err(_) => return, // lagged or closed
+                    },
+                };
+
+                let mut batch = wire::split_batch(&first);
+                while batch.len() < wire::BATCH_MAX_EVENTS {
+                    match broadcast_rx.try_recv() {
+                        Ok(bytes) => batch.extend(wire::split_batch(&bytes)),
+                        Err(TryRecvError::Empty) => break,
+                        Err(_) => return, // lagged or closed, as when recv() fails
+                    }
+                }
+                batch.retain(|bytes| {
+                    wire::event_revision(bytes).map_or(true, |rev| rev > synced_revision)
+                        && scope.as_mut().map_or(true, |s| s.admits(bytes))
+                });
+                if batch.is_empty() {
+                    continue;
+                }
+
+                for frame in wire::pack_replay(batch) {
+                    if ws_tx.send(Message::Binary(frame)).await.is_err() {
+                        return;
+                    }
+                }
             }
         }
     });
@@ -67,8 +195,18 @@ async fn handle_socket(socket: WebSocket, state: SharedState) {
         async move {
             while let Some(Ok(msg)) = ws_rx.next().await {
                 match msg {
+                    Message::Binary(data) if data.first() == Some(&wire::msg::CMD_SET_INTEREST) => {
+                        match wire::unpack_interest(&data) {
+                            Ok(interest) => {
+                                interest_tx.send_replace(interest);
+                            }
+                            Err(e) => eprintln!("bad interest from client: {e}"),
+                        }
+                    }
                     Message::Binary(data) => {
-                        handle_command(&state, &data, user_id);
+                        if !handle_command(&state, &data, user_id).await {
+                            break; // apply loop is gone
+                        }
                     }
                     Message::Close(_) => break,
                     _ => {} // ignore text, ping, pong
@@ -84,39 +222,77 @@ async fn handle_socket(socket: WebSocket, state: SharedState) {
     }
 }
 
+/// Frames that bring a client from `since` (if given) up to `world` or later:
+/// the missed events if the log still holds them, else a snapshot. Returns
+/// the frames, the revision they reach and the client's event scope.
+fn hydrate(
+    state: &SharedState,
+    world: &World,
+    compact: bool,
+    since: Option<u64>,
+    interest: Interest,
+) -> (Vec<Vec<u8>>, u64, Option<EventScope>) {
+    match since.and_then(|rev| world.events_since(rev)) {
+        Some(missed) => {
+            let mut scope = interest.map(|services| EventScope::from_world(services, world));
+            let frames = wire::pack_replay(
+                missed.iter()
+                    .map(|(_, event)| Arc::<[u8]>::from(wire::pack_event(event)))
+                    .filter(|bytes| scope.as_mut().map_or(true, |s| s.admits(bytes))),
+            );
+            (frames, world.revision, scope)
+        }
+        None => {
+            let (frame, revision, scope) = snapshot_for(state, world, compact, interest);
+            (vec![frame], revision, scope)
+        }
+    }
+}
+
+/// Snapshot frame for `world` (or, unscoped, the newer revision the shared
+/// cache is at), limited to `interest`. Returns the frame, its revision and
+/// the scope that filters this client's events from then on.
+fn snapshot_for(
+    state: &SharedState,
+    world: &World,
+    compact: bool,
+    interest: Interest,
+) -> (Vec<u8>, u64, Option<EventScope>) {
+    let (frame, scope) = match interest {
+        None if compact => (state.snapshot.lock().unwrap().compact_frame(world).to_vec(), None),
+        None => (state.snapshot.lock().unwrap().frame(world).to_vec(), None),
+        Some(services) => {
+            // Packed straight from the World's per-service index.
+            let (scope, scoped) = EventScope::scope_snapshot(services, world);
+            let frame = if compact { wire::compact_snapshot(&scoped) } else { scoped };
+            (frame, Some(scope))
+        }
+    };
+    // The cache may be ahead of `world`; the header says where.
+    let revision = u64::from_le_bytes(frame[1..9].try_into().unwrap());
+    (frame, revision, scope)
+}
+
 // ── Command processing ─────────────────────────────────────────
 
-/// Unpack a binary command, apply it to the World, flush to disk, broadcast the event.
-/// All synchronous under the write lock — microseconds at this scale.
-fn handle_command(state: &SharedState, data: &[u8], user_id: Uuid) {
+/// Unpack a binary command (or command batch) and queue it for the apply loop
+/// (store.rs), which applies, journals, publishes and broadcasts. Waits only
+/// when the queue is full. Returns false once the apply loop has stopped.
+async fn handle_command(state: &SharedState, data: &[u8], user_id: Uuid) -> bool {
     // Deserialize
-    let cmd = match wire::unpack_command(data) {
-        Ok(cmd) => cmd,
+    let cmds = if data.first() == Some(&wire::msg::CMD_BATCH) {
+        wire::unpack_command_batch(data)
+    } else {
+        wire::unpack_command(data).map(|cmd| vec![cmd])
+    };
+    let cmds = match cmds {
+        Ok(cmds) => cmds,
         Err(e) => {
             eprintln!("bad command from client: {e}");
-            return;
-        }
-    };
-
-    // Apply (write-lock World)
-    let event = {
-        let mut world = state.world.write().unwrap();
-        match world.apply(cmd, user_id) {
-            Ok(event) => {
-                // Flush to save file (sync, fast)
-                if let Err(e) = state.save_file.flush(&world, &event) {
-                    eprintln!("save file flush failed: {e}");
-                }
-                event
-            }
-            Err(e) => {
-                eprintln!("command rejected: {e:?}");
-                return;
-            }
+            return true;
         }
     };
 
-    // Broadcast packed binary event to all connected clients.
-    let bytes = wire::pack_event(&event);
-    let _ = state.game_tx.send(bytes);
+    // One submission: a batch is queued and applied as a unit.
+    state.commands.send(Submission { cmds, user_id }).await.is_ok()
 }
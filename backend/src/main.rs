@@ -1,10 +1,13 @@
 mod auth;
+mod checkpoint;
 mod game;
 mod persist;
+mod store;
 mod wire;
 mod world;
 
 use auth::{AppState, SharedState};
+use checkpoint::Checkpoint;
 use axum::{
     routing::{get, post},
     Router,
@@ -16,45 +19,84 @@ use tower_http::{
     cors::{Any, CorsLayer},
     services::ServeDir,
 };
+use world::LogRetention;
 
 #[tokio::main]
 async fn main() {
+    // ── Config (env overrides for benches and side-by-side runs) ───
+    let save_path = std::env::var("TXXT_SAVE_FILE").unwrap_or_else(|_| "tasks.redb".into());
+    let addr: SocketAddr = std::env::var("TXXT_ADDR")
+        .ok()
+        .and_then(|a| a.parse().ok())
+        .unwrap_or(SocketAddr::from(([0, 0, 0, 0], 3000)));
+    // Optional: memory-mapped snapshot checkpoint for fast cold starts.
+    let checkpoint_path = std::env::var("TXXT_CHECKPOINT_FILE").ok();
+
     // ── Boot the World ─────────────────────────────────────────
-    let save_file = persist::SaveFile::open("tasks.redb")
+    // Only the revision is read up front; the World loads in the background
+    // while the server already accepts connections.
+    let save_file = persist::SaveFile::open(&save_path)
         .expect("Failed to open save file");
+    let revision = save_file.revision()
+        .expect("Failed to read save file revision");
 
-    let mut world = save_file.load_world()
-        .expect("Failed to load world from save file");
+    let checkpoint = checkpoint_path.as_deref().and_then(|path| {
+        match Checkpoint::open(path, revision) {
+            Ok(checkpoint) => {
+                println!("Checkpoint mapped: {path} at revision {revision}");
+                Some(checkpoint)
+            }
+            Err(e) => {
+                eprintln!("[checkpoint] not using {path}: {e}");
+                None
+            }
+        }
+    });
 
-    // Seed defaults if empty
-    let svc_count = save_file.ensure_default_services(&mut world)
-        .expect("Failed to seed services");
-    if svc_count > 0 {
-        println!("Seeded {svc_count} default services");
-    }
+    let loader = save_file.clone();
+    let world = async move {
+        tokio::task::spawn_blocking(move || load_world(&loader))
+            .await
+            .expect("World loader panicked")
+    };
 
-    if save_file.ensure_default_user(&mut world)
-        .expect("Failed to seed user")
-    {
-        println!("Created default admin user (admin / admin)");
-    }
+    // ── Broadcast channel ──────────────────────────────────────
+    let (game_tx, _) = broadcast::channel::<Arc<[u8]>>(256);
 
-    println!(
-        "World loaded: {} tasks, {} users, {} services, revision {}",
-        world.tasks.len(),
-        world.users.len(),
-        world.services.len(),
-        world.revision,
+    // ── Write-behind journal ───────────────────────────────────
+    let journal = persist::Journal::spawn(
+        save_file,
+        revision,
+        persist::GROUP_COMMIT_DELAY,
+        persist::GROUP_COMMIT_MAX_ENTRIES,
     );
 
-    // ── Broadcast channel ──────────────────────────────────────
-    let (game_tx, _) = broadcast::channel::<Vec<u8>>(256);
+    // Acknowledge each group commit to every client.
+    let checkpoint_durable = journal.durable();
+    let mut durable = journal.durable();
+    let ack_tx = game_tx.clone();
+    tokio::spawn(async move {
+        while durable.changed().await.is_ok() {
+            let revision = *durable.borrow_and_update();
+            let _ = ack_tx.send(wire::pack_durable(revision).into());
+        }
+    });
+
+    // ── Apply loop (the World's single writer) ─────────────────
+    let (world, commands) = store::spawn_loading(world, journal, LogRetention::default(), game_tx.clone());
+
+    if let Some(path) = checkpoint_path {
+        checkpoint::spawn_writer(path, world.clone(), checkpoint_durable, checkpoint.is_some());
+    }
 
     // ── Shared state ───────────────────────────────────────────
     let state: SharedState = Arc::new(AppState {
-        world: std::sync::RwLock::new(world),
-        save_file,
+        world,
+        commands,
+        snapshot: std::sync::Mutex::new(wire::SnapshotCache::new()),
+        checkpoint,
         game_tx,
+        epoch: uuid::Uuid::new_v4().as_u64_pair().0,
     });
 
     // ── Resolve IRONCLAD path relative to Cargo.toml ────────────
@@ -80,11 +122,38 @@ async fn main() {
         );
 
     // ── Start ──────────────────────────────────────────────────
-    let addr = SocketAddr::from(([0, 0, 0, 0], 3000));
-    println!("Server running on http://localhost:3000");
-    println!("  Game WS: ws://localhost:3000/api/game");
-    println!("  Login:   POST http://localhost:3000/api/auth/login");
+    println!("Server running on http://{addr}");
+    println!("  Game WS: ws://{addr}/api/game");
+    println!("  Login:   POST http://{addr}/api/auth/login");
 
     let listener = tokio::net::TcpListener::bind(addr).await.unwrap();
     axum::serve(listener, app).await.unwrap();
 }
+
+/// Load the World from the save file and seed defaults if empty.
+fn load_world(save_file: &persist::SaveFile) -> world::World {
+    let mut world = save_file.load_world()
+        .expect("Failed to load world from save file");
+
+    // Seed defaults if empty
+    let svc_count = save_file.ensure_default_services(&mut world)
+        .expect("Failed to seed services");
+    if svc_count > 0 {
+        println!("Seeded {svc_count} default services");
+    }
+
+    if save_file.ensure_default_user(&mut world)
+        .expect("Failed to seed user")
+    {
+        println!("Created default admin user (admin / admin)");
+    }
+
+    println!(
+        "World loaded: {} tasks, {} users, {} services, revision {}",
+        world.tasks.len(),
+        world.users.len(),
+        world.services.len(),
+        world.revision,
+    );
+    world
+}
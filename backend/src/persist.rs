@@ -1,11 +1,18 @@
 //! World ↔ redb persistence.
 //!
-//! redb is a save file: loaded on boot, flushed on every mutation.
+//! redb is a save file: loaded on boot, written behind every mutation.
 //! Never queried at runtime — World is the runtime truth.
+//!
+//! Mutations don't touch disk on the apply path: the apply loop (store.rs)
+//! appends a JournalEntry (the entity state after the event) to the Journal,
+//! and a dedicated task commits queued entries in group transactions, then
+//! publishes the highest durable revision.
 
 use crate::world::{Event, Service, Task, User, World};
 use redb::{Database, ReadableTable, TableDefinition};
 use std::sync::Arc;
+use std::time::Duration;
+use tokio::sync::{mpsc, watch};
 use uuid::Uuid;
 
 // New tables — separate from the old db.rs tables so both coexist during transition.
@@ -50,7 +57,7 @@ impl SaveFile {
         for entry in tasks_table.iter()? {
             let (_, value) = entry?;
             match postcard::from_bytes::<Task>(value.value()) {
-                Ok(task) => { world.tasks.insert(task.id, task); }
+                Ok(task) => world.insert_task(task),
                 Err(e) => {
                     eprintln!("[persist] skipping undecodable task record (format migration?): {e}");
                 }
@@ -63,7 +70,7 @@ impl SaveFile {
             let (_, value) = entry?;
             let user: User = postcard::from_bytes(value.value())
                 .map_err(|e| SaveFileError::Decode(e.to_string()))?;
-            world.users.insert(user.id, user);
+            world.insert_user(user);
         }
 
         // Load services
@@ -83,43 +90,55 @@ impl SaveFile {
                 world.revision = u64::from_le_bytes(bytes.try_into().unwrap());
             }
         }
+        // Everything loaded is, by definition, on disk.
+        world.checkpoint = world.revision;
 
         Ok(world)
     }
 
-    /// Flush a single event to disk. Called after every World::apply().
-    /// Writes the affected entity + updated revision in one transaction.
+    /// The revision the save file holds, without loading anything else.
+    pub fn revision(&self) -> Result<u64, SaveFileError> {
+        let txn = self.db.begin_read()?;
+        let meta_table = txn.open_table(WORLD_META)?;
+        Ok(match meta_table.get("revision")? {
+            Some(rev_data) if rev_data.value().len() == 8 => {
+                u64::from_le_bytes(rev_data.value().try_into().unwrap())
+            }
+            _ => 0,
+        })
+    }
+
+    /// Flush a single event to disk synchronously (a group of one).
     pub fn flush(&self, world: &World, event: &Event) -> Result<(), SaveFileError> {
+        self.commit_group(&[JournalEntry::capture(world, event)])
+    }
+
+    /// Write journaled entries, in order, plus the last entry's revision in
+    /// one transaction (one fsync for the whole group).
+    pub fn commit_group(&self, entries: &[JournalEntry]) -> Result<(), SaveFileError> {
+        let Some(last) = entries.last() else {
+            return Ok(());
+        };
+
         let txn = self.db.begin_write()?;
         {
             let mut tasks = txn.open_table(WORLD_TASKS)?;
             let mut meta = txn.open_table(WORLD_META)?;
 
-            match event {
-                Event::TaskCreated { task, .. } => {
-                    let bytes = postcard::to_allocvec(task)
-                        .map_err(|e| SaveFileError::Encode(e.to_string()))?;
-                    tasks.insert(task.id.as_bytes().as_slice(), bytes.as_slice())?;
-                }
-
-                Event::TaskScheduled { task_id, .. }
-                | Event::TaskMoved { task_id, .. }
-                | Event::TaskUnscheduled { task_id, .. }
-                | Event::TaskCompleted { task_id, .. } => {
-                    // Look up the current state in World and write the whole entity
-                    let task = &world.tasks[task_id];
-                    let bytes = postcard::to_allocvec(task)
-                        .map_err(|e| SaveFileError::Encode(e.to_string()))?;
-                    tasks.insert(task_id.as_bytes().as_slice(), bytes.as_slice())?;
-                }
-
-                Event::TaskDeleted { task_id, .. } => {
-                    tasks.remove(task_id.as_bytes().as_slice())?;
+            for entry in entries {
+                match &entry.op {
+                    JournalOp::PutTask(task) => {
+                        let bytes = postcard::to_allocvec(task)
+                            .map_err(|e| SaveFileError::Encode(e.to_string()))?;
+                        tasks.insert(task.id.as_bytes().as_slice(), bytes.as_slice())?;
+                    }
+                    JournalOp::DeleteTask(task_id) => {
+                        tasks.remove(task_id.as_bytes().as_slice())?;
+                    }
                 }
             }
 
-            // Always update revision
-            meta.insert("revision", world.revision.to_le_bytes().as_slice())?;
+            meta.insert("revision", last.revision.to_le_bytes().as_slice())?;
         }
         txn.commit()?;
         Ok(())
@@ -208,11 +227,130 @@ impl SaveFile {
         };
 
         self.save_user(&user)?;
-        world.users.insert(user.id, user);
+        world.insert_user(user);
         Ok(true)
     }
 }
 
+// ── Write-behind journal ───────────────────────────────────────
+
+/// Most time an entry waits for more to share its group commit.
+pub const GROUP_COMMIT_DELAY: Duration = Duration::from_millis(5);
+/// Most entries per group commit.
+pub const GROUP_COMMIT_MAX_ENTRIES: usize = 256;
+
+/// What one event changed on disk, captured under the World lock.
+#[derive(Debug, Clone)]
+pub enum JournalOp {
+    /// Whole entity after the event (encoding happens on the commit task).
+    PutTask(Task),
+    DeleteTask(Uuid),
+}
+
+#[derive(Debug, Clone)]
+pub struct JournalEntry {
+    pub revision: u64,
+    pub op: JournalOp,
+}
+
+impl JournalEntry {
+    /// Capture the write for an event World::apply() just returned.
+    pub fn capture(world: &World, event: &Event) -> Self {
+        let op = match event {
+            Event::TaskCreated { task, .. } => JournalOp::PutTask(task.clone()),
+
+            Event::TaskScheduled { task_id, .. }
+            | Event::TaskMoved { task_id, .. }
+            | Event::TaskUnscheduled { task_id, .. }
+            | Event::TaskCompleted { task_id, .. } => {
+                // Look up the current state in World and write the whole entity
+                JournalOp::PutTask(world.tasks[task_id].clone())
+            }
+
+            Event::TaskDeleted { task_id, .. } => JournalOp::DeleteTask(*task_id),
+        };
+        JournalEntry { revision: event.revision(), op }
+    }
+}
+
+/// Handle to the group-commit task. Appending never blocks; `durable()`
+/// reports the highest revision known to be on disk.
+pub struct Journal {
+    tx: mpsc::UnboundedSender<JournalEntry>,
+    durable: watch::Receiver<u64>,
+}
+
+impl Journal {
+    /// Spawn the commit task. Entries are committed once `max_entries` are
+    /// queued or the oldest has waited `max_delay`, whichever comes first.
+    /// `durable_revision` is what is already on disk (the loaded revision).
+    pub fn spawn(
+        save_file: SaveFile,
+        durable_revision: u64,
+        max_delay: Duration,
+        max_entries: usize,
+    ) -> Self {
+        let (tx, mut rx) = mpsc::unbounded_channel::<JournalEntry>();
+        let (durable_tx, durable) = watch::channel(durable_revision);
+
+        tokio::spawn(async move {
+            let mut pending: Vec<JournalEntry> = Vec::new();
+            loop {
+                if pending.is_empty() {
+                    match rx.recv().await {
+                        Some(entry) => pending.push(entry),
+                        None => break, // every sender dropped, nothing left to write
+                    }
+                }
+
+                let deadline = tokio::time::Instant::now() + max_delay;
+                while pending.len() < max_entries {
+                    match tokio::time::timeout_at(deadline, rx.recv()).await {
+                        Ok(Some(entry)) => pending.push(entry),
+                        _ => break,
+                    }
+                }
+
+                // redb commits block on fsync; keep them off the async workers.
+                let batch = std::mem::take(&mut pending);
+                let save_file = save_file.clone();
+                let (batch, result) = tokio::task::spawn_blocking(move || {
+                    let result = save_file.commit_group(&batch);
+                    (batch, result)
+                })
+                .await
+                .expect("journal commit task panicked");
+
+                match result {
+                    Ok(()) => {
+                        durable_tx.send_replace(batch[batch.len() - 1].revision);
+                    }
+                    Err(e) => {
+                        // Keep the entries (in order) and retry with whatever arrives next.
+                        eprintln!("journal group commit of {} entries failed, retrying: {e}", batch.len());
+                        pending = batch;
+                        tokio::time::sleep(max_delay).await;
+                    }
+                }
+            }
+        });
+
+        Journal { tx, durable }
+    }
+
+    /// Queue an entry for the next group commit.
+    pub fn append(&self, entry: JournalEntry) {
+        if self.tx.send(entry).is_err() {
+            eprintln!("journal commit task is gone; entry dropped");
+        }
+    }
+
+    /// Watch the highest durable revision.
+    pub fn durable(&self) -> watch::Receiver<u64> {
+        self.durable.clone()
+    }
+}
+
 // ── Errors ─────────────────────────────────────────────────────
 
 #[derive(Debug)]
@@ -409,4 +547,89 @@ mod tests {
 
         cleanup(&path);
     }
+
+    #[test]
+    fn group_commit_applies_entries_in_order() {
+        let (sf, path) = temp_save("group");
+
+        let mut world = sf.load_world().unwrap();
+        sf.ensure_default_services(&mut world).unwrap();
+        let svc_id = *world.services.keys().next().unwrap();
+
+        let mut entries = Vec::new();
+        let mut ids = Vec::new();
+        for title in ["kept", "doomed"] {
+            let event = world.apply(
+                Command::CreateTask {
+                    title: title.into(),
+                    service_id: svc_id,
+                    priority: Priority::Low,
+                    assigned_to: None,
+                    date: None,
+                    start_time: None,
+                    duration: None,
+                },
+                Uuid::nil(),
+            ).unwrap();
+            entries.push(JournalEntry::capture(&world, &event));
+            if let Event::TaskCreated { task, .. } = &event {
+                ids.push(task.id);
+            }
+        }
+        let event = world.apply(
+            Command::ScheduleTask { task_id: ids[0], date: 20495, start_time: 600, duration: 30 },
+            Uuid::nil(),
+        ).unwrap();
+        entries.push(JournalEntry::capture(&world, &event));
+        let event = world.apply(Command::DeleteTask { task_id: ids[1] }, Uuid::nil()).unwrap();
+        entries.push(JournalEntry::capture(&world, &event));
+
+        sf.commit_group(&entries).unwrap();
+
+        let world2 = sf.load_world().unwrap();
+        assert_eq!(world2.revision, 4);
+        assert_eq!(world2.tasks.len(), 1);
+        assert_eq!(world2.tasks[&ids[0]].start_time, Some(600));
+
+        cleanup(&path);
+    }
+
+    #[tokio::test]
+    async fn journal_reports_durable_revision() {
+        let (sf, path) = temp_save("journal");
+
+        let mut world = sf.load_world().unwrap();
+        sf.ensure_default_services(&mut world).unwrap();
+        let svc_id = *world.services.keys().next().unwrap();
+
+        let journal = Journal::spawn(sf.clone(), world.revision, Duration::from_millis(20), 4);
+        let mut durable = journal.durable();
+        assert_eq!(*durable.borrow(), 0);
+
+        for i in 0..10 {
+            let event = world.apply(
+                Command::CreateTask {
+                    title: format!("task {i}"),
+                    service_id: svc_id,
+                    priority: Priority::Medium,
+                    assigned_to: None,
+                    date: None,
+                    start_time: None,
+                    duration: None,
+                },
+                Uuid::nil(),
+            ).unwrap();
+            journal.append(JournalEntry::capture(&world, &event));
+        }
+
+        while *durable.borrow_and_update() < 10 {
+            durable.changed().await.unwrap();
+        }
+
+        let world2 = sf.load_world().unwrap();
+        assert_eq!(world2.revision, 10);
+        assert_eq!(world2.tasks.len(), 10);
+
+        cleanup(&path);
+    }
 }
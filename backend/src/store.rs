@@ -0,0 +1,286 @@
+//! Single-writer World store.
+//!
+//! The World has exactly one writer: the apply loop, which owns a private
+//! copy and takes commands off a channel. After each drain of the channel it
+//! publishes the new version by swapping an `Arc<World>` — the collections are
+//! persistent, so a version costs a few reference counts rather than a copy.
+//!
+//! Readers (`WorldStore::load`) get the latest published version without a
+//! lock and may hold it as long as they like; snapshot packing and replay for
+//! hydrating clients never delay a command.
+//!
+//! The World may be handed over still loading (`spawn_loading`): until it
+//! arrives the store publishes an empty placeholder, `is_loaded()` is false
+//! and `loaded()` waits; commands queue up behind the load.
+//!
+//! Order per drain: apply + journal each command, checkpoint (at most every
+//! CHECKPOINT_INTERVAL: trim the event log behind the journal's durable
+//! revision), publish, then broadcast. A client that sees an event can always
+//! load a version at least that new.
+//!
+//! A submission may carry a whole command batch (an import): it is applied
+//! within one drain and its events go out as coalesced batch frames, so a
+//! large import takes a few broadcast slots rather than one per task and
+//! cannot lag subscribers off the channel.
+
+use crate::persist::{Journal, JournalEntry};
+use crate::wire;
+use crate::world::{Command, Event, LogRetention, World};
+use arc_swap::ArcSwap;
+use std::future::Future;
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+use tokio::sync::{broadcast, mpsc, watch};
+use uuid::Uuid;
+
+/// Commands queued ahead of the apply loop before submitters wait.
+pub const COMMAND_QUEUE_DEPTH: usize = 1024;
+
+/// Most commands applied per published version. The first submission of a
+/// drain is always taken whole, however many commands it carries.
+pub const APPLY_BATCH_MAX: usize = 256;
+
+/// Least time between event log checkpoints.
+pub const CHECKPOINT_INTERVAL: Duration = Duration::from_secs(1);
+
+/// Commands from a connected client, applied in order within one drain.
+pub struct Submission {
+    pub cmds: Vec<Command>,
+    pub user_id: Uuid,
+}
+
+impl Submission {
+    pub fn one(cmd: Command, user_id: Uuid) -> Self {
+        Submission { cmds: vec![cmd], user_id }
+    }
+}
+
+/// The published World. Cheap to load, never locked.
+pub struct WorldStore {
+    current: ArcSwap<World>,
+    loaded: watch::Receiver<bool>,
+}
+
+impl WorldStore {
+    /// The latest published version (an empty World until the World has
+    /// been loaded).
+    pub fn load(&self) -> Arc<World> {
+        self.current.load_full()
+    }
+
+    /// Whether the World has been loaded and published.
+    pub fn is_loaded(&self) -> bool {
+        *self.loaded.borrow()
+    }
+
+    /// The latest published version, once the World has been loaded.
+    pub async fn loaded(&self) -> Arc<World> {
+        let _ = self.loaded.clone().wait_for(|&loaded| loaded).await;
+        self.load()
+    }
+}
+
+/// Spawn the apply loop around `world`. Returns the store readers load from
+/// and the sender commands are submitted on; the loop ends when every sender
+/// is dropped. `retention` bounds the event log kept for reconnect replay.
+pub fn spawn(
+    world: World,
+    journal: Journal,
+    retention: LogRetention,
+    game_tx: broadcast::Sender<Arc<[u8]>>,
+) -> (Arc<WorldStore>, mpsc::Sender<Submission>) {
+    spawn_loading(std::future::ready(world), journal, retention, game_tx)
+}
+
+/// `spawn`, with the World still loading: it is published as soon as `load`
+/// finishes, and the apply loop starts then.
+pub fn spawn_loading(
+    load: impl Future<Output = World> + Send + 'static,
+    journal: Journal,
+    retention: LogRetention,
+    game_tx: broadcast::Sender<Arc<[u8]>>,
+) -> (Arc<WorldStore>, mpsc::Sender<Submission>) {
+    let (loaded_tx, loaded) = watch::channel(false);
+    let store = Arc::new(WorldStore {
+        current: ArcSwap::from_pointee(World::new()),
+        loaded,
+    });
+    let (tx, mut rx) = mpsc::channel::<Submission>(COMMAND_QUEUE_DEPTH);
+
+    tokio::spawn({
+        let store = store.clone();
+        async move {
+            let mut world = load.await;
+            store.current.store(Arc::new(world.clone()));
+            loaded_tx.send_replace(true);
+
+            let durable = journal.durable();
+            let mut last_checkpoint = Instant::now();
+            let mut batch = Vec::with_capacity(APPLY_BATCH_MAX);
+            while let Some(first) = rx.recv().await {
+                let mut queued = first.cmds.len();
+                batch.push(first);
+                while queued < APPLY_BATCH_MAX {
+                    match rx.try_recv() {
+                        Ok(submission) => {
+                            queued += submission.cmds.len();
+                            batch.push(submission);
+                        }
+                        Err(_) => break,
+                    }
+                }
+
+                let events = apply_batch(&mut world, &journal, batch.drain(..));
+                if events.is_empty() {
+                    continue; // everything rejected, nothing to publish
+                }
+
+                let now = Instant::now();
+                if now.duration_since(last_checkpoint) >= CHECKPOINT_INTERVAL {
+                    world.checkpoint(*durable.borrow(), &retention, now);
+                    last_checkpoint = now;
+                }
+
+                store.current.store(Arc::new(world.clone()));
+                for frame in wire::pack_broadcast(&events) {
+                    let _ = game_tx.send(frame);
+                }
+            }
+        }
+    });
+
+    (store, tx)
+}
+
+/// Apply submissions in order, journaling each accepted one.
+fn apply_batch(
+    world: &mut World,
+    journal: &Journal,
+    submissions: impl Iterator<Item = Submission>,
+) -> Vec<Event> {
+    let mut events = Vec::new();
+    for Submission { cmds, user_id } in submissions {
+        for cmd in cmds {
+            match world.apply(cmd, user_id) {
+                Ok(event) => {
+                    // Queue for the next group commit (entity clone + channel send)
+                    journal.append(JournalEntry::capture(world, &event));
+                    events.push(event);
+                }
+                Err(e) => eprintln!("command rejected: {e:?}"),
+            }
+        }
+    }
+    events
+}
+
+// ── Tests ──────────────────────────────────────────────────────
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::persist::{SaveFile, GROUP_COMMIT_DELAY, GROUP_COMMIT_MAX_ENTRIES};
+    use crate::world::{Priority, Service};
+
+    #[tokio::test]
+    async fn apply_loop_publishes_versions_and_broadcasts() {
+        let path = format!("/tmp/txxt_test_store_{}.redb", std::process::id());
+        let _ = std::fs::remove_file(&path);
+        let save_file = SaveFile::open(&path).unwrap();
+
+        let mut world = World::new();
+        let service = Service { id: Uuid::from_bytes([7; 16]), name: "Svc".into() };
+        world.services.insert(service.id, service.clone());
+
+        let journal = Journal::spawn(save_file, 0, GROUP_COMMIT_DELAY, GROUP_COMMIT_MAX_ENTRIES);
+        let (game_tx, mut game_rx) = broadcast::channel(16);
+        let (store, commands) = spawn(world, journal, LogRetention::default(), game_tx);
+
+        let before = store.loaded().await;
+        assert!(store.is_loaded());
+        let create = || Command::CreateTask {
+            title: "t".into(),
+            service_id: service.id,
+            priority: Priority::Low,
+            assigned_to: None,
+            date: None,
+            start_time: None,
+            duration: None,
+        };
+        commands.send(Submission::one(create(), Uuid::nil())).await.unwrap();
+        // Rejected: unknown task. Must not publish or broadcast anything.
+        let bad = Command::CompleteTask { task_id: Uuid::new_v4() };
+        commands.send(Submission::one(bad, Uuid::nil())).await.unwrap();
+        commands.send(Submission::one(create(), Uuid::nil())).await.unwrap();
+
+        let mut revision = 0u64;
+        while revision < 2 {
+            let frame = game_rx.recv().await.unwrap();
+            for event in wire::split_batch(&frame) {
+                revision += 1;
+                assert_eq!(event[0], wire::msg::TASK_CREATED);
+                assert_eq!(&event[1..9], &revision.to_le_bytes());
+            }
+            // Published before it was broadcast.
+            assert!(store.load().revision >= revision);
+        }
+
+        let after = store.load();
+        assert_eq!(after.revision, 2);
+        assert_eq!(after.tasks.len(), 2);
+        assert_eq!(after.events_since(0).unwrap().len(), 2);
+        // An old version stays exactly as it was loaded.
+        assert_eq!(before.revision, 0);
+        assert!(before.tasks.is_empty());
+
+        let _ = std::fs::remove_file(&path);
+    }
+
+    #[tokio::test]
+    async fn batch_larger_than_broadcast_capacity_does_not_lag() {
+        let path = format!("/tmp/txxt_test_store_batch_{}.redb", std::process::id());
+        let _ = std::fs::remove_file(&path);
+        let save_file = SaveFile::open(&path).unwrap();
+
+        let mut world = World::new();
+        let service = Service { id: Uuid::from_bytes([7; 16]), name: "Svc".into() };
+        world.services.insert(service.id, service.clone());
+
+        let journal = Journal::spawn(save_file, 0, GROUP_COMMIT_DELAY, GROUP_COMMIT_MAX_ENTRIES);
+        // Far smaller than the batch: one frame per event would lag.
+        let (game_tx, mut game_rx) = broadcast::channel(16);
+        let (store, commands) = spawn(world, journal, LogRetention::default(), game_tx);
+        store.loaded().await;
+
+        const ROWS: usize = 300;
+        let cmds = (0..ROWS)
+            .map(|i| Command::CreateTask {
+                title: format!("row {i}"),
+                service_id: service.id,
+                priority: Priority::Low,
+                assigned_to: None,
+                date: None,
+                start_time: None,
+                duration: None,
+            })
+            .collect();
+        commands.send(Submission { cmds, user_id: Uuid::nil() }).await.unwrap();
+
+        let mut revision = 0u64;
+        while revision < ROWS as u64 {
+            let frame = game_rx.recv().await.expect("subscriber lagged");
+            for event in wire::split_batch(&frame) {
+                revision += 1;
+                assert_eq!(event[0], wire::msg::TASK_CREATED);
+                assert_eq!(&event[1..9], &revision.to_le_bytes());
+            }
+        }
+
+        // Applied and published as one version.
+        let after = store.load();
+        assert_eq!(after.revision, ROWS as u64);
+        assert_eq!(after.tasks.len(), ROWS);
+
+        let _ = std::fs::remove_file(&path);
+    }
+}
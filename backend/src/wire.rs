@@ -7,7 +7,9 @@
 //! JSON is never used in the data path. Postcard is only used for
 //! redb persistence (persist.rs), not for the wire.
 
-use crate::world::{Command, Event, Priority, Task, Service, World};
+use crate::world::{Command, Event, Priority, Task, Service, TaskStatus, World};
+use std::collections::{HashMap, HashSet};
+use std::sync::Arc;
 use uuid::Uuid;
 
 // ── Layout constants ───────────────────────────────────────────
@@ -24,6 +26,10 @@ pub mod msg {
     pub const TASK_UNSCHEDULED: u8 = 0x05;
     pub const TASK_COMPLETED: u8  = 0x06;
     pub const TASK_DELETED: u8    = 0x07;
+    pub const SNAPSHOT_COMPACT: u8 = 0x08;
+    pub const BATCH: u8           = 0x09;
+    pub const DURABLE: u8         = 0x0A;
+    pub const HELLO: u8           = 0x0B;
     pub const ERROR: u8           = 0xFF;
 
     // Client → Server
@@ -33,6 +39,8 @@ pub mod msg {
     pub const CMD_UNSCHEDULE_TASK: u8 = 0x13;
     pub const CMD_COMPLETE_TASK: u8  = 0x14;
     pub const CMD_DELETE_TASK: u8    = 0x15;
+    pub const CMD_SET_INTEREST: u8   = 0x16;
+    pub const CMD_BATCH: u8          = 0x17;
 }
 
 /// Task record stride (bytes).
@@ -72,6 +80,28 @@ pub const SERVICE_NAME_MAX: usize = 64;
 /// ```
 pub const SNAPSHOT_HEADER: usize = 17;
 
+/// Compact snapshot header size (bytes).
+///
+/// Same hot fields as the fixed snapshot, but titles and service names move
+/// into one deduplicated string table, so frames carry no zero padding.
+///
+/// ```text
+/// [0]        msg type (0x08)
+/// [1..9]     revision (u64 LE)
+/// [9..13]    task_count (u32 LE)
+/// [13..17]   service_count (u32 LE)
+/// [17..21]   string table size (u32 LE)
+/// [21..]     task records, service records, then the string table
+/// ```
+///
+/// Compact task record: bytes [0..56] exactly as in a TASK_STRIDE record,
+/// then [56..60] title (u32 LE offset into the string table).
+/// Compact service record: [0..16] id, [16..20] name offset.
+/// String table entry: byte length as a LEB128 varint, then UTF-8 bytes.
+pub const COMPACT_SNAPSHOT_HEADER: usize = 21;
+pub const COMPACT_TASK_STRIDE: usize = 60;
+pub const COMPACT_SERVICE_STRIDE: usize = 20;
+
 /// Delta event header size (bytes).
 ///
 /// ```text
@@ -82,11 +112,96 @@ pub const SNAPSHOT_HEADER: usize = 17;
 /// ```
 pub const EVENT_HEADER: usize = 25;
 
+/// Durability acknowledgement size (bytes). Sent when a group commit lands:
+/// every event up to and including `revision` is on disk.
+///
+/// ```text
+/// [0]        msg type (0x0A)
+/// [1..9]     durable revision (u64 LE)
+/// ```
+pub const DURABLE_LEN: usize = 9;
+
+/// Connection greeting size (bytes). The first frame on every game socket.
+/// The epoch is random per server run: after a crash the server recovers to
+/// its last durable revision and reissues later revisions for different
+/// events, so a client may only resume (`?since=`) with the epoch it got
+/// its revisions under (`&epoch=`); anything else is sent a snapshot.
+/// Events up to the hydrated revision are a `?since=` replay of history,
+/// not changes happening now (their arrival time says nothing about when).
+///
+/// ```text
+/// [0]        msg type (0x0B)
+/// [1..9]     epoch (u64 LE)
+/// [9..17]    hydrated revision (u64 LE): what the following snapshot or
+///            replay brings the client up to
+/// ```
+pub const HELLO_LEN: usize = 17;
+
+/// Event batch header size (bytes).
+///
+/// ```text
+/// [0]        msg type (0x09)
+/// [1..3]     event count (u16 LE)
+/// [3..]      events back to back, each framed exactly as pack_event does;
+///            every event's length follows from its type (event_frame_len)
+/// ```
+pub const BATCH_HEADER: usize = 3;
+/// Most events a forwarder coalesces into one batch frame.
+pub const BATCH_MAX_EVENTS: usize = 64;
+
+/// Interest command header size (bytes). Client → server; replaces the set
+/// of services the client receives tasks and events for.
+///
+/// ```text
+/// [0]        msg type (0x16)
+/// [1..3]     service count (u16 LE, 0 = every service)
+/// [3..]      service ids (UUID, 16 bytes each)
+/// ```
+pub const INTEREST_HEADER: usize = 3;
+
+/// Command batch header size (bytes). Client → server; many commands in one
+/// frame (bulk import), applied in order as if sent one by one.
+///
+/// ```text
+/// [0]        msg type (0x17)
+/// [1..3]     command count (u16 LE)
+/// [3..]      commands back to back, each as [u16 LE length][command frame],
+///            the frame laid out exactly as unpack_command expects
+/// ```
+pub const COMMAND_BATCH_HEADER: usize = 3;
+
 // ── Packing (Server → Client) ──────────────────────────────────
 
 /// Pack a full world snapshot into a binary frame.
 pub fn pack_snapshot(world: &World) -> Vec<u8> {
-    let task_count = world.tasks.len();
+    pack_snapshot_of(world, world.tasks.len(), world.tasks.values())
+}
+
+/// Pack a snapshot of `world` with task records grouped by service (services
+/// by id, tasks by id within each). Also returns, per service with tasks,
+/// its id, first task slot and task count: the index a checkpoint file keeps
+/// so scoped snapshots can be cut from the packed records.
+pub fn pack_grouped_snapshot(world: &World) -> (Vec<u8>, Vec<(Uuid, u32, u32)>) {
+    let mut tasks: Vec<&Task> = world.tasks.values().collect();
+    tasks.sort_unstable_by_key(|t| (t.service_id, t.id));
+
+    let mut groups: Vec<(Uuid, u32, u32)> = Vec::new();
+    for (slot, task) in tasks.iter().enumerate() {
+        match groups.last_mut() {
+            Some((service_id, _, count)) if *service_id == task.service_id => *count += 1,
+            _ => groups.push((task.service_id, slot as u32, 1)),
+        }
+    }
+    (pack_snapshot_of(world, tasks.len(), tasks.into_iter()), groups)
+}
+
+/// Snapshot frame at `world`'s revision holding `tasks` (`task_count` of
+/// them) and every service.
+fn pack_snapshot_of<'a>(
+    world: &World,
+    task_count: usize,
+    tasks: impl Iterator<Item = &'a Task>,
+) -> Vec<u8> {
     let service_count = world.services.len();
     let size = SNAPSHOT_HEADER
         + task_count * TASK_STRIDE
@@ -102,10 +217,11 @@ pub fn pack_snapshot(world: &World) -> Vec<u8> {
 
     // Task records
     let mut offset = SNAPSHOT_HEADER;
-    for task in world.tasks.values() {
+    for task in tasks {
         pack_task(&mut buf[offset..offset + TASK_STRIDE], task);
         offset += TASK_STRIDE;
     }
+    debug_assert_eq!(offset, SNAPSHOT_HEADER + task_count * TASK_STRIDE);
 
     // Service records
     for service in world.services.values() {
@@ -143,6 +259,61 @@ fn pack_service(buf: &mut [u8], service: &Service) {
     buf[16..16 + len].copy_from_slice(&name_bytes[..len]);
 }
 
+/// Re-encode a fixed-stride snapshot frame (as built by `pack_snapshot` or
+/// `SnapshotCache::frame`) in the compact string-table layout.
+pub fn compact_snapshot(frame: &[u8]) -> Vec<u8> {
+    let task_count = u32::from_le_bytes(frame[9..13].try_into().unwrap()) as usize;
+    let service_count = u32::from_le_bytes(frame[13..17].try_into().unwrap()) as usize;
+    let tasks = &frame[SNAPSHOT_HEADER..SNAPSHOT_HEADER + task_count * TASK_STRIDE];
+    let services = &frame[SNAPSHOT_HEADER + task_count * TASK_STRIDE..];
+
+    let mut table = Vec::new();
+    let mut interned: HashMap<&[u8], u32> = HashMap::new();
+
+    let mut buf = Vec::with_capacity(
+        COMPACT_SNAPSHOT_HEADER
+            + task_count * COMPACT_TASK_STRIDE
+            + service_count * COMPACT_SERVICE_STRIDE,
+    );
+    buf.push(msg::SNAPSHOT_COMPACT);
+    buf.extend_from_slice(&frame[1..17]); // revision, task_count, service_count
+    buf.extend_from_slice(&[0; 4]); // string table size, patched below
+
+    for record in tasks.chunks(TASK_STRIDE) {
+        buf.extend_from_slice(&record[..56]);
+        buf.extend_from_slice(&intern_string(&mut table, &mut interned, &record[56..56 + TITLE_MAX]));
+    }
+    for record in services.chunks(SERVICE_STRIDE) {
+        buf.extend_from_slice(&record[..16]);
+        buf.extend_from_slice(&intern_string(&mut table, &mut interned, &record[16..16 + SERVICE_NAME_MAX]));
+    }
+
+    buf[17..21].copy_from_slice(&(table.len() as u32).to_le_bytes());
+    buf.extend_from_slice(&table);
+    buf
+}
+
+/// String-table offset (u32 LE) for a zero-padded field, appending it on first use.
+fn intern_string<'a>(table: &mut Vec<u8>, interned: &mut HashMap<&'a [u8], u32>, field: &'a [u8]) -> [u8; 4] {
+    let text = &field[..field.iter().position(|&b| b == 0).unwrap_or(field.len())];
+    let offset = *interned.entry(text).or_insert_with(|| {
+        let offset = table.len() as u32;
+        write_varint(table, text.len() as u32);
+        table.extend_from_slice(text);
+        offset
+    });
+    offset.to_le_bytes()
+}
+
+/// LEB128: 7 bits per byte, low groups first, high bit set on all but the last.
+fn write_varint(buf: &mut Vec<u8>, mut value: u32) {
+    while value >= 0x80 {
+        buf.push((value as u8) | 0x80);
+        value >>= 7;
+    }
+    buf.push(value as u8);
+}
+
 /// Pack an event into a binary frame.
 pub fn pack_event(event: &Event) -> Vec<u8> {
     match event {
@@ -202,6 +373,359 @@ pub fn pack_event(event: &Event) -> Vec<u8> {
     }
 }
 
+/// Framed length of an event of the given message type (None if not an event).
+pub fn event_frame_len(msg_type: u8) -> Option<usize> {
+    match msg_type {
+        msg::TASK_CREATED => Some(1 + 8 + TASK_STRIDE),
+        msg::TASK_SCHEDULED | msg::TASK_MOVED => Some(EVENT_HEADER + 6),
+        msg::TASK_UNSCHEDULED | msg::TASK_COMPLETED | msg::TASK_DELETED => Some(EVENT_HEADER),
+        msg::DURABLE => Some(DURABLE_LEN),
+        _ => None,
+    }
+}
+
+/// Pack a durability acknowledgement.
+pub fn pack_durable(revision: u64) -> Vec<u8> {
+    let mut buf = vec![0u8; DURABLE_LEN];
+    buf[0] = msg::DURABLE;
+    buf[1..9].copy_from_slice(&revision.to_le_bytes());
+    buf
+}
+
+/// Pack the connection greeting.
+pub fn pack_hello(epoch: u64, hydrated_revision: u64) -> Vec<u8> {
+    let mut buf = vec![0u8; HELLO_LEN];
+    buf[0] = msg::HELLO;
+    buf[1..9].copy_from_slice(&epoch.to_le_bytes());
+    buf[9..17].copy_from_slice(&hydrated_revision.to_le_bytes());
+    buf
+}
+
+/// Concatenate already-packed events into one batch frame.
+pub fn pack_batch(events: &[Arc<[u8]>]) -> Vec<u8> {
+    let size = BATCH_HEADER + events.iter().map(|e| e.len()).sum::<usize>();
+    let mut buf = Vec::with_capacity(size);
+    buf.push(msg::BATCH);
+    buf.extend_from_slice(&(events.len() as u16).to_le_bytes());
+    for event in events {
+        buf.extend_from_slice(event);
+    }
+    buf
+}
+
+/// Revision of a World event frame (None for snapshots, batches, acks).
+pub fn event_revision(frame: &[u8]) -> Option<u64> {
+    match frame.first() {
+        Some(&(msg::TASK_CREATED..=msg::TASK_DELETED)) if frame.len() >= 9 => {
+            Some(u64::from_le_bytes(frame[1..9].try_into().unwrap()))
+        }
+        _ => None,
+    }
+}
+
+/// Broadcast frames for the events of one apply drain: a lone event as is,
+/// more as batch frames of up to u16::MAX events, so a bulk import costs the
+/// broadcast channel one slot rather than one per event. Forwarders split
+/// them again (split_batch) to filter and re-chunk per client.
+pub fn pack_broadcast(events: &[Event]) -> Vec<Arc<[u8]>> {
+    let packed: Vec<Arc<[u8]>> = events.iter().map(|e| Arc::from(pack_event(e))).collect();
+    packed
+        .chunks(u16::MAX as usize)
+        .map(|chunk| if chunk.len() == 1 { chunk[0].clone() } else { Arc::from(pack_batch(chunk)) })
+        .collect()
+}
+
+/// The events of a batch frame (BATCH_HEADER), or the frame itself if it is
+/// not a batch. A malformed tail is dropped.
+pub fn split_batch(frame: &Arc<[u8]>) -> Vec<Arc<[u8]>> {
+    if frame.first() != Some(&msg::BATCH) || frame.len() < BATCH_HEADER {
+        return vec![frame.clone()];
+    }
+    let count = u16::from_le_bytes([frame[1], frame[2]]) as usize;
+    let mut events = Vec::with_capacity(count);
+    let mut off = BATCH_HEADER;
+    for _ in 0..count {
+        let len = match frame.get(off).and_then(|&t| event_frame_len(t)) {
+            Some(len) if off + len <= frame.len() => len,
+            _ => break,
+        };
+        events.push(Arc::from(&frame[off..off + len]));
+        off += len;
+    }
+    events
+}
+
+/// Catch-up frames for a reconnecting client: the packed events in order, in
+/// batch frames of up to BATCH_MAX_EVENTS (a lone event goes unbatched).
+pub fn pack_replay(events: impl IntoIterator<Item = Arc<[u8]>>) -> Vec<Vec<u8>> {
+    let packed: Vec<Arc<[u8]>> = events.into_iter().collect();
+    packed
+        .chunks(BATCH_MAX_EVENTS)
+        .map(|chunk| if chunk.len() == 1 { chunk[0].to_vec() } else { pack_batch(chunk) })
+        .collect()
+}
+
+// ── Interest scopes ────────────────────────────────────────────
+
+/// A client's interest set: the services it views and the tasks in them it
+/// has been sent. Scopes snapshots and filters the event stream down to those
+/// tasks; services are never filtered (the client lists them to widen).
+pub struct EventScope {
+    services: HashSet<Uuid>,
+    tasks: HashSet<Uuid>,
+}
+
+impl EventScope {
+    /// Scope for a client hydrated from `world` (e.g. by event replay).
+    pub fn from_world(services: HashSet<Uuid>, world: &World) -> Self {
+        let tasks = services.iter()
+            .flat_map(|&service_id| world.tasks_in_service(service_id))
+            .map(|t| t.id)
+            .collect();
+        EventScope { services, tasks }
+    }
+
+    /// Fixed-stride snapshot of `world` scoped to `services`: every service
+    /// record, only their tasks' records. Packed from the World's per-service
+    /// index, so it costs the scoped tasks, not the whole World.
+    pub fn scope_snapshot(services: HashSet<Uuid>, world: &World) -> (Self, Vec<u8>) {
+        let scope = Self::from_world(services, world);
+        let tasks = scope.services.iter().flat_map(|&service_id| world.tasks_in_service(service_id));
+        let buf = pack_snapshot_of(world, scope.tasks.len(), tasks);
+        (scope, buf)
+    }
+
+    /// Scoped snapshot from records that are already packed: `task_runs` hold
+    /// the task records of the services in scope (e.g. cut from a checkpoint
+    /// through its index) and `service_records` every service record.
+    pub fn scope_packed(
+        services: HashSet<Uuid>,
+        revision: u64,
+        task_runs: &[&[u8]],
+        service_records: &[u8],
+    ) -> (Self, Vec<u8>) {
+        let records_len: usize = task_runs.iter().map(|run| run.len()).sum();
+        let mut buf = Vec::with_capacity(SNAPSHOT_HEADER + records_len + service_records.len());
+        buf.push(msg::SNAPSHOT);
+        buf.extend_from_slice(&revision.to_le_bytes());
+        buf.extend_from_slice(&((records_len / TASK_STRIDE) as u32).to_le_bytes());
+        buf.extend_from_slice(&((service_records.len() / SERVICE_STRIDE) as u32).to_le_bytes());
+
+        let mut tasks = HashSet::new();
+        for run in task_runs {
+            tasks.extend(run.chunks_exact(TASK_STRIDE).map(|record| uuid_from_bytes(&record[0..16])));
+            buf.extend_from_slice(run);
+        }
+        buf.extend_from_slice(service_records);
+        (EventScope { services, tasks }, buf)
+    }
+
+    /// Whether the client should get this broadcast frame. Call for every
+    /// frame in order: creates and deletes keep the task set current.
+    pub fn admits(&mut self, frame: &[u8]) -> bool {
+        match frame.first() {
+            Some(&msg::TASK_CREATED) => {
+                let record = &frame[9..9 + TASK_STRIDE];
+                if !self.services.contains(&uuid_from_bytes(&record[24..40])) {
+                    return false;
+                }
+                self.tasks.insert(uuid_from_bytes(&record[0..16]));
+                true
+            }
+            // Let deletes through even for unknown tasks: one may have been
+            // sent before a reconnect, and a stray delete costs 25 bytes.
+            Some(&msg::TASK_DELETED) => {
+                self.tasks.remove(&uuid_from_bytes(&frame[9..25]));
+                true
+            }
+            Some(&(msg::TASK_SCHEDULED..=msg::TASK_COMPLETED)) => {
+                self.tasks.contains(&uuid_from_bytes(&frame[9..25]))
+            }
+            _ => true,
+        }
+    }
+}
+
+// ── Snapshot cache ─────────────────────────────────────────────
+
+/// Snapshot frame shared by every client that connects at the same revision.
+///
+/// Task records are kept packed in slot order and patched in place from each
+/// event (creates append, deletes swap-remove, the rest rewrite a few bytes),
+/// so a revision never costs a full re-pack. `frame()` freezes header, task
+/// and service records into one immutable buffer the first time a client asks
+/// at a new revision; a reconnect storm then shares that single allocation.
+///
+/// Services have no events and only change at boot, so their records are
+/// packed once. If an event arrives out of sequence the cache repacks from
+/// the World on the next `frame()`.
+///
+/// The cache lives on the reader side: the apply loop never touches it.
+/// `frame()` catches up from whatever published World version the caller
+/// holds, replaying that version's log from the cache's revision.
+pub struct SnapshotCache {
+    revision: u64,
+    tasks: Vec<u8>,
+    slots: HashMap<Uuid, usize>,
+    services: Vec<u8>,
+    service_count: usize,
+    stale: bool,
+    frame: Option<Arc<[u8]>>,
+    compact: Option<Arc<[u8]>>,
+}
+
+impl SnapshotCache {
+    /// A cache with nothing packed yet: the first `frame()` packs from
+    /// whatever World it is given, so it can be made before the World is
+    /// loaded.
+    pub fn new() -> Self {
+        SnapshotCache {
+            revision: 0,
+            tasks: Vec::new(),
+            slots: HashMap::new(),
+            services: Vec::new(),
+            service_count: 0,
+            stale: true,
+            frame: None,
+            compact: None,
+        }
+    }
+
+    /// Repack everything from the World.
+    fn rebuild(&mut self, world: &World) {
+        self.tasks.clear();
+        self.tasks.resize(world.tasks.len() * TASK_STRIDE, 0);
+        self.slots.clear();
+        for (slot, task) in world.tasks.values().enumerate() {
+            pack_task(&mut self.tasks[slot * TASK_STRIDE..(slot + 1) * TASK_STRIDE], task);
+            self.slots.insert(task.id, slot);
+        }
+
+        self.service_count = world.services.len();
+        self.services.clear();
+        self.services.resize(self.service_count * SERVICE_STRIDE, 0);
+        for (slot, service) in world.services.values().enumerate() {
+            pack_service(&mut self.services[slot * SERVICE_STRIDE..(slot + 1) * SERVICE_STRIDE], service);
+        }
+
+        self.revision = world.revision;
+        self.stale = false;
+        self.frame = None;
+        self.compact = None;
+    }
+
+    /// Patch the packed records with the next event in revision order.
+    pub fn apply(&mut self, event: &Event) {
+        if self.stale || event.revision() != self.revision + 1 {
+            self.stale = true;
+            return;
+        }
+        self.revision = event.revision();
+        self.frame = None;
+        self.compact = None;
+
+        match event {
+            Event::TaskCreated { task, .. } => {
+                let slot = self.tasks.len() / TASK_STRIDE;
+                self.tasks.resize(self.tasks.len() + TASK_STRIDE, 0);
+                pack_task(&mut self.tasks[slot * TASK_STRIDE..], task);
+                self.slots.insert(task.id, slot);
+            }
+            Event::TaskScheduled { task_id, date, start_time, duration, .. } => {
+                self.patch(task_id, |r| {
+                    r[16] = TaskStatus::Scheduled as u8;
+                    pack_schedule(r, *date, *start_time, *duration);
+                });
+            }
+            Event::TaskMoved { task_id, date, start_time, duration, .. } => {
+                self.patch(task_id, |r| pack_schedule(r, *date, *start_time, *duration));
+            }
+            Event::TaskUnscheduled { task_id, .. } => {
+                self.patch(task_id, |r| {
+                    r[16] = TaskStatus::Staged as u8;
+                    pack_schedule(r, 0xFFFF, 0, 0);
+                });
+            }
+            Event::TaskCompleted { task_id, .. } => {
+                self.patch(task_id, |r| r[16] = TaskStatus::Completed as u8);
+            }
+            Event::TaskDeleted { task_id, .. } => {
+                let Some(slot) = self.slots.remove(task_id) else {
+                    self.stale = true;
+                    return;
+                };
+                let last = self.tasks.len() / TASK_STRIDE - 1;
+                if slot != last {
+                    self.tasks.copy_within(last * TASK_STRIDE..(last + 1) * TASK_STRIDE, slot * TASK_STRIDE);
+                    let moved = uuid_from_bytes(&self.tasks[slot * TASK_STRIDE..slot * TASK_STRIDE + 16]);
+                    self.slots.insert(moved, slot);
+                }
+                self.tasks.truncate(last * TASK_STRIDE);
+            }
+        }
+    }
+
+    fn patch(&mut self, task_id: &Uuid, f: impl FnOnce(&mut [u8])) {
+        match self.slots.get(task_id) {
+            Some(&slot) => f(&mut self.tasks[slot * TASK_STRIDE..(slot + 1) * TASK_STRIDE]),
+            None => self.stale = true,
+        }
+    }
+
+    /// The snapshot frame for `world`'s revision or later, built at most once
+    /// per revision. Same layout as `pack_snapshot` (task order may differ).
+    ///
+    /// A cache already ahead of `world` (another reader brought it up to a
+    /// newer published version) is served as is: that version was published
+    /// after the caller loaded its own, so it is just as valid a starting point.
+    pub fn frame(&mut self, world: &World) -> Arc<[u8]> {
+        if !self.stale && self.revision < world.revision {
+            match world.events_since(self.revision) {
+                Some(events) => events.iter().for_each(|(_, event)| self.apply(event)),
+                None => self.stale = true,
+            }
+        }
+        if self.stale || self.revision < world.revision {
+            self.rebuild(world);
+        }
+        if let Some(frame) = &self.frame {
+            return frame.clone();
+        }
+
+        let task_count = self.tasks.len() / TASK_STRIDE;
+        let mut buf = Vec::with_capacity(SNAPSHOT_HEADER + self.tasks.len() + self.services.len());
+        buf.push(msg::SNAPSHOT);
+        buf.extend_from_slice(&self.revision.to_le_bytes());
+        buf.extend_from_slice(&(task_count as u32).to_le_bytes());
+        buf.extend_from_slice(&(self.service_count as u32).to_le_bytes());
+        buf.extend_from_slice(&self.tasks);
+        buf.extend_from_slice(&self.services);
+
+        let frame: Arc<[u8]> = buf.into();
+        self.frame = Some(frame.clone());
+        frame
+    }
+
+    /// The compact (string-table) encoding of `frame()`, also built at most
+    /// once per revision.
+    pub fn compact_frame(&mut self, world: &World) -> Arc<[u8]> {
+        let frame = self.frame(world);
+        if let Some(compact) = &self.compact {
+            return compact.clone();
+        }
+        let compact: Arc<[u8]> = compact_snapshot(&frame).into();
+        self.compact = Some(compact.clone());
+        compact
+    }
+}
+
+/// Rewrite the scheduling fields of a packed task record.
+fn pack_schedule(buf: &mut [u8], date: u16, start_time: u16, duration: u16) {
+    buf[18..20].copy_from_slice(&date.to_le_bytes());
+    buf[20..22].copy_from_slice(&start_time.to_le_bytes());
+    buf[22..24].copy_from_slice(&duration.to_le_bytes());
+}
+
 // ── Unpacking (Client → Server) ────────────────────────────────
 
 /// Unpack a binary command frame from the client.
@@ -304,6 +828,60 @@ pub fn unpack_command(data: &[u8]) -> Result<Command, WireError> {
     }
 }
 
+/// Unpack an interest command (INTEREST_HEADER). None means every service.
+pub fn unpack_interest(data: &[u8]) -> Result<Option<HashSet<Uuid>>, WireError> {
+    if data.len() < INTEREST_HEADER {
+        return Err(WireError::TooShort);
+    }
+    if data[0] != msg::CMD_SET_INTEREST {
+        return Err(WireError::UnknownMessage(data[0]));
+    }
+    let count = u16::from_le_bytes([data[1], data[2]]) as usize;
+    if data.len() < INTEREST_HEADER + count * 16 {
+        return Err(WireError::TooShort);
+    }
+    if count == 0 {
+        return Ok(None);
+    }
+    Ok(Some(
+        data[INTEREST_HEADER..INTEREST_HEADER + count * 16]
+            .chunks_exact(16)
+            .map(uuid_from_bytes)
+            .collect(),
+    ))
+}
+
+/// Unpack a command batch (COMMAND_BATCH_HEADER). Fails as a whole on the
+/// first bad command, or on bytes past the declared count, so a batch is
+/// never half-queued.
+pub fn unpack_command_batch(data: &[u8]) -> Result<Vec<Command>, WireError> {
+    if data.len() < COMMAND_BATCH_HEADER {
+        return Err(WireError::TooShort);
+    }
+    if data[0] != msg::CMD_BATCH {
+        return Err(WireError::UnknownMessage(data[0]));
+    }
+    let count = u16::from_le_bytes([data[1], data[2]]) as usize;
+    let mut cmds = Vec::with_capacity(count);
+    let mut off = COMMAND_BATCH_HEADER;
+    for _ in 0..count {
+        if data.len() < off + 2 {
+            return Err(WireError::TooShort);
+        }
+        let len = u16::from_le_bytes([data[off], data[off + 1]]) as usize;
+        off += 2;
+        if data.len() < off + len {
+            return Err(WireError::TooShort);
+        }
+        cmds.push(unpack_command(&data[off..off + len])?);
+        off += len;
+    }
+    if off != data.len() {
+        return Err(WireError::InvalidField("count")); // bytes past the last command
+    }
+    Ok(cmds)
+}
+
 // ── Helpers ────────────────────────────────────────────────────
 
 fn uuid_from_bytes(b: &[u8]) -> Uuid {
@@ -386,7 +964,7 @@ mod tests {
         let mut world = World::new();
         let task = make_task();
         let service = make_service();
-        world.tasks.insert(task.id, task.clone());
+        world.insert_task(task.clone());
         world.services.insert(service.id, service.clone());
         world.revision = 42;
 
@@ -587,4 +1165,327 @@ mod tests {
         let date = u16::from_le_bytes([buf[18], buf[19]]);
         assert_eq!(date, 0xFFFF); // unscheduled sentinel
     }
+
+    /// Task records of a snapshot frame, sorted (the cache keeps its own slot order).
+    fn sorted_records(frame: &[u8]) -> (Vec<u8>, Vec<&[u8]>) {
+        let count = u32::from_le_bytes(frame[9..13].try_into().unwrap()) as usize;
+        let mut records: Vec<&[u8]> = frame[SNAPSHOT_HEADER..SNAPSHOT_HEADER + count * TASK_STRIDE]
+            .chunks(TASK_STRIDE)
+            .collect();
+        records.sort();
+        (frame[..SNAPSHOT_HEADER].to_vec(), records)
+    }
+
+    #[test]
+    fn snapshot_cache_tracks_events_and_shares_frames() {
+        let mut world = World::new();
+        let service = make_service();
+        world.services.insert(service.id, service.clone());
+        let mut cache = SnapshotCache::new();
+        cache.frame(&world);
+
+        let user = Uuid::from_bytes([3; 16]);
+        let mut ids = Vec::new();
+        for i in 0..4u16 {
+            let event = world.apply(Command::CreateTask {
+                title: format!("task {i}"),
+                service_id: service.id,
+                priority: Priority::Low,
+                assigned_to: None,
+                date: Some(D),
+                start_time: Some(540 + i * 15),
+                duration: Some(30),
+            }, user).unwrap();
+            if let Event::TaskCreated { task, .. } = &event {
+                ids.push(task.id);
+            }
+            cache.apply(&event);
+        }
+        let commands = [
+            Command::MoveTask { task_id: ids[0], date: D + 1, start_time: 600, duration: 45 },
+            Command::CompleteTask { task_id: ids[1] },
+            Command::UnscheduleTask { task_id: ids[2] },
+            Command::DeleteTask { task_id: ids[0] },
+            Command::ScheduleTask { task_id: ids[2], date: D, start_time: 900, duration: 60 },
+        ];
+        for cmd in commands {
+            let event = world.apply(cmd, user).unwrap();
+            cache.apply(&event);
+        }
+
+        let frame = cache.frame(&world);
+        assert!(!cache.stale);
+        assert_eq!(sorted_records(&frame), sorted_records(&pack_snapshot(&world)));
+        assert_eq!(&frame[frame.len() - SERVICE_STRIDE..frame.len() - SERVICE_STRIDE + 16], service.id.as_bytes());
+
+        // Same revision: the same allocation is handed out again.
+        assert!(Arc::ptr_eq(&frame, &cache.frame(&world)));
+
+        // A missed event forces a repack from the World.
+        world.apply(Command::DeleteTask { task_id: ids[3] }, user).unwrap();
+        let event = world.apply(Command::CompleteTask { task_id: ids[2] }, user).unwrap();
+        cache.apply(&event);
+        let frame = cache.frame(&world);
+        assert_eq!(sorted_records(&frame), sorted_records(&pack_snapshot(&world)));
+    }
+
+    #[test]
+    fn snapshot_cache_catches_up_from_published_versions() {
+        let mut world = World::new();
+        let service = make_service();
+        world.services.insert(service.id, service.clone());
+        let mut cache = SnapshotCache::new();
+        cache.frame(&world);
+
+        let user = Uuid::from_bytes([3; 16]);
+        let create = |i: u16| Command::CreateTask {
+            title: format!("task {i}"),
+            service_id: service.id,
+            priority: Priority::Low,
+            assigned_to: None,
+            date: None,
+            start_time: None,
+            duration: None,
+        };
+        world.apply(create(0), user).unwrap();
+        let older = world.clone();
+        world.apply(create(1), user).unwrap();
+        world.apply(create(2), user).unwrap();
+
+        // Caught up through the version's log.
+        let frame = cache.frame(&world);
+        assert!(!cache.stale);
+        assert_eq!(cache.revision, 3);
+        assert_eq!(sorted_records(&frame), sorted_records(&pack_snapshot(&world)));
+
+        // A reader holding an older version still gets the newer frame.
+        assert!(Arc::ptr_eq(&frame, &cache.frame(&older)));
+        assert_eq!(older.tasks.len(), 1);
+    }
+
+    /// Read a string-table entry the way a client decoder would.
+    fn compact_string(table: &[u8], offset: usize) -> &str {
+        let (mut len, mut shift, mut at) = (0usize, 0, offset);
+        loop {
+            let b = table[at];
+            at += 1;
+            len |= ((b & 0x7F) as usize) << shift;
+            shift += 7;
+            if b & 0x80 == 0 {
+                break;
+            }
+        }
+        std::str::from_utf8(&table[at..at + len]).unwrap()
+    }
+
+    #[test]
+    fn compact_snapshot_dedups_strings() {
+        let mut world = World::new();
+        let service = make_service();
+        world.services.insert(service.id, service.clone());
+        let long_title = "x".repeat(200); // truncated to TITLE_MAX, length needs a 2-byte varint
+        for (i, title) in ["Deploy the widget", "Deploy the widget", &long_title].iter().enumerate() {
+            let mut task = make_task();
+            task.id = Uuid::from_bytes([10 + i as u8; 16]);
+            task.title = title.to_string();
+            world.insert_task(task);
+        }
+        world.revision = 9;
+
+        let fixed = pack_snapshot(&world);
+        let compact = compact_snapshot(&fixed);
+        assert_eq!(compact[0], msg::SNAPSHOT_COMPACT);
+        assert_eq!(&compact[1..17], &fixed[1..17]);
+
+        let table_len = u32::from_le_bytes(compact[17..21].try_into().unwrap()) as usize;
+        let records_end = COMPACT_SNAPSHOT_HEADER + 3 * COMPACT_TASK_STRIDE + COMPACT_SERVICE_STRIDE;
+        assert_eq!(compact.len(), records_end + table_len);
+        // Three distinct strings: one title stored once for two tasks, the long title, the service name.
+        assert_eq!(table_len, (1 + 17) + (2 + TITLE_MAX) + (1 + 14));
+        let table = &compact[records_end..];
+
+        let mut offsets = Vec::new();
+        for i in 0..3 {
+            let c = &compact[COMPACT_SNAPSHOT_HEADER + i * COMPACT_TASK_STRIDE..][..COMPACT_TASK_STRIDE];
+            let f = &fixed[SNAPSHOT_HEADER + i * TASK_STRIDE..][..TASK_STRIDE];
+            assert_eq!(&c[..56], &f[..56]);
+            let offset = u32::from_le_bytes(c[56..60].try_into().unwrap()) as usize;
+            assert_eq!(compact_string(table, offset), string_from_bytes(&f[56..184]).unwrap());
+            offsets.push(offset);
+        }
+        offsets.sort();
+        offsets.dedup();
+        assert_eq!(offsets.len(), 2);
+
+        let s = &compact[COMPACT_SNAPSHOT_HEADER + 3 * COMPACT_TASK_STRIDE..records_end];
+        assert_eq!(&s[..16], service.id.as_bytes());
+        let name_offset = u32::from_le_bytes(s[16..20].try_into().unwrap()) as usize;
+        assert_eq!(compact_string(table, name_offset), "Billing Portal");
+    }
+
+    #[test]
+    fn batch_frames_split_back_into_events() {
+        let id = Uuid::from_bytes([0xCC; 16]);
+        let events = [
+            Event::TaskCreated { revision: 1, task: make_task() },
+            Event::TaskScheduled { revision: 2, task_id: id, date: D, start_time: 540, duration: 60 },
+            Event::TaskMoved { revision: 3, task_id: id, date: D, start_time: 600, duration: 30 },
+            Event::TaskUnscheduled { revision: 4, task_id: id },
+            Event::TaskCompleted { revision: 5, task_id: id },
+            Event::TaskDeleted { revision: 6, task_id: id },
+        ];
+        let mut packed: Vec<Arc<[u8]>> = events.iter().map(|e| pack_event(e).into()).collect();
+        packed.push(pack_durable(6).into());
+        let batch = pack_batch(&packed);
+
+        assert_eq!(batch[0], msg::BATCH);
+        assert_eq!(u16::from_le_bytes([batch[1], batch[2]]), 7);
+        let mut offset = BATCH_HEADER;
+        for event in &packed {
+            let len = event_frame_len(batch[offset]).unwrap();
+            assert_eq!(len, event.len());
+            assert_eq!(&batch[offset..offset + len], &event[..]);
+            offset += len;
+        }
+        assert_eq!(offset, batch.len());
+        assert_eq!(event_frame_len(msg::SNAPSHOT), None);
+    }
+
+    #[test]
+    fn replay_chunks_events_into_batches() {
+        let id = Uuid::from_bytes([0xCC; 16]);
+        let events: Vec<Event> = (1..=BATCH_MAX_EVENTS as u64 + 1)
+            .map(|revision| Event::TaskCompleted { revision, task_id: id })
+            .collect();
+
+        let frames = pack_replay(events.iter().map(|e| pack_event(e).into()));
+        assert_eq!(frames.len(), 2);
+        assert_eq!(frames[0][0], msg::BATCH);
+        assert_eq!(u16::from_le_bytes([frames[0][1], frames[0][2]]) as usize, BATCH_MAX_EVENTS);
+        // The leftover event goes out on its own.
+        assert_eq!(event_revision(&frames[1]), Some(BATCH_MAX_EVENTS as u64 + 1));
+
+        assert_eq!(event_revision(&frames[0]), None);
+        assert_eq!(event_revision(&pack_durable(9)), None);
+        assert!(pack_replay([]).is_empty());
+    }
+
+    #[test]
+    fn hello_layout() {
+        let frame = pack_hello(0x0102_0304_0506_0708, 42);
+        assert_eq!(frame.len(), HELLO_LEN);
+        assert_eq!(frame[0], msg::HELLO);
+        assert_eq!(u64::from_le_bytes(frame[1..9].try_into().unwrap()), 0x0102_0304_0506_0708);
+        assert_eq!(u64::from_le_bytes(frame[9..17].try_into().unwrap()), 42);
+        assert_eq!(event_revision(&frame), None);
+    }
+
+    #[test]
+    fn broadcast_batches_split_back_into_events() {
+        let id = Uuid::from_bytes([0xCC; 16]);
+        let events: Vec<Event> = (1..=300u64)
+            .map(|revision| Event::TaskCompleted { revision, task_id: id })
+            .collect();
+
+        let frames = pack_broadcast(&events);
+        assert_eq!(frames.len(), 1);
+        let split = split_batch(&frames[0]);
+        assert_eq!(split.len(), 300);
+        for (event, revision) in split.iter().zip(1..) {
+            assert_eq!(event_revision(event), Some(revision));
+        }
+
+        // A lone event is broadcast, and split, as itself.
+        let lone = pack_broadcast(&events[..1]);
+        assert_eq!(event_revision(&lone[0]), Some(1));
+        assert_eq!(split_batch(&lone[0]).len(), 1);
+        assert!(pack_broadcast(&[]).is_empty());
+    }
+
+    #[test]
+    fn interest_scope_filters_snapshot_and_events() {
+        let billing = make_service();
+        let search = Service { id: Uuid::from_bytes([6; 16]), name: "Search".into() };
+        let mut world = World::new();
+        world.services.insert(billing.id, billing.clone());
+        world.services.insert(search.id, search.clone());
+        let mut ours = make_task();
+        ours.service_id = billing.id;
+        let mut theirs = make_task();
+        theirs.id = Uuid::from_bytes([9; 16]);
+        theirs.service_id = search.id;
+        world.insert_task(ours.clone());
+        world.insert_task(theirs.clone());
+
+        let mut cmd = vec![msg::CMD_SET_INTEREST, 1, 0];
+        cmd.extend_from_slice(billing.id.as_bytes());
+        let services = unpack_interest(&cmd).unwrap().unwrap();
+        assert_eq!(unpack_interest(&[msg::CMD_SET_INTEREST, 0, 0]).unwrap(), None);
+        assert!(matches!(unpack_interest(&cmd[..10]), Err(WireError::TooShort)));
+
+        let (mut scope, frame) = EventScope::scope_snapshot(services.clone(), &world);
+        assert_eq!(u32::from_le_bytes(frame[9..13].try_into().unwrap()), 1);
+        assert_eq!(u32::from_le_bytes(frame[13..17].try_into().unwrap()), 2);
+        assert_eq!(&frame[SNAPSHOT_HEADER..SNAPSHOT_HEADER + 16], ours.id.as_bytes());
+        assert_eq!(frame.len(), SNAPSHOT_HEADER + TASK_STRIDE + 2 * SERVICE_STRIDE);
+
+        let completed = |task_id| pack_event(&Event::TaskCompleted { revision: 1, task_id });
+        assert!(scope.admits(&completed(ours.id)));
+        assert!(!scope.admits(&completed(theirs.id)));
+
+        // A task created in scope is followed from then on.
+        let mut new = make_task();
+        new.id = Uuid::from_bytes([8; 16]);
+        new.service_id = billing.id;
+        assert!(scope.admits(&pack_event(&Event::TaskCreated { revision: 2, task: new.clone() })));
+        assert!(scope.admits(&completed(new.id)));
+        assert!(!scope.admits(&pack_event(&Event::TaskCreated { revision: 3, task: theirs.clone() })));
+
+        assert!(scope.admits(&pack_event(&Event::TaskDeleted { revision: 4, task_id: new.id })));
+        assert!(!scope.admits(&completed(new.id)));
+        assert!(scope.admits(&pack_durable(4)));
+
+        let mut replayed = EventScope::from_world(services, &world);
+        assert!(replayed.admits(&completed(ours.id)) && !replayed.admits(&completed(theirs.id)));
+    }
+
+    #[test]
+    fn unpack_command_batch_in_order() {
+        let svc_id = Uuid::from_bytes([0x33; 16]);
+        let create = |priority: u8, title: &[u8]| {
+            let mut data = vec![msg::CMD_CREATE_TASK, priority];
+            data.extend_from_slice(svc_id.as_bytes());
+            data.extend_from_slice(&[0u8; 16]); // assigned_to = none
+            data.extend_from_slice(&0xFFFFu16.to_le_bytes()); // staged
+            data.extend_from_slice(&[0u8; 4]);
+            data.extend_from_slice(title);
+            data
+        };
+        let mut delete = vec![msg::CMD_DELETE_TASK];
+        delete.extend_from_slice(&[0xDD; 16]);
+
+        let mut batch = vec![msg::CMD_BATCH, 3, 0];
+        for cmd in [create(0, b"First"), create(2, b"Second"), delete] {
+            batch.extend_from_slice(&(cmd.len() as u16).to_le_bytes());
+            batch.extend_from_slice(&cmd);
+        }
+
+        let cmds = unpack_command_batch(&batch).unwrap();
+        assert_eq!(cmds.len(), 3);
+        assert!(matches!(&cmds[0], Command::CreateTask { title, priority: Priority::Low, .. } if title == "First"));
+        assert!(matches!(&cmds[1], Command::CreateTask { title, priority: Priority::High, .. } if title == "Second"));
+        assert!(matches!(&cmds[2], Command::DeleteTask { task_id } if *task_id == Uuid::from_bytes([0xDD; 16])));
+
+        assert_eq!(unpack_command_batch(&[msg::CMD_BATCH, 0, 0]).unwrap().len(), 0);
+        assert_eq!(unpack_command_batch(&batch[..batch.len() - 1]).unwrap_err(), WireError::TooShort);
+        let mut bad = batch.clone();
+        bad[3 + 2 + 1] = 9; // first command's priority
+        assert_eq!(unpack_command_batch(&bad).unwrap_err(), WireError::InvalidField("priority"));
+        let mut trailing = batch.clone();
+        trailing.push(0);
+        assert_eq!(unpack_command_batch(&trailing).unwrap_err(), WireError::InvalidField("count"));
+        // Batches do not nest.
+        let nested = [msg::CMD_BATCH, 1, 0, 3, 0, msg::CMD_BATCH, 0, 0];
+        assert_eq!(unpack_command_batch(&nested).unwrap_err(), WireError::UnknownMessage(msg::CMD_BATCH));
+    }
 }
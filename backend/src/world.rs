@@ -1,5 +1,7 @@
+use imbl::{HashMap, OrdSet, Vector};
 use serde::{Deserialize, Serialize};
-use std::collections::HashMap;
+use std::cmp::Reverse;
+use std::time::{Duration, Instant};
 use uuid::Uuid;
 
 // ── Entity types ──────────────────────────────────────────────
@@ -141,6 +143,20 @@ pub enum Event {
     },
 }
 
+impl Event {
+    /// Revision this event was applied at.
+    pub fn revision(&self) -> u64 {
+        match self {
+            Event::TaskCreated { revision, .. }
+            | Event::TaskScheduled { revision, .. }
+            | Event::TaskMoved { revision, .. }
+            | Event::TaskUnscheduled { revision, .. }
+            | Event::TaskCompleted { revision, .. }
+            | Event::TaskDeleted { revision, .. } => *revision,
+        }
+    }
+}
+
 // ── Errors ─────────────────────────────────────────────────────
 
 #[derive(Debug, Clone, PartialEq, Eq)]
@@ -159,13 +175,26 @@ pub enum WorldError {
 /// The authoritative game state. Lives in memory. Loaded from redb on boot.
 /// All mutations go through apply() which validates, mutates, and returns
 /// an Event for broadcast.
+///
+/// Collections are persistent (structurally shared) so `clone()` is a handful
+/// of reference counts; the apply loop publishes each version that way.
+///
+/// Tasks and users are indexed for the queries clients make (staging queue,
+/// per service, per date, login); add them with `insert_task`/`insert_user`
+/// rather than through the maps so the indexes follow.
+#[derive(Clone)]
 pub struct World {
     pub tasks: HashMap<Uuid, Task>,
     pub users: HashMap<Uuid, User>,
     pub services: HashMap<Uuid, Service>,
     pub revision: u64,
     /// Recent event log for reconnect replay and undo.
-    pub log: Vec<(u64, Event)>,
+    pub log: EventLog,
+    /// Latest checkpoint: the revision the save file is known to hold.
+    /// The log is only trimmed up to here, so log + save file always cover
+    /// history without a gap.
+    pub checkpoint: u64,
+    index: Indexes,
 }
 
 impl World {
@@ -175,8 +204,28 @@ impl World {
             users: HashMap::new(),
             services: HashMap::new(),
             revision: 0,
-            log: Vec::new(),
+            log: EventLog::default(),
+            checkpoint: 0,
+            index: Indexes::default(),
+        }
+    }
+
+    /// Add (or replace) a task outside of `apply`, e.g. when loading.
+    pub fn insert_task(&mut self, task: Task) {
+        if let Some(old) = self.tasks.get(&task.id) {
+            self.index.remove_task(old);
+        }
+        self.index.add_task(&task);
+        self.tasks.insert(task.id, task);
+    }
+
+    /// Add (or replace) a user.
+    pub fn insert_user(&mut self, user: User) {
+        if let Some(old) = self.users.get(&user.id) {
+            self.index.usernames.remove(&old.username);
         }
+        self.index.usernames.insert(user.username.clone(), user.id);
+        self.users.insert(user.id, user);
     }
 
     /// Apply a command to the world. Returns the resulting Event on success.
@@ -216,8 +265,9 @@ impl World {
                     revision: self.revision,
                     task: task.clone(),
                 };
+                self.index.add_task(&task);
                 self.tasks.insert(task.id, task);
-                self.log.push((self.revision, event.clone()));
+                self.log.push(self.revision, event.clone(), Instant::now());
                 Ok(event)
             }
 
@@ -232,10 +282,12 @@ impl World {
                     return Err(WorldError::InvalidTransition);
                 }
 
+                self.index.remove_task(task);
                 task.status = TaskStatus::Scheduled;
                 task.date = Some(date);
                 task.start_time = Some(start_time);
                 task.duration = Some(duration);
+                self.index.add_task(task);
 
                 self.revision += 1;
                 let event = Event::TaskScheduled {
@@ -245,7 +297,7 @@ impl World {
                     start_time,
                     duration,
                 };
-                self.log.push((self.revision, event.clone()));
+                self.log.push(self.revision, event.clone(), Instant::now());
                 Ok(event)
             }
 
@@ -260,9 +312,11 @@ impl World {
                     return Err(WorldError::InvalidTransition);
                 }
 
+                self.index.remove_task(task);
                 task.date = Some(date);
                 task.start_time = Some(start_time);
                 task.duration = Some(duration);
+                self.index.add_task(task);
 
                 self.revision += 1;
                 let event = Event::TaskMoved {
@@ -272,7 +326,7 @@ impl World {
                     start_time,
                     duration,
                 };
-                self.log.push((self.revision, event.clone()));
+                self.log.push(self.revision, event.clone(), Instant::now());
                 Ok(event)
             }
 
@@ -285,17 +339,19 @@ impl World {
                     return Err(WorldError::InvalidTransition);
                 }
 
+                self.index.remove_task(task);
                 task.status = TaskStatus::Staged;
                 task.date = None;
                 task.start_time = None;
                 task.duration = None;
+                self.index.add_task(task);
 
                 self.revision += 1;
                 let event = Event::TaskUnscheduled {
                     revision: self.revision,
                     task_id,
                 };
-                self.log.push((self.revision, event.clone()));
+                self.log.push(self.revision, event.clone(), Instant::now());
                 Ok(event)
             }
 
@@ -308,6 +364,7 @@ impl World {
                     return Err(WorldError::InvalidTransition);
                 }
 
+                // Same slot, not staged before or after: no index changes.
                 task.status = TaskStatus::Completed;
 
                 self.revision += 1;
@@ -315,55 +372,223 @@ impl World {
                     revision: self.revision,
                     task_id,
                 };
-                self.log.push((self.revision, event.clone()));
+                self.log.push(self.revision, event.clone(), Instant::now());
                 Ok(event)
             }
 
             Command::DeleteTask { task_id } => {
-                if self.tasks.remove(&task_id).is_none() {
-                    return Err(WorldError::TaskNotFound);
-                }
+                let task = self.tasks.remove(&task_id)
+                    .ok_or(WorldError::TaskNotFound)?;
+                self.index.remove_task(&task);
 
                 self.revision += 1;
                 let event = Event::TaskDeleted {
                     revision: self.revision,
                     task_id,
                 };
-                self.log.push((self.revision, event.clone()));
+                self.log.push(self.revision, event.clone(), Instant::now());
                 Ok(event)
             }
         }
     }
 
-    /// Look up a user by username (linear scan — fine for 5-20 users).
+    /// Look up a user by username.
     pub fn get_user_by_username(&self, username: &str) -> Option<&User> {
-        self.users.values().find(|u| u.username == username)
+        self.index.usernames.get(username).and_then(|id| self.users.get(id))
     }
 
     /// Get all Staged tasks, sorted by priority (highest first).
     /// This is the staging queue that IRONCLAD renders as a sidebar list.
     pub fn staging_queue(&self) -> Vec<&Task> {
-        let mut staged: Vec<&Task> = self.tasks.values()
-            .filter(|t| t.status == TaskStatus::Staged)
-            .collect();
-        // Sort by priority descending (Urgent first, Low last)
-        staged.sort_by(|a, b| b.priority.cmp(&a.priority));
-        staged
+        self.index.staged.iter().map(|(_, id)| &self.tasks[id]).collect()
+    }
+
+    /// Every task in a service, in id order.
+    pub fn tasks_in_service(&self, service_id: Uuid) -> impl Iterator<Item = &Task> + '_ {
+        self.index.by_service.get(&service_id)
+            .into_iter()
+            .flat_map(move |ids| ids.iter().map(move |id| &self.tasks[id]))
+    }
+
+    /// Tasks on the grid from date `first` through `last` (inclusive), by
+    /// date then start time.
+    pub fn tasks_between(&self, first: u16, last: u16) -> impl Iterator<Item = &Task> + '_ {
+        self.index.by_date
+            .range((first, 0, Uuid::nil())..=(last, u16::MAX, MAX_UUID))
+            .map(move |(_, _, id)| &self.tasks[id])
+    }
+
+    /// Tasks on `date` whose slot overlaps minutes `from..to`, by start time.
+    /// A slot never crosses midnight, so only that day's tasks starting
+    /// before `to` are looked at.
+    pub fn tasks_overlapping(&self, date: u16, from: u16, to: u16) -> impl Iterator<Item = &Task> + '_ {
+        self.index.by_date
+            .range((date, 0, Uuid::nil())..(date, to, Uuid::nil()))
+            .map(move |(_, _, id)| &self.tasks[id])
+            .filter(move |t| t.start_time.unwrap_or(0) + t.duration.unwrap_or(0) > from)
     }
 
     /// Get all events since a given revision (for reconnect replay).
     /// Returns None if the revision is too old (caller should send full snapshot).
-    pub fn events_since(&self, since_rev: u64) -> Option<&[(u64, Event)]> {
-        // Find the first log entry after since_rev
-        let start = self.log.iter().position(|(rev, _)| *rev > since_rev);
-        match start {
-            Some(idx) => Some(&self.log[idx..]),
-            None if since_rev >= self.revision => Some(&[]), // up to date
-            None => None, // too old, log was trimmed
+    /// The returned log shares structure with this one; no events are copied.
+    pub fn events_since(&self, since_rev: u64) -> Option<Vector<(u64, Event)>> {
+        if since_rev == self.revision {
+            return Some(Vector::new()); // up to date
+        }
+        if since_rev > self.revision {
+            return None; // not our history (e.g. a save file from elsewhere)
+        }
+        self.log.since(since_rev)
+    }
+
+    /// Record a checkpoint at `durable` (the revision the save file holds)
+    /// and trim the log back to `retention`, never past the checkpoint.
+    /// Returns how many events were dropped.
+    pub fn checkpoint(&mut self, durable: u64, retention: &LogRetention, now: Instant) -> usize {
+        self.checkpoint = self.checkpoint.max(durable.min(self.revision));
+        self.log.trim(retention, self.checkpoint, now)
+    }
+}
+
+// ── Indexes ────────────────────────────────────────────────────
+
+const MAX_UUID: Uuid = Uuid::from_bytes([0xFF; 16]);
+
+/// Secondary indexes over `World::tasks` and `World::users`, updated in step
+/// with them so queries cost O(result). Persistent like the maps they index:
+/// each published World version carries its own for a few reference counts.
+#[derive(Clone, Default)]
+struct Indexes {
+    /// Staged tasks, highest priority first (ties by id).
+    staged: OrdSet<(Reverse<Priority>, Uuid)>,
+    /// Task ids per service.
+    by_service: HashMap<Uuid, OrdSet<Uuid>>,
+    /// Tasks with a slot, by (date, start_time, id).
+    by_date: OrdSet<(u16, u16, Uuid)>,
+    /// User id per username.
+    usernames: HashMap<String, Uuid>,
+}
+
+impl Indexes {
+    fn add_task(&mut self, task: &Task) {
+        if task.status == TaskStatus::Staged {
+            self.staged.insert((Reverse(task.priority), task.id));
+        }
+        if let (Some(date), Some(start)) = (task.date, task.start_time) {
+            self.by_date.insert((date, start, task.id));
+        }
+        self.by_service.entry(task.service_id).or_default().insert(task.id);
+    }
+
+    /// Undo `add_task` for the task as it was indexed.
+    fn remove_task(&mut self, task: &Task) {
+        if task.status == TaskStatus::Staged {
+            self.staged.remove(&(Reverse(task.priority), task.id));
+        }
+        if let (Some(date), Some(start)) = (task.date, task.start_time) {
+            self.by_date.remove(&(date, start, task.id));
+        }
+        if let Some(ids) = self.by_service.get_mut(&task.service_id) {
+            ids.remove(&task.id);
+            if ids.is_empty() {
+                self.by_service.remove(&task.service_id);
+            }
+        }
+    }
+}
+
+// ── Event log ──────────────────────────────────────────────────
+
+/// How much history the event log keeps for reconnect replay. An event goes
+/// once it is over either limit (and behind the checkpoint).
+#[derive(Debug, Clone, Copy)]
+pub struct LogRetention {
+    pub max_events: usize,
+    pub max_age: Duration,
+}
+
+impl Default for LogRetention {
+    fn default() -> Self {
+        LogRetention {
+            max_events: 4096,
+            max_age: Duration::from_secs(15 * 60),
         }
     }
 }
 
+/// Bounded ring of recent events. Every applied command bumps the revision
+/// by exactly one, so entries are contiguous by revision and the entry for a
+/// revision is found by subtraction. Persistent vectors: pushing to or
+/// trimming one World version leaves the others' logs untouched.
+#[derive(Clone, Default)]
+pub struct EventLog {
+    entries: Vector<(u64, Event)>,
+    /// When each entry was applied (parallel to `entries`).
+    applied_at: Vector<Instant>,
+}
+
+impl EventLog {
+    pub fn push(&mut self, revision: u64, event: Event, at: Instant) {
+        debug_assert!(self.entries.back().map_or(true, |(last, _)| *last + 1 == revision));
+        self.entries.push_back((revision, event));
+        self.applied_at.push_back(at);
+    }
+
+    pub fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.entries.is_empty()
+    }
+
+    /// Oldest revision still held.
+    pub fn first_revision(&self) -> Option<u64> {
+        self.entries.front().map(|(rev, _)| *rev)
+    }
+
+    /// The event applied at `revision`, if still held.
+    pub fn get(&self, revision: u64) -> Option<&Event> {
+        let first = self.first_revision()?;
+        let idx = revision.checked_sub(first)? as usize;
+        self.entries.get(idx).map(|(_, event)| event)
+    }
+
+    /// Every event after `since_rev`, or None if some of them were trimmed.
+    pub fn since(&self, since_rev: u64) -> Option<Vector<(u64, Event)>> {
+        let first = self.first_revision()?;
+        if since_rev + 1 < first {
+            return None;
+        }
+        Some(self.entries.skip((since_rev + 1 - first) as usize))
+    }
+
+    /// Drop the oldest entries while over `retention`, stopping at the first
+    /// entry past `checkpoint`.
+    fn trim(&mut self, retention: &LogRetention, checkpoint: u64, now: Instant) -> usize {
+        let mut dropped = 0;
+        while let (Some((rev, _)), Some(at)) = (self.entries.front(), self.applied_at.front()) {
+            let over = self.entries.len() > retention.max_events
+                || now.saturating_duration_since(*at) > retention.max_age;
+            if !over || *rev > checkpoint {
+                break;
+            }
+            self.entries.pop_front();
+            self.applied_at.pop_front();
+            dropped += 1;
+        }
+        dropped
+    }
+}
+
+impl std::ops::Index<usize> for EventLog {
+    type Output = (u64, Event);
+
+    fn index(&self, idx: usize) -> &(u64, Event) {
+        &self.entries[idx]
+    }
+}
+
 // ── Validation helpers ─────────────────────────────────────────
 
 /// Validate scheduling fields.
@@ -665,6 +890,63 @@ mod tests {
         assert_eq!(queue[2].priority, Priority::Low);
     }
 
+    #[test]
+    fn indexes_follow_every_mutation() {
+        let mut w = test_world();
+        let other = Uuid::from_bytes([2; 16]);
+        w.services.insert(other, Service { id: other, name: "Other".into() });
+
+        let a = create_task(&mut w);
+        let b = create_task(&mut w);
+        let c = w.apply(Command::CreateTask {
+            title: "Elsewhere".into(), service_id: other,
+            priority: Priority::Urgent, assigned_to: None,
+            date: Some(D2), start_time: Some(60), duration: Some(30),
+        }, Uuid::nil()).unwrap();
+        let c = match c { Event::TaskCreated { task, .. } => task.id, _ => unreachable!() };
+
+        let ids = |tasks: Vec<&Task>| tasks.iter().map(|t| t.id).collect::<Vec<_>>();
+        assert_eq!(w.tasks_in_service(Uuid::nil()).count(), 2);
+        assert_eq!(ids(w.tasks_in_service(other).collect()), vec![c]);
+        assert_eq!(w.staging_queue().len(), 2);
+
+        w.apply(Command::ScheduleTask { task_id: a, date: D, start_time: 540, duration: 60 }, Uuid::nil()).unwrap();
+        w.apply(Command::ScheduleTask { task_id: b, date: D, start_time: 480, duration: 30 }, Uuid::nil()).unwrap();
+        assert!(w.staging_queue().is_empty());
+        assert_eq!(ids(w.tasks_between(D, D2).collect()), vec![b, a, c]);
+        assert_eq!(ids(w.tasks_between(D2, D2).collect()), vec![c]);
+        // 8:00-8:30 and 9:00-10:00 on D: only `a` overlaps 9:30-11:00,
+        // and a slot ending exactly at `from` doesn't count.
+        assert_eq!(ids(w.tasks_overlapping(D, 570, 660).collect()), vec![a]);
+        assert_eq!(ids(w.tasks_overlapping(D, 510, 540).collect()), Vec::<Uuid>::new());
+
+        w.apply(Command::MoveTask { task_id: a, date: D2, start_time: 0, duration: 15 }, Uuid::nil()).unwrap();
+        assert_eq!(ids(w.tasks_between(D2, D2).collect()), vec![a, c]);
+        w.apply(Command::CompleteTask { task_id: a }, Uuid::nil()).unwrap();
+        assert_eq!(ids(w.tasks_between(D2, D2).collect()), vec![a, c]);
+        w.apply(Command::UnscheduleTask { task_id: b }, Uuid::nil()).unwrap();
+        assert_eq!(ids(w.staging_queue()), vec![b]);
+        assert_eq!(ids(w.tasks_between(D, D).collect()), Vec::<Uuid>::new());
+
+        w.apply(Command::DeleteTask { task_id: c }, Uuid::nil()).unwrap();
+        assert_eq!(w.tasks_in_service(other).count(), 0);
+        assert_eq!(ids(w.tasks_between(0, u16::MAX - 1).collect()), vec![a]);
+
+        // Replacing an entity re-indexes it.
+        let mut moved = w.tasks[&b].clone();
+        moved.service_id = other;
+        w.insert_task(moved);
+        assert_eq!(ids(w.tasks_in_service(other).collect()), vec![b]);
+        assert_eq!(w.tasks_in_service(Uuid::nil()).count(), 1);
+
+        let user = User { id: Uuid::from_bytes([3; 16]), username: "ana".into(), password_hash: String::new() };
+        w.insert_user(user.clone());
+        assert_eq!(w.get_user_by_username("ana").map(|u| u.id), Some(user.id));
+        w.insert_user(User { username: "bea".into(), ..user });
+        assert!(w.get_user_by_username("ana").is_none());
+        assert!(w.get_user_by_username("bea").is_some());
+    }
+
     #[test]
     fn scheduling_validation() {
         let mut w = test_world();
@@ -760,6 +1042,44 @@ mod tests {
         assert_eq!(events.len(), 3);
     }
 
+    #[test]
+    fn event_log_trims_behind_checkpoint() {
+        let mut w = test_world();
+        for _ in 0..10 {
+            create_task(&mut w); // revs 1..=10
+        }
+        let retention = LogRetention { max_events: 4, max_age: Duration::from_secs(60) };
+        let now = Instant::now();
+
+        // Nothing is on disk yet: over the count limit, but nothing may go.
+        assert_eq!(w.checkpoint(0, &retention, now), 0);
+        assert_eq!(w.log.len(), 10);
+
+        // Checkpoint at 3: trims revs 1..=3 only.
+        assert_eq!(w.checkpoint(3, &retention, now), 3);
+        assert_eq!(w.log.first_revision(), Some(4));
+        assert!(w.events_since(2).is_none()); // trimmed, needs a snapshot
+        assert_eq!(w.events_since(3).unwrap().len(), 7);
+        assert!(matches!(w.log.get(10), Some(Event::TaskCreated { revision: 10, .. })));
+        assert!(w.log.get(3).is_none() && w.log.get(11).is_none());
+
+        // Checkpoint covers everything: back down to the count limit.
+        assert_eq!(w.checkpoint(10, &retention, now), 3);
+        assert_eq!(w.log.first_revision(), Some(7));
+
+        // Past the age limit everything behind the checkpoint goes.
+        let later = now + Duration::from_secs(120);
+        assert_eq!(w.checkpoint(10, &retention, later), 4);
+        assert!(w.log.is_empty());
+        assert_eq!(w.events_since(10).unwrap().len(), 0);
+        assert!(w.events_since(9).is_none());
+        assert!(w.events_since(11).is_none());
+
+        // A checkpoint never moves backwards.
+        w.checkpoint(2, &retention, later);
+        assert_eq!(w.checkpoint, 10);
+    }
+
     #[test]
     fn failed_commands_dont_change_state() {
         let mut w = test_world();
@@ -95,15 +95,21 @@ const WIRE = {
     TASK_UNSCHEDULED: 0x05,
     TASK_COMPLETED:   0x06,
     TASK_DELETED:     0x07,
+    BATCH:            0x09,  // u16 count, then events back to back
+    DURABLE:          0x0A,  // u64 revision now on disk
+    HELLO:            0x0B,  // u64 server epoch, u64 hydrated revision; first frame
 
     // Client → Server command types
     CMD_CREATE_TASK:  0x10,
     CMD_MOVE_TASK:    0x12,
+    CMD_SET_INTEREST: 0x16,  // u16 count, then service ids (0 = all)
 
     // Record strides (bytes)
     TASK_STRIDE:      192,
     SERVICE_STRIDE:   80,
     SNAPSHOT_HEADER:  17,
+    EVENT_HEADER:     25,
+    BATCH_HEADER:     3,
 
     // Task record field offsets
     TASK_ID:          0,   // 16 bytes UUID
@@ -121,6 +127,26 @@ const WIRE = {
     SVC_NAME:         16,  // 64 bytes UTF-8 zero-padded
 };
 
+// Framed length of one event by message type (mirrors wire::event_frame_len).
+function eventFrameLength(type) {
+    switch (type) {
+        case WIRE.TASK_CREATED:     return 9 + WIRE.TASK_STRIDE;
+        case WIRE.TASK_SCHEDULED:
+        case WIRE.TASK_MOVED:       return WIRE.EVENT_HEADER + 6;
+        case WIRE.TASK_UNSCHEDULED:
+        case WIRE.TASK_COMPLETED:
+        case WIRE.TASK_DELETED:     return WIRE.EVENT_HEADER;
+        case WIRE.DURABLE:          return 9;
+        default:                    return 0;
+    }
+}
+
+// Hyphenated hex form of a 16-byte UUID (what the server parses in URLs).
+function uuidString(bytes) {
+    const hex = Array.from(bytes, b => b.toString(16).padStart(2, '0')).join('');
+    return `${hex.slice(0, 8)}-${hex.slice(8, 12)}-${hex.slice(12, 16)}-${hex.slice(16, 20)}-${hex.slice(20)}`;
+}
+
 // ─── Engine ─────────────────────────────────────────────────────────────────
 
 class IroncladEngine {
@@ -151,12 +177,16 @@ class IroncladEngine {
         // ── Server connection state ──
         this.ws_conn = null;
         this.revision = 0;
+        this.durableRevision = 0; // highest revision the server has on disk
+        this.epoch = null;        // server run `revision` belongs to (decimal string)
+        this.interest = null;     // service ids (16-byte arrays) we get tasks for; null = all
         this.connected = false;
         this.defaultServiceId = null; // Uint8Array(16), set from first service in snapshot
 
         // ── Spatial index: array-of-arrays, reused via length reset ──
         this.buckets = new Array(CONFIG.MAX_BUCKETS);
         for (let i = 0; i < CONFIG.MAX_BUCKETS; i++) this.buckets[i] = [];
+        this._deferIndex = false; // set while a batch frame is applied
 
         // ── Frame-stamp dedup (entities spanning multiple buckets) ──
         this.frameStamp = new Uint32Array(CONFIG.MAX_ENTITIES);
@@ -264,7 +294,7 @@ class IroncladEngine {
             console.log('[IRONCLAD] disconnected, reconnecting in 2s...');
             this.connected = false;
             this.ws_conn = null;
-            setTimeout(() => this._wsConnect(url), 2000);
+            setTimeout(() => this._wsConnect(this._resumeUrl(url)), 2000);
         };
 
         ws.onerror = () => {}; // onclose fires after onerror
@@ -272,6 +302,24 @@ class IroncladEngine {
         this.ws_conn = ws;
     }
 
+    // Ask the server to replay only what we missed (it falls back to a
+    // snapshot when its event log no longer reaches back that far, or when
+    // it is a different server run than the one our revision came from).
+    // Carries the interest set along, so the resumed stream keeps its scope.
+    _resumeUrl(url) {
+        const u = new URL(url, location.href);
+        if (this.revision > 0 && this.epoch !== null) {
+            u.searchParams.set('since', this.revision);
+            u.searchParams.set('epoch', this.epoch);
+        } else {
+            u.searchParams.delete('since');
+            u.searchParams.delete('epoch');
+        }
+        if (this.interest) u.searchParams.set('services', this.interest.map(uuidString).join(','));
+        else u.searchParams.delete('services');
+        return u.toString();
+    }
+
     _handleBinary(view, buffer) {
         if (view.byteLength < 1) return;
         const type = view.getUint8(0);
@@ -284,11 +332,22 @@ class IroncladEngine {
             case WIRE.TASK_UNSCHEDULED: this._onTaskRemoveFromGrid(view); break;
             case WIRE.TASK_COMPLETED:   this._onTaskRemoveFromGrid(view); break;
             case WIRE.TASK_DELETED:     this._onTaskDeleted(view); break;
+            case WIRE.BATCH:            this._onBatch(view, buffer); break;
+            case WIRE.DURABLE:          this.durableRevision = Number(view.getBigUint64(1, true)); break;
+            case WIRE.HELLO:            this._onHello(view); break;
             default:
                 console.warn('[IRONCLAD] unknown message type:', type);
         }
     }
 
+    // A new server run numbers revisions afresh; its snapshot follows, and
+    // durability acks from the old run say nothing about the new history.
+    _onHello(view) {
+        const epoch = view.getBigUint64(1, true).toString();
+        if (epoch !== this.epoch) this.durableRevision = 0;
+        this.epoch = epoch;
+    }
+
     // ── Snapshot: populate all SoA arrays from server state ──────────
 
     _onSnapshot(view, buffer) {
@@ -460,6 +519,29 @@ class IroncladEngine {
         this.dirty = true;
     }
 
+    // ── Batch: events coalesced by the server into one frame ────────
+
+    _onBatch(view, buffer) {
+        const count = view.getUint16(1, true);
+        let off = WIRE.BATCH_HEADER;
+
+        // Apply every event, then rebuild the bucket index once.
+        this._deferIndex = true;
+        for (let i = 0; i < count && off < buffer.byteLength; i++) {
+            const len = eventFrameLength(view.getUint8(off));
+            if (len === 0 || off + len > buffer.byteLength) {
+                console.warn('[IRONCLAD] malformed batch at event', i);
+                break;
+            }
+            const event = buffer.slice(off, off + len);
+            this._handleBinary(new DataView(event), event);
+            off += len;
+        }
+        this._deferIndex = false;
+        this._rebuildIndex();
+        this.dirty = true;
+    }
+
     // ── Send MoveTask command to server ─────────────────────────────
 
     _sendMoveTask(entityIdx) {
@@ -490,6 +572,26 @@ class IroncladEngine {
         this.ws_conn.send(buf);
     }
 
+    // ── Send interest set to server ──────────────────────────────────
+
+    // Only receive tasks and events for these services (16-byte id arrays);
+    // null or [] widens back to every service. The server answers with a
+    // snapshot at the new scope.
+    setInterest(serviceIds) {
+        this.interest = serviceIds && serviceIds.length ? serviceIds.map(id => id.slice()) : null;
+        if (!this.ws_conn || this.ws_conn.readyState !== WebSocket.OPEN) return;
+
+        const ids = this.interest || [];
+        // Pack: [type:u8][count:u16 LE][service_id:16 × count]
+        const buf = new ArrayBuffer(3 + ids.length * 16);
+        const arr = new Uint8Array(buf);
+        arr[0] = WIRE.CMD_SET_INTEREST;
+        new DataView(buf).setUint16(1, ids.length, true);
+        ids.forEach((id, i) => arr.set(id, 3 + i * 16));
+
+        this.ws_conn.send(buf);
+    }
+
     // ── Send CreateTask command to server ──────────────────────────
 
     // title/priority/serviceId are optional — used when cloning an existing task.
@@ -582,6 +684,8 @@ class IroncladEngine {
     // ── Spatial index ───────────────────────────────────────────────────
 
     _rebuildIndex() {
+        if (this._deferIndex) return; // _onBatch rebuilds once at the end
+
         for (let b = 0; b < CONFIG.MAX_BUCKETS; b++) this.buckets[b].length = 0;
 
         for (let i = 0; i < this.count; i++) {